@@ -0,0 +1,179 @@
+"""
+Mock Cboe Gap Request Proxy for local gap recovery tests.
+
+Loads the sequenced unit datagrams of a pcap file, indexes every message by
+(unit, sequence) and serves them over TCP the way the feed handler's
+gap_recovery client expects: frames are SeqUnitHeader-framed, session
+messages (GapLogin, LoginResponse, GapRequest, GapResponse) travel in
+unit 0 / sequence 0 frames, and an accepted request is answered with a
+GapResponse followed by the replayed messages in sequenced unit frames.
+Like a real proxy, --replay-to sends those frames as UDP datagrams to the
+gap response channel (set gap_recovery replay_port to match); without it
+they follow the GapResponse in-band on the TCP session.
+
+Replay a thinned copy of the capture to the feed handler (so it sees gaps)
+while this server holds the full one:
+
+    python3 mock_gap_server.py --pcap 100packet.pcap --port 18000 --replay-to 127.0.0.1:30601
+"""
+
+import argparse
+import socket
+import struct
+import time
+
+HEADER = struct.Struct('<HBBI')  # length, count, unit, sequence
+LOGIN, LOGIN_RESPONSE, GAP_REQUEST, GAP_RESPONSE = 0x01, 0x02, 0x03, 0x04
+MAX_FRAME = 1400
+
+
+def read_pcap(filename):
+    """Yield the UDP payloads of a classic pcap file (Ethernet + IPv4)."""
+    with open(filename, 'rb') as f:
+        data = f.read()
+    magic = struct.unpack('<I', data[:4])[0]
+    endian = '<' if magic in (0xa1b2c3d4, 0xa1b23c4d) else '>'
+    offset = 24
+    while offset + 16 <= len(data):
+        _, _, captured, _ = struct.unpack(endian + 'IIII', data[offset:offset + 16])
+        frame = data[offset + 16:offset + 16 + captured]
+        offset += 16 + captured
+        if len(frame) < 42 or frame[12:14] != b'\x08\x00' or frame[23] != 17:
+            continue
+        udp = 14 + (frame[14] & 0x0f) * 4
+        yield frame[udp + 8:]
+
+
+def index_messages(filename):
+    """(unit, sequence) -> message bytes, for every sequenced message in the capture."""
+    messages = {}
+    for payload in read_pcap(filename):
+        if len(payload) < HEADER.size:
+            continue
+        length, count, unit, sequence = HEADER.unpack_from(payload)
+        offset = HEADER.size
+        for i in range(count if sequence else 0):
+            size = payload[offset]
+            if size < 2 or offset + size > len(payload):
+                break
+            messages[(unit, sequence + i)] = payload[offset:offset + size]
+            offset += size
+    return messages
+
+
+def frame(unit, sequence, messages):
+    body = b''.join(messages)
+    return HEADER.pack(HEADER.size + len(body), len(messages), unit, sequence) + body
+
+
+def session_frame(message):
+    return frame(0, 0, [message])
+
+
+def replay(unit, sequence, count, messages):
+    """Sequenced unit frames for [sequence, sequence + count), packed up to MAX_FRAME bytes."""
+    frames, batch, first, size = [], [], sequence, HEADER.size
+    for s in range(sequence, sequence + count):
+        message = messages[(unit, s)]
+        if batch and (size + len(message) > MAX_FRAME or len(batch) == 255):
+            frames.append(frame(unit, first, batch))
+            batch, first, size = [], s, HEADER.size
+        batch.append(message)
+        size += len(message)
+    if batch:
+        frames.append(frame(unit, first, batch))
+    return frames
+
+
+def serve_client(conn, messages, args, replay_socket):
+    buffer = b''
+    logged_in = False
+    while True:
+        chunk = conn.recv(65536)
+        if not chunk:
+            return
+        buffer += chunk
+        while len(buffer) >= HEADER.size:
+            length, count, _, _ = HEADER.unpack_from(buffer)
+            if len(buffer) < length:
+                break
+            payload, buffer = buffer[:length], buffer[length:]
+            offset = HEADER.size
+            for _ in range(count):
+                size, kind = payload[offset], payload[offset + 1]
+                message = payload[offset:offset + size]
+                offset += size
+                if kind == LOGIN:
+                    username = message[6:10].decode().rstrip()
+                    password = message[12:22].decode().rstrip()
+                    ok = (not args.username or username == args.username) and \
+                         (not args.password or password == args.password)
+                    print(f"[MockGRP] Login from '{username}': {'accepted' if ok else 'rejected'}")
+                    conn.sendall(session_frame(struct.pack('<BBc', 3, LOGIN_RESPONSE, b'A' if ok else b'N')))
+                    logged_in = ok
+                elif kind == GAP_REQUEST and logged_in:
+                    unit, sequence, wanted = struct.unpack_from('<BIH', message, 2)
+                    if wanted > args.max_count:
+                        status = b'C'
+                    elif all((unit, s) in messages for s in range(sequence, sequence + wanted)):
+                        status = b'A'
+                    else:
+                        status = b'O'
+                    print(f"[MockGRP] GapRequest unit {unit} sequences {sequence}..{sequence + wanted - 1}:"
+                          f" {status.decode()}")
+                    response = struct.pack('<BBBIHc', 10, GAP_RESPONSE, unit, sequence, wanted, status)
+                    conn.sendall(session_frame(response))
+                    if status == b'A':
+                        time.sleep(args.delay_ms / 1000.0)
+                        for replayed in replay(unit, sequence, wanted, messages):
+                            if replay_socket:
+                                replay_socket.sendto(replayed, args.replay_to)
+                            else:
+                                conn.sendall(replayed)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Mock Cboe Gap Request Proxy')
+    parser.add_argument('--pcap', required=True, help='capture holding the messages to replay')
+    parser.add_argument('--port', type=int, default=18000)
+    parser.add_argument('--username', default='', help='accepted username (default: any)')
+    parser.add_argument('--password', default='', help='accepted password (default: any)')
+    parser.add_argument('--max-count', type=int, default=65535, help='larger requests are rejected with C')
+    parser.add_argument('--delay-ms', type=int, default=0, help='wait before replaying an accepted request')
+    parser.add_argument('--replay-to', default='', metavar='HOST:PORT',
+                        help='send replays as UDP datagrams here (gap response channel) instead of in-band')
+    parser.add_argument('--replay-interface', default='', metavar='IP',
+                        help='local interface multicast replays leave from (default: kernel choice)')
+    args = parser.parse_args()
+    replay_socket = None
+    if args.replay_to:
+        host, port = args.replay_to.rsplit(':', 1)
+        args.replay_to = (host, int(port))
+        replay_socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        replay_socket.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
+        if args.replay_interface:
+            replay_socket.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_IF, socket.inet_aton(args.replay_interface))
+
+    messages = index_messages(args.pcap)
+    units = sorted({unit for unit, _ in messages})
+    print(f"[MockGRP] Indexed {len(messages)} messages of unit(s) {units} from {args.pcap}")
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(('127.0.0.1', args.port))
+    server.listen(1)
+    print(f"[MockGRP] Listening on 127.0.0.1:{args.port}, replays "
+          f"{'to %s:%d' % args.replay_to if replay_socket else 'in-band'}")
+    while True:
+        conn, peer = server.accept()
+        print(f"[MockGRP] Session from {peer[0]}:{peer[1]}")
+        with conn:
+            try:
+                serve_client(conn, messages, args, replay_socket)
+            except (ConnectionError, OSError) as error:
+                print(f"[MockGRP] Session ended: {error}")
+        print("[MockGRP] Session closed")
+
+
+if __name__ == '__main__':
+    main()
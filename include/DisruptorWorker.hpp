@@ -77,6 +77,9 @@ private:
 
             do {
                 handler_(ring_buffer_[next_to_read]);
+                // Release the event now rather than when the producer wraps around to this slot
+                // (for shared messages this hands their packet buffer and arena back to the pools).
+                ring_buffer_[next_to_read] = Event();
             } while (next_to_read++ != available_seq);
 
             sequence_barrier_.publish(available_seq);
@@ -0,0 +1,220 @@
+/**
+ * @file    GapRecoveryClient.hpp
+ * @brief   Gap Request Proxy client that recovers missed sequenced messages.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: GapRecoveryClient.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Takes the gap events the SequenceTracker publishes and asks a Cboe Gap
+ *   Request Proxy (GRP) to replay them. The TCP session is framed with
+ *   SeqUnitHeaders and carries only GapLogin, LoginResponse, GapRequest and
+ *   GapResponse (unit 0 / sequence 0 frames). As in the Cboe GRP spec, the
+ *   messages of an accepted request are retransmitted on the unit's gap
+ *   response multicast channel: with replay_port set the client joins it
+ *   (a UdpReceiver it polls on its own thread, next to the TCP socket) and
+ *   keeps the packets that fall in its outstanding requests; the channel is
+ *   shared with other sessions, so everything else on it is ignored.
+ *   Without replay_port, sequenced frames arriving in-band on the TCP
+ *   session are taken instead (test proxies such as
+ *   example/mock_gap_server.py without --replay-to).
+ *
+ *   Replayed packets are trimmed to the requested
+ *   range, split into one-message packets (packed into PacketBufferPool
+ *   buffers) and handed, in sequence order per unit, to the same batch
+ *   callback a UdpReceiver uses. The feed handler passes them through its
+ *   ReorderBuffer: one-message packets let it drop exactly the messages a
+ *   live line delivered meanwhile and splice the rest in front of the
+ *   unit's held live packets.
+ *
+ *   Requests are batched (adjacent gaps of a unit are merged, a request
+ *   covers up to max_batch_messages, and every request due is written in
+ *   one frame) and rate limited by a token bucket of
+ *   max_requests_per_second with one second of burst. At most
+ *   max_outstanding requests are in flight; quota
+ *   rejections are retried after retry_delay_ms, other rejections and
+ *   requests not completed within request_timeout_ms are given up. The
+ *   session reconnects and logs in again after a failure, re-requesting
+ *   whatever was still outstanding.
+ *
+ *   All session state lives on the client thread; counters are readable
+ *   from any thread.
+ */
+
+#ifndef GAP_RECOVERY_CLIENT_HPP_
+#define GAP_RECOVERY_CLIENT_HPP_
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PacketBufferPool.hpp"
+#include "SequenceTracker.hpp"
+#include "UdpReceiver.hpp"
+
+/**
+ * @class GapRecoveryClient
+ * @brief Requests missed sequence ranges and injects the replayed packets.
+ */
+class GapRecoveryClient {
+public:
+    static constexpr size_t kMaxPendingRanges = 4096; ///< Oldest ranges are given up beyond this.
+
+    struct Config {
+        std::string host = "127.0.0.1";   ///< GRP IPv4 address
+        uint16_t port = 0;
+        std::string session_sub_id;        ///< Up to 4 characters
+        std::string username;              ///< Up to 4 characters
+        std::string password;              ///< Up to 10 characters
+        uint32_t max_requests_per_second = 10; ///< 0 = unlimited
+        uint32_t max_batch_messages = 1000;    ///< Largest count of one GapRequest
+        size_t max_outstanding = 4;            ///< Requests awaiting their replay
+        uint32_t request_timeout_ms = 5000;    ///< Also bounds the login exchange
+        uint32_t retry_delay_ms = 1000;        ///< After a quota rejection or a lost session
+        uint32_t connect_timeout_ms = 2000;
+        size_t batch_size = 32;                ///< Replayed packets per callback
+        int cpu_affinity_core = -1;            ///< -1 means no affinity
+        uint16_t replay_port = 0;              ///< Gap response channel port, 0 = replays in-band on TCP
+        std::string replay_bind_ip = "0.0.0.0";  ///< Unicast bind address when no group is set
+        std::string replay_multicast_group;    ///< Gap response multicast group (empty = unicast)
+        std::string replay_interface_ip;       ///< Local interface for the membership (empty = kernel choice)
+        std::string replay_source_ip;          ///< Non-empty = source-specific join
+    };
+
+    struct Stats {
+        bool logged_in = false;
+        uint64_t logins = 0;
+        uint64_t gaps = 0;                 ///< Gap events taken from the tracker
+        uint64_t requests = 0;
+        uint64_t accepted = 0;
+        uint64_t rejected = 0;             ///< Given up on rejection
+        uint64_t retried = 0;              ///< Quota rejections queued again
+        uint64_t timed_out = 0;
+        uint64_t recovered_packets = 0;    ///< Replayed packets (or parts of one) taken
+        uint64_t recovered_messages = 0;   ///< Replayed messages the callback accepted
+        uint64_t discarded_messages = 0;   ///< Replayed messages the callback dropped (delivered or skipped meanwhile)
+        uint64_t unrecovered_messages = 0; ///< Requested ranges given up
+    };
+
+    /**
+     * @param config  Session and pacing settings.
+     * @param tracker Source of gap events; must outlive the client.
+     * @param pool    Buffer pool replayed packets are copied into; must outlive the client.
+     * @throws std::invalid_argument for a missing port or a host that is not an IPv4 address.
+     * @throws std::runtime_error if the gap response channel cannot be bound or joined.
+     */
+    GapRecoveryClient(const Config &config, equix_md::SequenceTracker &tracker, equix_md::PacketBufferPool &pool);
+
+    ~GapRecoveryClient();
+
+    GapRecoveryClient(const GapRecoveryClient &) = delete;
+    GapRecoveryClient &operator=(const GapRecoveryClient &) = delete;
+
+    /**
+     * @brief Takes a batch of replayed one-message packets.
+     * @return Messages accepted; the rest count as discarded (e.g. a live line delivered them meanwhile).
+     */
+    using ReplayCallback = std::function<size_t(const UdpReceiver::Packet *packets, size_t count)>;
+
+    /**
+     * @brief Start the session thread; replayed packets are handed to callback.
+     */
+    void start(ReplayCallback callback);
+
+    void stop();
+
+    Stats stats() const;
+
+    const Config &config() const { return config_; }
+
+private:
+    /// Messages [sequence, sequence + count) of a unit.
+    struct Range {
+        uint8_t unit;
+        uint32_t sequence;
+        uint32_t count;
+    };
+
+    struct Request {
+        Range range;
+        uint32_t next;      ///< Next sequence expected from the replay
+        uint64_t sent_ns;
+        bool answered;      ///< GapResponse received
+    };
+
+    enum class Session { Disconnected, LoggingIn, Ready };
+
+    void run();
+    void take_gaps();
+    void add_range(const Range &range);   ///< New gap, merged into the unit's last queued range if adjacent
+    void requeue(const Range &range);     ///< Back into the queue, in sequence order within its unit
+    void trim_pending();
+    void give_up(const Range &range, const char *why);
+
+    bool connect_session(uint64_t now_ns);
+    void close_session(uint64_t now_ns);
+    bool flush_tx();
+    bool read_session(uint64_t now_ns);   ///< false: close the session
+    bool on_frame(const uint8_t *frame, size_t size, uint64_t now_ns);
+    bool on_control(const uint8_t *message, size_t size, uint64_t now_ns);
+    void on_replay(const uint8_t *frame, size_t size);
+    void read_replays();                  ///< Drain the gap response channel
+    void send_requests(uint64_t now_ns);
+    void expire_requests(uint64_t now_ns);
+
+    void deliver(const uint8_t *frame, size_t size, uint8_t unit, uint32_t sequence, size_t skip, size_t keep);
+    equix_md::PacketRef acquire_buffer();                 ///< Waits (flushing the batch) while the pool is empty
+    void seal(equix_md::PacketRef &buffer, size_t used);  ///< Buffer complete: its packets may be handed over
+    void flush_batch();
+
+    /// Single-writer counter: only the client thread stores, readers load relaxed.
+    static void bump(std::atomic<uint64_t> &counter, uint64_t delta = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    Config config_;
+    equix_md::SequenceTracker &tracker_;
+    equix_md::PacketBufferPool &pool_;
+    ReplayCallback callback_;
+    std::unique_ptr<UdpReceiver> replay_receiver_; ///< Gap response channel, driven by the client thread
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    // Client thread only
+    int fd_ = -1;
+    Session session_ = Session::Disconnected;
+    bool connect_failed_ = false;     ///< Logged once until a connect succeeds
+    uint64_t deadline_ns_ = 0;        ///< Reconnect time, or login deadline
+    uint64_t retry_after_ns_ = 0;     ///< No requests before this (quota backoff)
+    double tokens_ = 0;
+    uint64_t tokens_ns_ = 0;
+    std::deque<Range> pending_;
+    std::deque<Request> outstanding_;
+    std::vector<uint8_t> rx_;
+    std::vector<uint8_t> tx_;
+    std::vector<UdpReceiver::Packet> batch_;
+    size_t batch_count_ = 0;
+
+    std::atomic<bool> logged_in_{false};
+    std::atomic<uint64_t> logins_{0};
+    std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> retried_{0};
+    std::atomic<uint64_t> timed_out_{0};
+    std::atomic<uint64_t> recovered_packets_{0};
+    std::atomic<uint64_t> recovered_messages_{0};
+    std::atomic<uint64_t> discarded_messages_{0};
+    std::atomic<uint64_t> unrecovered_messages_{0};
+};
+
+#endif // GAP_RECOVERY_CLIENT_HPP_
@@ -0,0 +1,220 @@
+/**
+ * @file    IoUring.hpp
+ * @brief   Minimal io_uring wrapper over the raw system calls (no liburing dependency).
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: IoUring.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Covers exactly what the receive path needs: ring setup and mapping,
+ *   submitting SQEs, reaping CQEs in place and registering a provided-buffer
+ *   ring. Every failure is reported as a negative errno so callers can fall
+ *   back to plain sockets on kernels (or sandboxes) without io_uring.
+ */
+
+#pragma once
+
+#ifndef IO_URING_HPP_
+#define IO_URING_HPP_
+
+#ifdef __linux__
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace equix_md {
+
+/**
+ * @class IoUring
+ * @brief One io_uring instance, owned and driven by a single thread.
+ */
+class IoUring {
+public:
+    IoUring() = default;
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    ~IoUring() { close(); }
+
+    /**
+     * @brief Create the ring and map the SQ/CQ rings and the SQE array.
+     * @param sq_entries Submission queue size.
+     * @param cq_entries Completion queue size (0 = kernel default of 2 * sq_entries).
+     * @return 0 on success, negative errno on failure.
+     */
+    int init(unsigned sq_entries, unsigned cq_entries = 0) {
+        io_uring_params params{};
+        if (cq_entries > 0) {
+            params.flags |= IORING_SETUP_CQSIZE;
+            params.cq_entries = cq_entries;
+        }
+        int fd = static_cast<int>(syscall(__NR_io_uring_setup, sq_entries, &params));
+        if (fd < 0) return -errno;
+        fd_ = fd;
+
+        sq_ring_bytes_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        cq_ring_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            if (cq_ring_bytes_ > sq_ring_bytes_) sq_ring_bytes_ = cq_ring_bytes_;
+            cq_ring_bytes_ = sq_ring_bytes_;
+        }
+
+        sq_ring_ = map(sq_ring_bytes_, IORING_OFF_SQ_RING);
+        if (!sq_ring_) return fail();
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_bytes_, IORING_OFF_CQ_RING);
+        if (!cq_ring_) return fail();
+        sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe *>(map(sqes_bytes_, IORING_OFF_SQES));
+        if (!sqes_) return fail();
+
+        auto *sq = static_cast<uint8_t *>(sq_ring_);
+        sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        sq_entries_ = params.sq_entries;
+
+        auto *cq = static_cast<uint8_t *>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        sq_local_tail_ = *sq_tail_;
+        return 0;
+    }
+
+    /**
+     * @brief Next free SQE (zeroed), or nullptr if the submission queue is full.
+     */
+    io_uring_sqe *get_sqe() {
+        unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sq_local_tail_ - head >= sq_entries_) return nullptr;
+        unsigned index = sq_local_tail_ & sq_mask_;
+        io_uring_sqe *sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sq_array_[index] = index;
+        ++sq_local_tail_;
+        return sqe;
+    }
+
+    /**
+     * @brief Publish queued SQEs and enter the kernel.
+     * @param wait_nr Completions to wait for (0 = submit only).
+     * @return Number of SQEs consumed, or negative errno.
+     */
+    int submit(unsigned wait_nr = 0) {
+        unsigned to_submit = sq_local_tail_ - *sq_tail_;
+        __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+        unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+        int rc = static_cast<int>(syscall(__NR_io_uring_enter, fd_, to_submit, wait_nr, flags, nullptr, 0));
+        return rc < 0 ? -errno : rc;
+    }
+
+    /**
+     * @brief Visit ready CQEs in order without copying them, up to `max` entries, then consume them.
+     * @param visit Called as visit(const io_uring_cqe &).
+     * @return Number of CQEs consumed.
+     */
+    template<typename Visitor>
+    unsigned for_each_cqe(unsigned max, Visitor &&visit) {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        while (head != tail && count < max) {
+            visit(cqes_[head & cq_mask_]);
+            ++head;
+            ++count;
+        }
+        if (count > 0) __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    /**
+     * @brief Oldest unconsumed CQE, or nullptr if the completion queue is empty.
+     */
+    const io_uring_cqe *peek_cqe() const {
+        unsigned head = *cq_head_;
+        if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) return nullptr;
+        return &cqes_[head & cq_mask_];
+    }
+
+    /**
+     * @brief Register a provided-buffer ring (kernel 5.19+).
+     * @param ring    Page-aligned ring memory holding `entries` io_uring_buf slots.
+     * @param entries Ring size (power of two, at most 32768).
+     * @param group   Buffer group id SQEs select from.
+     * @return 0 on success, negative errno on failure.
+     */
+    int register_buffer_ring(io_uring_buf_ring *ring, unsigned entries, uint16_t group) {
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+        reg.ring_entries = entries;
+        reg.bgid = group;
+        int rc = static_cast<int>(syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PBUF_RING, &reg, 1));
+        return rc < 0 ? -errno : 0;
+    }
+
+    /**
+     * @brief Ring file descriptor (pollable: readable while CQEs are pending).
+     */
+    int fd() const { return fd_; }
+
+    void close() {
+        if (sqes_) munmap(sqes_, sqes_bytes_);
+        if (cq_ring_ && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_bytes_);
+        if (sq_ring_) munmap(sq_ring_, sq_ring_bytes_);
+        sqes_ = nullptr;
+        cq_ring_ = nullptr;
+        sq_ring_ = nullptr;
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+    }
+
+private:
+    void *map(size_t bytes, off_t offset) {
+        void *ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    int fail() {
+        int err = -errno;
+        close();
+        return err;
+    }
+
+    int fd_ = -1;
+    void *sq_ring_ = nullptr;
+    void *cq_ring_ = nullptr;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t sq_ring_bytes_ = 0;
+    size_t cq_ring_bytes_ = 0;
+    size_t sqes_bytes_ = 0;
+
+    unsigned *sq_head_ = nullptr;
+    unsigned *sq_tail_ = nullptr;
+    unsigned *sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned sq_local_tail_ = 0;
+
+    unsigned *cq_head_ = nullptr;
+    unsigned *cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+};
+
+} // namespace equix_md
+
+#endif // __linux__
+
+#endif // IO_URING_HPP_
@@ -23,6 +23,7 @@
 #include <unordered_map>
 #include <shared_mutex>
 #include <mutex>
+#include "Symbol.hpp"
 
 /**
  * @class KafkaProducer
@@ -78,6 +79,13 @@ public:
      */
     rd_kafka_topic_t* get_or_create_topic(const std::string& topic_name);
 
+    /**
+     * @brief Same as get_or_create_topic(name) for a symbol topic, keyed by the packed symbol so
+     *        the per-message lookup builds no string; text is only made when a handle is created.
+     * @note Thread-safe.
+     */
+    rd_kafka_topic_t* get_or_create_topic(equix_md::Symbol symbol);
+
     // Prevent copy/move
     KafkaProducer(const KafkaProducer&) = delete;               ///< Deleted copy constructor
     KafkaProducer& operator=(const KafkaProducer&) = delete;    ///< Deleted copy assignment
@@ -105,6 +113,7 @@ private:
 
     rd_kafka_t* producer_;                                        ///< Underlying librdkafka producer
     std::unordered_map<std::string, rd_kafka_topic_t*> topic_cache_; ///< Cache of topic handles by topic name
+    std::unordered_map<equix_md::Symbol, rd_kafka_topic_t*, equix_md::SymbolHash> symbol_topic_cache_; ///< Same handles by symbol (owned by topic_cache_)
     mutable std::shared_mutex topic_cache_mutex_;                 ///< Mutex for thread-safe topic cache access
     bool initialized_;                                            ///< Initialization status
 };
@@ -28,14 +28,14 @@
  *          Uses the KafkaProducer singleton instance. If the producer or topic handle
  *          is unavailable, logs an error. Errors during publishing (asynchronous) are logged.
  *
- * @param   symbol      The Kafka topic name.
+ * @param   symbol      Symbol naming the Kafka topic.
  * @param   partition   The Kafka partition to publish to.
  * @param   data        Pointer to message payload (typically JSON).
  * @param   len         Size in bytes of the payload.
  *
  * @note    Safe for calls from multiple threads. If publishing fails, logs error to std::cerr.
  */
-inline void KafkaPush(const std::string& symbol, int partition, const void* data, size_t len) {
+inline void KafkaPush(equix_md::Symbol symbol, int partition, const void* data, size_t len) {
     KafkaProducer& kp = KafkaProducer::instance();
     rd_kafka_t* producer = kp.get_producer();
     rd_kafka_topic_t* topic = kp.get_or_create_topic(symbol);
@@ -0,0 +1,134 @@
+/**
+ * @file    LatencyStats.hpp
+ * @brief   Lock-free per-stage latency recorder measured from the kernel receive timestamp.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: LatencyStats.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Every datagram is stamped on arrival (SO_TIMESTAMPNS, CLOCK_REALTIME) and
+ *   the stamp travels with each parsed message. A pipeline stage records
+ *   "now - receive timestamp" into a LatencyStats; the stats thread reads
+ *   count, mean, max and power-of-two histogram percentiles without locking.
+ */
+
+#pragma once
+
+#ifndef LATENCY_STATS_HPP_
+#define LATENCY_STATS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <time.h>
+
+namespace equix_md {
+
+/**
+ * @brief Current CLOCK_REALTIME in nanoseconds (same clock as SO_TIMESTAMPNS).
+ */
+inline uint64_t realtime_now_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @brief Current CLOCK_MONOTONIC in nanoseconds, for intervals a wall clock step must not disturb.
+ */
+inline uint64_t monotonic_now_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @class LatencyStats
+ * @brief Latency accumulator for one pipeline stage.
+ *
+ * record() is safe from any number of threads. Samples land in 64 buckets,
+ * bucket k holding latencies in [2^(k-1), 2^k) ns, so percentiles are upper bounds
+ * (capped at the observed max).
+ */
+class LatencyStats {
+public:
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t mean_ns = 0;
+        uint64_t max_ns = 0;
+        uint64_t p50_ns = 0; ///< Upper bound of the bucket holding the median.
+        uint64_t p99_ns = 0; ///< Upper bound of the bucket holding the 99th percentile.
+    };
+
+    explicit LatencyStats(std::string name) : name_(std::move(name)) {}
+
+    /**
+     * @brief Record the latency from a receive timestamp to now.
+     * @param rx_timestamp_ns Receive time (CLOCK_REALTIME ns); 0 is ignored.
+     * @param now_ns          Current time, if the caller already has it.
+     */
+    void record_since(uint64_t rx_timestamp_ns, uint64_t now_ns = 0) {
+        if (rx_timestamp_ns == 0) return;
+        if (now_ns == 0) now_ns = realtime_now_ns();
+        record(now_ns > rx_timestamp_ns ? now_ns - rx_timestamp_ns : 0);
+    }
+
+    /**
+     * @brief Record one latency sample in nanoseconds.
+     */
+    void record(uint64_t latency_ns) {
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+        uint64_t seen = max_ns_.load(std::memory_order_relaxed);
+        while (latency_ns > seen &&
+               !max_ns_.compare_exchange_weak(seen, latency_ns, std::memory_order_relaxed)) {
+        }
+        buckets_[bucket_of(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot s;
+        s.count = count_.load(std::memory_order_relaxed);
+        if (s.count == 0) return s;
+        s.mean_ns = sum_ns_.load(std::memory_order_relaxed) / s.count;
+        s.max_ns = max_ns_.load(std::memory_order_relaxed);
+        s.p50_ns = percentile(0.50);
+        s.p99_ns = percentile(0.99);
+        return s;
+    }
+
+    const std::string &name() const { return name_; }
+
+private:
+    static size_t bucket_of(uint64_t latency_ns) {
+        return latency_ns == 0 ? 0 : static_cast<size_t>(64 - __builtin_clzll(latency_ns)) & 63;
+    }
+
+    uint64_t percentile(double fraction) const {
+        uint64_t total = 0;
+        for (const auto &bucket: buckets_) total += bucket.load(std::memory_order_relaxed);
+        uint64_t target = static_cast<uint64_t>(static_cast<double>(total) * fraction);
+        uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+        uint64_t running = 0;
+        for (size_t k = 0; k < buckets_.size(); ++k) {
+            running += buckets_[k].load(std::memory_order_relaxed);
+            if (running > target) return k == 0 ? 0 : std::min<uint64_t>(1ull << k, max_ns);
+        }
+        return max_ns;
+    }
+
+    std::string name_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+    std::array<std::atomic<uint64_t>, 64> buckets_{};
+};
+
+} // namespace equix_md
+
+#endif // LATENCY_STATS_HPP_
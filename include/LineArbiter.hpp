@@ -0,0 +1,224 @@
+/**
+ * @file    LineArbiter.hpp
+ * @brief   Lock-free A/B feed line arbitration keyed on (unit, sequence).
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: LineArbiter.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Cboe publishes every sequenced unit on redundant lines with identical
+ *   packetization. The arbiter lets the first copy of each packet through and
+ *   discards the other, using one atomic slot per (unit, sequence mod window).
+ *   A line that fell behind can still fill a hole the other line dropped, as
+ *   long as the missing packet is within the window. Per-line counters track
+ *   win rate, duplicates and each line's own sequence gaps (loss). A gap is
+ *   blamed on the kernel when the receiving socket reported drops since the
+ *   unit's previous packet on that line, otherwise on upstream loss.
+ *
+ *   A line may be fed by several receivers at once (one socket per multicast
+ *   group of the line, or a pcap replay naming the line), so per-line state is
+ *   atomic: counters use fetch_add and the per-(line, unit) continuity is
+ *   advanced with compare-and-swap.
+ *
+ *   A unit that restarts at sequence 1 (daily or intraday reset) would
+ *   otherwise look stale forever; the first line to see the restart clears
+ *   the unit's slots and bumps the unit's reset generation, the other lines
+ *   adopt the new generation without clearing again.
+ */
+
+#pragma once
+
+#ifndef LINE_ARBITER_HPP_
+#define LINE_ARBITER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace equix_md {
+
+/**
+ * @class LineArbiter
+ * @brief First-copy-wins arbitration between redundant feed lines.
+ *
+ * on_packet() may be called concurrently from any number of receive threads, including
+ * several threads feeding the same line. Counters are readable from any thread.
+ */
+class LineArbiter {
+public:
+    static constexpr size_t kMaxUnits = 256;   ///< SeqUnitHeader unit is one byte.
+    static constexpr size_t kMaxLines = 4;
+    static constexpr uint32_t kWindow = 1024;  ///< Packets per unit a late line may still fill in (power of two).
+
+    enum class Verdict {
+        Forward,     ///< First copy of this packet: process it.
+        Duplicate,   ///< Already forwarded from another line: drop.
+        Stale,       ///< Older than the arbitration window: drop.
+        Unsequenced  ///< Sequence 0 / no messages (heartbeat): not arbitrated.
+    };
+
+    /**
+     * @brief Per-line counters (snapshot).
+     */
+    struct LineStats {
+        uint64_t packets = 0;        ///< Sequenced packets seen on the line.
+        uint64_t wins = 0;           ///< Packets this line delivered first.
+        uint64_t duplicates = 0;     ///< Packets already delivered by another line.
+        uint64_t stale = 0;          ///< Packets too old to arbitrate.
+        uint64_t gaps = 0;           ///< Sequence gaps observed on this line alone.
+        uint64_t kernel_gaps = 0;    ///< Gaps that coincided with kernel drops on the line's socket.
+        uint64_t upstream_gaps = 0;  ///< Gaps with no local drop: lost before reaching this host.
+        uint64_t lost_messages = 0;  ///< Messages missing from this line's own stream.
+    };
+
+    /**
+     * @param line_count Number of redundant lines (1..kMaxLines).
+     */
+    explicit LineArbiter(size_t line_count)
+        : line_count_(line_count),
+          slots_(new std::atomic<uint32_t>[kMaxUnits * kWindow]) {
+        if (line_count == 0 || line_count > kMaxLines)
+            throw std::invalid_argument("LineArbiter: line_count must be 1.." + std::to_string(kMaxLines));
+        for (size_t i = 0; i < kMaxUnits * kWindow; ++i) slots_[i].store(0, std::memory_order_relaxed);
+        for (auto &generation: generations_) generation.store(0, std::memory_order_relaxed);
+        for (auto &line: lines_) {
+            for (auto &next: line.next_sequence) next.store(0, std::memory_order_relaxed);
+            for (auto &generation: line.generation) generation.store(0, std::memory_order_relaxed);
+            for (auto &seen: line.kernel_drops_seen) seen.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    LineArbiter(const LineArbiter &) = delete;
+    LineArbiter &operator=(const LineArbiter &) = delete;
+
+    /**
+     * @brief Arbitrate one packet.
+     * @param line      Line index the packet arrived on (< line_count).
+     * @param unit      SeqUnitHeader unit.
+     * @param sequence  SeqUnitHeader sequence (first message in the packet).
+     * @param count     SeqUnitHeader message count.
+     * @param kernel_drops Datagrams the feeding socket dropped just before this packet (UdpReceiver::Packet).
+     */
+    Verdict on_packet(size_t line, uint8_t unit, uint32_t sequence, uint8_t count, uint32_t kernel_drops = 0) {
+        LineState &state = lines_[line];
+        if (kernel_drops != 0) bump(state.kernel_drops, kernel_drops);
+        if (sequence == 0 || count == 0) return Verdict::Unsequenced;
+
+        bump(state.packets);
+        if (sequence == 1 && sequence + count < state.next_sequence[unit].load(std::memory_order_acquire))
+            on_reset(state, unit);
+        track_line_sequence(state, unit, sequence, count);
+
+        std::atomic<uint32_t> &slot = slots_[static_cast<size_t>(unit) * kWindow + (sequence & (kWindow - 1))];
+        uint32_t seen = slot.load(std::memory_order_acquire);
+        while (seen < sequence) {
+            if (slot.compare_exchange_weak(seen, sequence, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                bump(state.wins);
+                return Verdict::Forward;
+            }
+        }
+        if (seen == sequence) {
+            bump(state.duplicates);
+            return Verdict::Duplicate;
+        }
+        bump(state.stale);
+        return Verdict::Stale;
+    }
+
+    /**
+     * @brief Snapshot of one line's counters.
+     */
+    LineStats line_stats(size_t line) const {
+        const LineState &state = lines_[line];
+        LineStats stats;
+        stats.packets = state.packets.load(std::memory_order_relaxed);
+        stats.wins = state.wins.load(std::memory_order_relaxed);
+        stats.duplicates = state.duplicates.load(std::memory_order_relaxed);
+        stats.stale = state.stale.load(std::memory_order_relaxed);
+        stats.gaps = state.gaps.load(std::memory_order_relaxed);
+        stats.kernel_gaps = state.kernel_gaps.load(std::memory_order_relaxed);
+        stats.upstream_gaps = state.upstream_gaps.load(std::memory_order_relaxed);
+        stats.lost_messages = state.lost_messages.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    size_t line_count() const { return line_count_; }
+
+private:
+    struct alignas(64) LineState {
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> wins{0};
+        std::atomic<uint64_t> duplicates{0};
+        std::atomic<uint64_t> stale{0};
+        std::atomic<uint64_t> gaps{0};
+        std::atomic<uint64_t> kernel_gaps{0};
+        std::atomic<uint64_t> upstream_gaps{0};
+        std::atomic<uint64_t> lost_messages{0};
+        std::atomic<uint64_t> kernel_drops{0}; ///< Drops reported so far by every socket feeding the line.
+        std::array<std::atomic<uint32_t>, kMaxUnits> next_sequence; ///< Highest sequence + count seen per unit.
+        std::array<std::atomic<uint32_t>, kMaxUnits> generation;    ///< Unit reset generation this line has adopted.
+        std::array<std::atomic<uint64_t>, kMaxUnits> kernel_drops_seen; ///< kernel_drops at the unit's previous packet.
+    };
+
+    /// Several receivers may feed one line, so every counter update is an atomic add.
+    static void bump(std::atomic<uint64_t> &counter, uint64_t delta = 1) {
+        counter.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The unit restarted at sequence 1 on this line: forget the previous run.
+     *
+     * Only the first line to report the restart clears the slots; a line still on an older
+     * generation adopts the current one, so a lagging line does not wipe packets the leading
+     * line already forwarded in the new run.
+     */
+    void on_reset(LineState &state, uint8_t unit) {
+        uint32_t generation = state.generation[unit].load(std::memory_order_acquire);
+        if (generations_[unit].compare_exchange_strong(generation, generation + 1, std::memory_order_acq_rel)) {
+            std::atomic<uint32_t> *slots = &slots_[static_cast<size_t>(unit) * kWindow];
+            for (uint32_t i = 0; i < kWindow; ++i) slots[i].store(0, std::memory_order_release);
+            ++generation;
+        }
+        state.generation[unit].store(generation, std::memory_order_release);
+        state.next_sequence[unit].store(0, std::memory_order_release); // No gap is counted across the restart
+    }
+
+    /**
+     * @brief Record this line's own continuity for the unit (loss is per line, before arbitration).
+     *
+     * The socket carries every unit, so drops since the unit's previous packet may have hit another
+     * unit; a kernel-attributed gap means "the kernel dropped something meanwhile", not an exact match.
+     * Only the feeder whose CAS advances the unit's next sequence past a hole counts it, so two
+     * receivers carrying the same unit on one line never count the same gap twice.
+     */
+    static void track_line_sequence(LineState &state, uint8_t unit, uint32_t sequence, uint8_t count) {
+        uint64_t drops = state.kernel_drops.load(std::memory_order_relaxed);
+        uint64_t drops_seen = state.kernel_drops_seen[unit].exchange(drops, std::memory_order_relaxed);
+        std::atomic<uint32_t> &next = state.next_sequence[unit];
+        uint32_t expected = next.load(std::memory_order_acquire);
+        do {
+            if (sequence + count <= expected) return; // Behind this line's own progress: nothing to advance
+        } while (!next.compare_exchange_weak(expected, sequence + count, std::memory_order_acq_rel,
+                                             std::memory_order_acquire));
+        if (expected != 0 && sequence > expected) {
+            bump(state.gaps);
+            bump(drops != drops_seen ? state.kernel_gaps : state.upstream_gaps);
+            bump(state.lost_messages, sequence - expected);
+        }
+    }
+
+    size_t line_count_;
+    std::unique_ptr<std::atomic<uint32_t>[]> slots_; ///< Last forwarded sequence per (unit, sequence % kWindow).
+    std::array<std::atomic<uint32_t>, kMaxUnits> generations_; ///< Restarts seen per unit.
+    std::array<LineState, kMaxLines> lines_;
+};
+
+} // namespace equix_md
+
+#endif // LINE_ARBITER_HPP_
@@ -0,0 +1,106 @@
+/**
+ * @file    NetHeaders.hpp
+ * @brief   Minimal Ethernet / IPv4 / UDP frame decoding.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: NetHeaders.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Locates the UDP payload inside a raw link-layer frame, as delivered by an
+ *   AF_PACKET ring or stored in a capture file. Only what the feed needs is
+ *   handled: Ethernet II with an optional 802.1Q tag, unfragmented IPv4 and
+ *   UDP. Anything else is rejected so callers can simply skip the frame.
+ */
+
+#pragma once
+
+#ifndef NET_HEADERS_HPP_
+#define NET_HEADERS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace equix_md {
+
+/**
+ * @struct UdpDatagramView
+ * @brief Non-owning view of one UDP datagram inside a frame.
+ */
+struct UdpDatagramView {
+    const uint8_t *payload = nullptr;
+    size_t payload_size = 0;
+    uint32_t src_ip = 0;   ///< Network byte order.
+    uint32_t dst_ip = 0;   ///< Network byte order.
+    uint16_t src_port = 0; ///< Host byte order.
+    uint16_t dst_port = 0; ///< Host byte order.
+};
+
+namespace net {
+
+constexpr size_t kEthernetHeaderSize = 14;
+constexpr size_t kVlanTagSize = 4;
+constexpr uint16_t kEtherTypeIPv4 = 0x0800;
+constexpr uint16_t kEtherTypeVlan = 0x8100;
+constexpr uint8_t kIpProtoUdp = 17;
+constexpr size_t kUdpHeaderSize = 8;
+
+inline uint16_t load_be16(const uint8_t *p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+/// Four bytes as stored (keeps network byte order, like in_addr::s_addr).
+inline uint32_t load_raw32(const uint8_t *p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Decode an IPv4 packet carrying UDP.
+ * @return false for non-UDP, fragmented or malformed packets.
+ */
+inline bool parse_ipv4_udp(const uint8_t *packet, size_t length, UdpDatagramView &out) {
+    if (length < 20 || (packet[0] >> 4) != 4) return false;
+    size_t ip_header_size = static_cast<size_t>(packet[0] & 0x0F) * 4;
+    size_t ip_total = load_be16(packet + 2);
+    if (ip_header_size < 20 || ip_total < ip_header_size + kUdpHeaderSize || ip_total > length) return false;
+    if (packet[9] != kIpProtoUdp) return false;
+    if (load_be16(packet + 6) & 0x3FFF) return false; // More-fragments flag or non-zero offset
+
+    const uint8_t *udp = packet + ip_header_size;
+    size_t udp_length = load_be16(udp + 4);
+    if (udp_length < kUdpHeaderSize || udp_length > ip_total - ip_header_size) return false;
+
+    out.src_ip = load_raw32(packet + 12);
+    out.dst_ip = load_raw32(packet + 16);
+    out.src_port = load_be16(udp);
+    out.dst_port = load_be16(udp + 2);
+    out.payload = udp + kUdpHeaderSize;
+    out.payload_size = udp_length - kUdpHeaderSize;
+    return true;
+}
+
+/**
+ * @brief Decode an Ethernet II frame (optionally VLAN tagged) carrying IPv4/UDP.
+ * @return false if the frame is not a complete, unfragmented IPv4 UDP datagram.
+ */
+inline bool parse_ethernet_udp(const uint8_t *frame, size_t length, UdpDatagramView &out) {
+    if (length < kEthernetHeaderSize) return false;
+    size_t offset = kEthernetHeaderSize;
+    uint16_t ether_type = load_be16(frame + 12);
+    if (ether_type == kEtherTypeVlan) {
+        if (length < kEthernetHeaderSize + kVlanTagSize) return false;
+        ether_type = load_be16(frame + 16);
+        offset += kVlanTagSize;
+    }
+    if (ether_type != kEtherTypeIPv4) return false;
+    return parse_ipv4_udp(frame + offset, length - offset, out);
+}
+
+} // namespace net
+} // namespace equix_md
+
+#endif // NET_HEADERS_HPP_
@@ -0,0 +1,198 @@
+/**
+ * @file    PacketBufferPool.hpp
+ * @brief   Fixed-size, reference-counted packet buffers recycled through a lock-free pool.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: PacketBufferPool.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   All packet buffers are allocated once, up front. The receive thread reads
+ *   datagrams straight into pool buffers, parsed messages keep a PacketRef to
+ *   the buffer their payload lives in, and the buffer returns to the pool when
+ *   the last reference is dropped. Acquire and release are lock-free and never
+ *   touch the heap.
+ */
+
+#pragma once
+
+#ifndef PACKET_BUFFER_POOL_HPP_
+#define PACKET_BUFFER_POOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace equix_md {
+
+class PacketBufferPool;
+
+/**
+ * @struct PacketBuffer
+ * @brief One pooled datagram buffer with an intrusive reference count.
+ */
+struct PacketBuffer {
+    static constexpr size_t kCapacity = 2048; ///< Max datagram size held by one buffer.
+
+    alignas(64) uint8_t data[kCapacity];      ///< Datagram bytes.
+    size_t size = 0;                          ///< Valid bytes in data.
+    uint64_t rx_timestamp_ns = 0;             ///< Receive time (CLOCK_REALTIME ns), 0 if unknown.
+    std::atomic<uint32_t> ref_count{0};       ///< Live PacketRef handles.
+    PacketBufferPool *pool = nullptr;         ///< Owning pool.
+    uint32_t index = 0;                       ///< Slot index within the owning pool.
+};
+
+/**
+ * @class PacketRef
+ * @brief Intrusive shared handle to a PacketBuffer.
+ *
+ * Copying bumps the buffer's reference count; the buffer goes back to its
+ * pool when the last handle is destroyed or reset.
+ */
+class PacketRef {
+public:
+    PacketRef() = default;
+
+    PacketRef(const PacketRef &other) noexcept : buffer_(other.buffer_) {
+        if (buffer_) buffer_->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PacketRef(PacketRef &&other) noexcept : buffer_(other.buffer_) {
+        other.buffer_ = nullptr;
+    }
+
+    PacketRef &operator=(PacketRef other) noexcept {
+        std::swap(buffer_, other.buffer_);
+        return *this;
+    }
+
+    ~PacketRef() { reset(); }
+
+    /**
+     * @brief Drop this handle's reference, recycling the buffer if it was the last one.
+     */
+    inline void reset() noexcept;
+
+    PacketBuffer *get() const noexcept { return buffer_; }
+    PacketBuffer *operator->() const noexcept { return buffer_; }
+    explicit operator bool() const noexcept { return buffer_ != nullptr; }
+
+    const uint8_t *data() const noexcept { return buffer_ ? buffer_->data : nullptr; }
+    size_t size() const noexcept { return buffer_ ? buffer_->size : 0; }
+
+private:
+    friend class PacketBufferPool;
+
+    /// Adopts a buffer whose reference count has already been set to 1.
+    explicit PacketRef(PacketBuffer *buffer) noexcept : buffer_(buffer) {}
+
+    PacketBuffer *buffer_ = nullptr;
+};
+
+/**
+ * @class PacketBufferPool
+ * @brief Preallocated pool of PacketBuffer slots with a lock-free free list.
+ *
+ * Any thread may acquire or release. The free list is a Treiber stack whose
+ * head packs a 32-bit ABA tag with the 32-bit slot index.
+ * The pool must outlive every PacketRef handed out from it.
+ */
+class PacketBufferPool {
+public:
+    /**
+     * @brief Allocate all buffers up front.
+     * @param buffer_count Number of buffers in the pool.
+     */
+    explicit PacketBufferPool(size_t buffer_count)
+        : buffer_count_(static_cast<uint32_t>(buffer_count)),
+          buffers_(new PacketBuffer[buffer_count]),
+          next_free_(new std::atomic<uint32_t>[buffer_count]) {
+        for (uint32_t i = 0; i < buffer_count_; ++i) {
+            buffers_[i].pool = this;
+            buffers_[i].index = i;
+            next_free_[i].store(i + 1 < buffer_count_ ? i + 1 : kNil, std::memory_order_relaxed);
+        }
+        free_head_.store(pack(0, buffer_count_ ? 0 : kNil), std::memory_order_relaxed);
+        available_.store(buffer_count_, std::memory_order_relaxed);
+    }
+
+    PacketBufferPool(const PacketBufferPool &) = delete;
+    PacketBufferPool &operator=(const PacketBufferPool &) = delete;
+
+    /**
+     * @brief Take a buffer from the pool.
+     * @return Handle owning the buffer (size and timestamp reset to 0), or an empty handle if the pool is exhausted.
+     */
+    PacketRef acquire() noexcept {
+        uint64_t head = free_head_.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t index = index_of(head);
+            if (index == kNil) return PacketRef();
+            uint32_t next = next_free_[index].load(std::memory_order_relaxed);
+            if (free_head_.compare_exchange_weak(head, pack(tag_of(head) + 1, next),
+                                                 std::memory_order_acquire, std::memory_order_acquire)) {
+                available_.fetch_sub(1, std::memory_order_relaxed);
+                PacketBuffer &buffer = buffers_[index];
+                buffer.size = 0;
+                buffer.rx_timestamp_ns = 0;
+                buffer.ref_count.store(1, std::memory_order_relaxed);
+                return PacketRef(&buffer);
+            }
+        }
+    }
+
+    /**
+     * @brief Number of buffers currently free (approximate under concurrency).
+     */
+    size_t available() const noexcept { return available_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Total number of buffers owned by the pool.
+     */
+    size_t capacity() const noexcept { return buffer_count_; }
+
+private:
+    friend class PacketRef;
+
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+
+    static uint64_t pack(uint32_t tag, uint32_t index) { return (static_cast<uint64_t>(tag) << 32) | index; }
+    static uint32_t tag_of(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+    static uint32_t index_of(uint64_t head) { return static_cast<uint32_t>(head); }
+
+    /**
+     * @brief Push a buffer whose reference count reached zero back onto the free list.
+     */
+    void release(PacketBuffer *buffer) noexcept {
+        uint64_t head = free_head_.load(std::memory_order_relaxed);
+        for (;;) {
+            next_free_[buffer->index].store(index_of(head), std::memory_order_relaxed);
+            if (free_head_.compare_exchange_weak(head, pack(tag_of(head) + 1, buffer->index),
+                                                 std::memory_order_release, std::memory_order_relaxed)) {
+                available_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    uint32_t buffer_count_;
+    std::unique_ptr<PacketBuffer[]> buffers_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_free_;
+    alignas(64) std::atomic<uint64_t> free_head_{0};
+    alignas(64) std::atomic<size_t> available_{0};
+};
+
+inline void PacketRef::reset() noexcept {
+    if (!buffer_) return;
+    if (buffer_->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        buffer_->pool->release(buffer_);
+    }
+    buffer_ = nullptr;
+}
+
+} // namespace equix_md
+
+#endif // PACKET_BUFFER_POOL_HPP_
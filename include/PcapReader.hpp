@@ -0,0 +1,131 @@
+/**
+ * @file    PcapReader.hpp
+ * @brief   Memory-mapped pcap / pcapng capture reader.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: PcapReader.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Maps a capture file read-only and walks its records in place, without
+ *   libpcap. Classic pcap (micro- or nanosecond, either byte order) and
+ *   pcapng (SHB/IDB/EPB/SPB, per-interface link type and timestamp
+ *   resolution) are supported. Frames can be decoded to their UDP payload for
+ *   Ethernet, Linux cooked (SLL / SLL2), raw IPv4 and BSD loopback captures.
+ */
+
+#ifndef PCAP_READER_HPP_
+#define PCAP_READER_HPP_
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NetHeaders.hpp"
+
+namespace equix_md {
+
+/**
+ * @struct PcapFrame
+ * @brief One captured frame; data points into the mapped file.
+ */
+struct PcapFrame {
+    uint64_t timestamp_ns = 0;     ///< Capture time (ns since the epoch), 0 if the record carries none.
+    const uint8_t *data = nullptr;
+    uint32_t captured_length = 0;  ///< Bytes present in the file.
+    uint32_t original_length = 0;  ///< Bytes on the wire.
+    uint16_t link_type = 0;        ///< LINKTYPE_* of the capturing interface.
+};
+
+/**
+ * @class PcapReader
+ * @brief Sequential reader over a memory-mapped pcap or pcapng file.
+ *
+ * Frames stay valid for the lifetime of the reader.
+ */
+class PcapReader {
+public:
+    static constexpr uint16_t kLinkTypeNull = 0;       ///< BSD loopback (4-byte address family).
+    static constexpr uint16_t kLinkTypeEthernet = 1;
+    static constexpr uint16_t kLinkTypeRaw = 101;      ///< Raw IP (also 12 on some platforms).
+    static constexpr uint16_t kLinkTypeLinuxSll = 113; ///< Linux cooked capture v1.
+    static constexpr uint16_t kLinkTypeIPv4 = 228;
+    static constexpr uint16_t kLinkTypeLinuxSll2 = 276; ///< Linux cooked capture v2.
+
+    /**
+     * @brief Map the capture and parse its file header.
+     * @throws std::runtime_error if the file cannot be opened or is not pcap/pcapng.
+     */
+    explicit PcapReader(const std::string &path);
+
+    ~PcapReader();
+
+    PcapReader(const PcapReader &) = delete;
+    PcapReader &operator=(const PcapReader &) = delete;
+
+    /**
+     * @brief Advance to the next packet record.
+     * @return false at the end of the file (or at a truncated/corrupt record, which is logged).
+     */
+    bool next(PcapFrame &frame);
+
+    /**
+     * @brief Advance to the next frame that carries an IPv4 UDP datagram, skipping everything else.
+     * @return false at the end of the file.
+     */
+    bool next_udp(UdpDatagramView &datagram, uint64_t &timestamp_ns);
+
+    /**
+     * @brief Restart from the first record.
+     */
+    void rewind();
+
+    /**
+     * @brief Locate the UDP datagram inside a frame according to its link type.
+     */
+    static bool decode_udp(const PcapFrame &frame, UdpDatagramView &datagram);
+
+    bool is_pcapng() const { return pcapng_; }
+
+    const std::string &path() const { return path_; }
+
+    /// Frames next_udp() passed over because they were not IPv4/UDP.
+    uint64_t skipped_frames() const { return skipped_frames_; }
+
+private:
+    struct Interface {
+        uint16_t link_type = kLinkTypeEthernet;
+        bool ts_power_of_two = false; ///< if_tsresol base: 2^-n instead of 10^-n
+        uint8_t ts_exponent = 6;      ///< Default resolution: microseconds
+    };
+
+    bool next_pcap(PcapFrame &frame);
+
+    bool next_pcapng(PcapFrame &frame);
+
+    void parse_interface_description(const uint8_t *body, uint32_t body_length);
+
+    uint64_t pcapng_timestamp_ns(uint32_t interface_id, uint64_t ticks) const;
+
+    uint16_t read16(const uint8_t *p) const;
+
+    uint32_t read32(const uint8_t *p) const;
+
+    std::string path_;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+    size_t first_record_ = 0;
+    bool pcapng_ = false;
+    bool swapped_ = false;          ///< File byte order differs from the host's
+    bool nanosecond_ = false;       ///< Classic pcap with nanosecond timestamps
+    uint16_t link_type_ = kLinkTypeEthernet; ///< Classic pcap link type
+    std::vector<Interface> interfaces_; ///< pcapng interfaces of the current section
+    uint64_t skipped_frames_ = 0;
+};
+
+} // namespace equix_md
+
+#endif // PCAP_READER_HPP_
@@ -0,0 +1,116 @@
+/**
+ * @file    PcapSource.hpp
+ * @brief   Capture-file packet source that feeds the receive callback directly.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: PcapSource.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Replays the UDP datagrams of a pcap/pcapng file into the same batch
+ *   callback a UdpReceiver uses, bypassing the network entirely. Datagrams
+ *   are copied into PacketBufferPool buffers (stamped with the injection
+ *   time) so downstream code cannot tell them from received ones. Replay
+ *   runs as fast as possible, to measure the pipeline's throughput ceiling,
+ *   or paced by the capture timestamps with a speed multiplier.
+ */
+
+#ifndef PCAP_SOURCE_HPP_
+#define PCAP_SOURCE_HPP_
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PacketBufferPool.hpp"
+#include "UdpReceiver.hpp"
+
+namespace equix_md { class PcapReader; }
+
+/**
+ * @class PcapSource
+ * @brief Injects the UDP payloads of a capture file as if a receiver had read them.
+ */
+class PcapSource {
+public:
+    enum class Pacing {
+        Fast,     ///< Back to back, only held back by an empty buffer pool.
+        Original  ///< Capture inter-packet gaps, divided by Config::speed.
+    };
+
+    struct Config {
+        std::string file;
+        Pacing pacing = Pacing::Fast;
+        double speed = 1.0; ///< Original pacing: 2.0 replays twice as fast
+        uint32_t loops = 1; ///< Passes over the file (0 = until stopped)
+        std::vector<uint16_t> ports; ///< UDP destination ports to replay (empty = all)
+        size_t batch_size = 32; ///< Datagrams per callback
+        int cpu_affinity_core = -1; ///< -1 means no affinity
+    };
+
+    struct Stats {
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t filtered = 0;  ///< UDP datagrams skipped by the port filter
+        uint64_t loops = 0;     ///< Completed passes over the file
+        uint64_t elapsed_ns = 0; ///< Replay wall time so far
+        bool finished = false;
+    };
+
+    /**
+     * @param config Replay settings.
+     * @param pool   Buffer pool datagrams are copied into; must outlive the source.
+     */
+    PcapSource(const Config &config, equix_md::PacketBufferPool &pool);
+
+    ~PcapSource();
+
+    PcapSource(const PcapSource &) = delete;
+    PcapSource &operator=(const PcapSource &) = delete;
+
+    /**
+     * @brief Start replaying on a background thread.
+     * @throws std::runtime_error if the capture cannot be opened.
+     */
+    void start(UdpReceiver::BatchPacketCallback callback);
+
+    void stop();
+
+    Stats stats() const;
+
+    const Config &config() const { return config_; }
+
+    /**
+     * @brief Parse a pacing name ("fast", "original").
+     */
+    static std::optional<Pacing> pacing_from_string(const std::string &name);
+
+    static const char *pacing_name(Pacing pacing);
+
+private:
+    void run_reader(equix_md::PcapReader &reader, const UdpReceiver::BatchPacketCallback &callback);
+
+    /// Single-writer counter: only the replay thread stores, readers load relaxed.
+    static void bump(std::atomic<uint64_t> &counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    Config config_;
+    equix_md::PacketBufferPool &pool_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> finished_{false};
+    std::thread thread_;
+
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> filtered_{0};
+    std::atomic<uint64_t> loops_{0};
+    std::atomic<uint64_t> started_ns_{0};
+    std::atomic<uint64_t> finished_ns_{0};
+};
+
+#endif // PCAP_SOURCE_HPP_
@@ -0,0 +1,76 @@
+/**
+ * @file    PcapWriter.hpp
+ * @brief   Classic pcap writer for synthetic UDP datagrams.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: PcapWriter.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Writes UDP payloads as Ethernet / IPv4 / UDP frames to a nanosecond
+ *   classic pcap file, so generated feeds can be replayed with cboe_replay,
+ *   the pcap_source section or any standard tool. Checksums: the IPv4 header
+ *   checksum is filled in, the optional UDP checksum is left at zero.
+ */
+
+#ifndef PCAP_WRITER_HPP_
+#define PCAP_WRITER_HPP_
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace equix_md {
+
+/**
+ * @class PcapWriter
+ * @brief Appends one frame per UDP datagram to a capture file.
+ */
+class PcapWriter {
+public:
+    struct Endpoint {
+        uint32_t ip = 0;   ///< Network byte order.
+        uint16_t port = 0; ///< Host byte order.
+    };
+
+    /**
+     * @throws std::runtime_error if the file cannot be created.
+     */
+    explicit PcapWriter(const std::string &path);
+
+    ~PcapWriter();
+
+    PcapWriter(const PcapWriter &) = delete;
+    PcapWriter &operator=(const PcapWriter &) = delete;
+
+    /**
+     * @brief Write payload as a UDP datagram from source to destination, stamped timestamp_ns.
+     * @throws std::runtime_error on a write error or a payload that does not fit one IPv4 packet.
+     */
+    void write_udp(const uint8_t *payload, size_t size, uint64_t timestamp_ns, const Endpoint &source,
+                   const Endpoint &destination);
+
+    /**
+     * @brief Flush and close; further writes throw. Called by the destructor.
+     */
+    void close();
+
+    uint64_t packets() const { return packets_; }
+    uint64_t bytes() const { return bytes_; } ///< Frame bytes written, headers included
+
+private:
+    void write(const void *data, size_t size);
+
+    std::string path_;
+    std::FILE *file_ = nullptr;
+    uint16_t ip_id_ = 0;
+    uint64_t packets_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+} // namespace equix_md
+
+#endif // PCAP_WRITER_HPP_
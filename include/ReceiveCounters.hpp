@@ -0,0 +1,121 @@
+/**
+ * @file    ReceiveCounters.hpp
+ * @brief   Single-writer receive-path counter block.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: ReceiveCounters.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   One cache-line aligned block per receive socket, written only by the
+ *   thread that reads the socket (plain relaxed load + store, no locked
+ *   instructions) and read by the stats thread at any time. Covers
+ *   throughput, batch-size distribution, kernel drops (SO_RXQ_OVFL or the
+ *   packet ring's drop statistics), reads skipped because the packet pool
+ *   was empty, and the longest stretch the socket was left unread while
+ *   data could still be pending.
+ */
+
+#pragma once
+
+#ifndef RECEIVE_COUNTERS_HPP_
+#define RECEIVE_COUNTERS_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace equix_md {
+
+/**
+ * @class ReceiveCounters
+ * @brief Counters for one receive socket; one writer thread, any number of readers.
+ */
+class alignas(64) ReceiveCounters {
+public:
+    /// Batch-size buckets: [1], [2,3], [4,7], ... [64,127], [128+].
+    static constexpr size_t kBatchBuckets = 8;
+
+    struct Snapshot {
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t batches = 0;
+        uint64_t idle_waits = 0;      ///< Empty polls (spin/busy-poll) or epoll_wait calls
+        uint64_t kernel_drops = 0;    ///< Datagrams the kernel dropped before they could be queued/read
+        uint64_t pool_stalls = 0;     ///< Reads skipped because the packet pool had no free buffer
+        uint64_t max_read_gap_ns = 0; ///< Longest time between a read that returned data and the next read
+        std::array<uint64_t, kBatchBuckets> batch_sizes{}; ///< Batches per size bucket
+    };
+
+    /**
+     * @brief Bucket index for a batch of `count` datagrams.
+     */
+    static size_t batch_bucket(size_t count) {
+        size_t bucket = 0;
+        while (count > 1 && bucket + 1 < kBatchBuckets) {
+            count >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    /**
+     * @brief Smallest batch size that falls in a bucket.
+     */
+    static size_t batch_bucket_floor(size_t bucket) { return size_t{1} << bucket; }
+
+    void on_batch(size_t count, uint64_t bytes) {
+        bump(packets_, count);
+        bump(bytes_, bytes);
+        bump(batches_, 1);
+        bump(batch_sizes_[batch_bucket(count)], 1);
+    }
+
+    void on_idle() { bump(idle_waits_, 1); }
+
+    void on_pool_stall() { bump(pool_stalls_, 1); }
+
+    void on_kernel_drops(uint64_t dropped) {
+        if (dropped != 0) bump(kernel_drops_, dropped);
+    }
+
+    void on_read_gap(uint64_t gap_ns) {
+        if (gap_ns > max_read_gap_ns_.load(std::memory_order_relaxed))
+            max_read_gap_ns_.store(gap_ns, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot snapshot;
+        snapshot.packets = packets_.load(std::memory_order_relaxed);
+        snapshot.bytes = bytes_.load(std::memory_order_relaxed);
+        snapshot.batches = batches_.load(std::memory_order_relaxed);
+        snapshot.idle_waits = idle_waits_.load(std::memory_order_relaxed);
+        snapshot.kernel_drops = kernel_drops_.load(std::memory_order_relaxed);
+        snapshot.pool_stalls = pool_stalls_.load(std::memory_order_relaxed);
+        snapshot.max_read_gap_ns = max_read_gap_ns_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kBatchBuckets; ++i)
+            snapshot.batch_sizes[i] = batch_sizes_[i].load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+private:
+    /// Single-writer counter: only the receive thread stores, readers load relaxed.
+    static void bump(std::atomic<uint64_t> &counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> idle_waits_{0};
+    std::atomic<uint64_t> kernel_drops_{0};
+    std::atomic<uint64_t> pool_stalls_{0};
+    std::atomic<uint64_t> max_read_gap_ns_{0};
+    std::array<std::atomic<uint64_t>, kBatchBuckets> batch_sizes_{};
+};
+
+} // namespace equix_md
+
+#endif // RECEIVE_COUNTERS_HPP_
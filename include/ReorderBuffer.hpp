@@ -0,0 +1,350 @@
+/**
+ * @file    ReorderBuffer.hpp
+ * @brief   Bounded per-unit reorder window in front of the parser.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: ReorderBuffer.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   With two lines and kernel batching, a unit's packets can arrive out of
+ *   order. The reorder buffer keeps each unit's next expected sequence;
+ *   packets that continue the unit are released at once, packets that
+ *   arrive early are held until the hole before them fills, then released
+ *   in sequence. Holding is bounded by count (a packet must start within
+ *   `window` messages of the expected sequence, otherwise everything held
+ *   is released) and by time (a hole open for max_hold_us is skipped).
+ *   Skipped holes reach the SequenceTracker behind the buffer as gaps, so
+ *   they are logged or recovered like any other loss. A packet that shows
+ *   up after its hole was skipped is counted as late and dropped: it would
+ *   break the order the callback relies on.
+ *
+ *   With a gap sink (gap recovery), a hole open for max_hold_us is not
+ *   skipped but reported to the SequenceTracker at once, and the unit keeps
+ *   holding for up to recovery_hold_us more while the replay is requested.
+ *   Replayed messages enter through on_packet() like live ones: they fill
+ *   the hole and the held packets follow them in sequence, while messages
+ *   a late line delivered meanwhile are dropped as late, so nothing reaches
+ *   the callback twice. The window bounds how much a unit can hold during
+ *   that round trip; beyond it the hole is skipped by overflow and the
+ *   replay, when it comes, is late. A gap sink therefore defaults the window
+ *   to kRecoveryWindow instead of kDefaultWindow; it should exceed the
+ *   busiest unit's message rate times the request round trip.
+ *
+ *   Held packets live in a ring per unit, indexed by sequence modulo the
+ *   window, allocated once at construction: holding and releasing never
+ *   allocate (a held packet keeps its PacketBufferPool buffer). Each unit
+ *   has a small spin lock (SpinLock.hpp), because both lines' receive
+ *   threads feed the same unit. Releases happen under it on purpose:
+ *   handing packets out after unlocking would let the other line's thread
+ *   overtake them, and the callback relies on a unit's packets arriving one
+ *   at a time and in order. The hold is bounded: one call releases at most
+ *   the packets held plus its own, i.e. window + 1 packets, and a waiter
+ *   spins with a pause hint, then yields, rather than burning the core.
+ *   Size the window with that worst case in mind.
+ */
+
+#pragma once
+
+#ifndef REORDER_BUFFER_HPP_
+#define REORDER_BUFFER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "SequenceTracker.hpp"
+#include "SpinLock.hpp"
+#include "UdpReceiver.hpp"
+
+namespace equix_md {
+
+/**
+ * @class ReorderBuffer
+ * @brief Releases each unit's sequenced packets in order, waiting a bounded time for holes to fill.
+ *
+ * on_packet() and expire() may be called from any thread. Counters are readable from any thread.
+ */
+class ReorderBuffer {
+public:
+    using Packet = UdpReceiver::Packet;
+
+    static constexpr size_t kMaxUnits = 256; ///< SeqUnitHeader unit is one byte.
+    static constexpr uint32_t kDefaultWindow = 256;   ///< Reordering between lines only
+    static constexpr uint32_t kRecoveryWindow = 4096; ///< With a gap sink: live packets held during a replay round trip
+
+    struct Config {
+        uint32_t window = 0;         ///< Messages a held packet may run ahead (rounded up to a power of two);
+                                     ///< 0 = kDefaultWindow, or kRecoveryWindow with a gap sink
+        uint32_t max_hold_us = 500;  ///< Longest wait for a hole to fill
+        uint32_t recovery_hold_us = 0; ///< With a gap sink: further wait for a reported hole's replay (0: skip at once)
+    };
+
+    /**
+     * @brief Per-unit counters (snapshot).
+     */
+    struct UnitStats {
+        uint32_t holding = 0;           ///< Packets held right now
+        uint64_t held = 0;              ///< Packets that arrived early and were held
+        uint64_t reordered = 0;         ///< Held packets released in order once their hole filled
+        uint64_t expired_holes = 0;     ///< Holes skipped after max_hold_us (or recovery_hold_us)
+        uint64_t reported_holes = 0;    ///< Holes reported to the gap sink while held
+        uint64_t overflows = 0;         ///< Packets too far ahead: everything held was released
+        uint64_t skipped_messages = 0;  ///< Messages in skipped holes (expired or overflowed)
+        uint64_t late = 0;              ///< Packets whose sequence had already been released past (dropped)
+        uint64_t duplicates = 0;        ///< Copies of a packet already held
+    };
+
+    /**
+     * @param gap_sink Tracker that held holes are reported to for recovery (nullptr: holes are
+     *                 skipped after max_hold_us and reach the tracker behind the buffer as gaps).
+     */
+    explicit ReorderBuffer(const Config &config, SequenceTracker *gap_sink = nullptr)
+        : window_(round_up_pow2(config.window == 0 ? (gap_sink ? kRecoveryWindow : kDefaultWindow)
+                                                   : config.window < 2 ? 2 : config.window)),
+          mask_(window_ - 1),
+          max_hold_ns_(static_cast<uint64_t>(config.max_hold_us) * 1000),
+          recovery_hold_ns_(gap_sink ? static_cast<uint64_t>(config.recovery_hold_us) * 1000 : 0),
+          gap_sink_(gap_sink),
+          slots_(new Slot[kMaxUnits * window_]) {}
+
+    ReorderBuffer(const ReorderBuffer &) = delete;
+    ReorderBuffer &operator=(const ReorderBuffer &) = delete;
+
+    /**
+     * @brief Take one packet; release(const Packet &) is called for every packet now in order.
+     * @param now_ns Monotonic clock the hold time is measured with (the same for every call).
+     * @return false if the packet was dropped (late, or a copy of one already held), true if it was
+     *         released or held.
+     */
+    template<typename Release>
+    bool on_packet(const Packet &packet, uint8_t unit, uint32_t sequence, uint8_t count, uint64_t now_ns,
+                   Release &&release) {
+        UnitState &state = units_[unit];
+        Slot *ring = &slots_[static_cast<size_t>(unit) * window_];
+        SpinGuard guard(state.lock);
+        const uint32_t end = sequence + count;
+        bool accepted = true;
+
+        if (sequence == 0) {
+            release(packet); // Unsequenced heartbeat
+        } else if (state.expected == 0 || sequence == state.expected) {
+            release(packet);
+            advance(state, ring, end, release);
+        } else if (sequence < state.expected) {
+            if (sequence == 1 && end < state.expected) {
+                flush(state, ring, release); // The unit restarted: what is held belongs to the old run
+                release(packet);
+                state.expected = end;
+                state.reported_end = 0;
+            } else if (end <= state.expected) {
+                if (count != 0) add_under_lock(state.late); // Released past already (its hole was skipped): dropped
+                accepted = false;
+            } else {
+                release(packet); // Overlaps the released range and continues past it
+                advance(state, ring, end, release);
+            }
+        } else if (sequence - state.expected >= window_) {
+            add_under_lock(state.overflows);
+            flush(state, ring, release);
+            if (sequence > state.expected) add_under_lock(state.skipped_messages, sequence - state.expected);
+            release(packet);
+            if (end > state.expected) state.expected = end;
+        } else {
+            Slot &slot = ring[sequence & mask_];
+            if (slot.sequence == sequence) {
+                add_under_lock(state.duplicates);
+                if (count > slot.count) { // A data packet replaces a heartbeat announcing the same sequence
+                    slot.packet = packet;
+                    slot.count = count;
+                } else {
+                    accepted = false;
+                }
+            } else {
+                slot.packet = packet;
+                slot.sequence = sequence;
+                slot.count = count;
+                slot.arrival_ns = now_ns;
+                if (holding(state) == 0) state.hold_since_ns = now_ns;
+                state.holding.store(holding(state) + 1, std::memory_order_relaxed);
+                add_under_lock(state.held);
+            }
+        }
+        expire_unit(state, unit, ring, now_ns, release);
+        return accepted;
+    }
+
+    /**
+     * @brief Skip (or report) the holes that have been open for max_hold_us, on every unit.
+     *
+     * on_packet() checks its own unit; call this periodically so units that went quiet
+     * with packets held are released too.
+     */
+    template<typename Release>
+    void expire(uint64_t now_ns, Release &&release) {
+        for (size_t unit = 0; unit < kMaxUnits; ++unit) {
+            UnitState &state = units_[unit];
+            if (state.holding.load(std::memory_order_relaxed) == 0) continue;
+            SpinGuard guard(state.lock);
+            expire_unit(state, static_cast<uint8_t>(unit), &slots_[unit * window_], now_ns, release);
+        }
+    }
+
+    /**
+     * @brief Snapshot of one unit's counters.
+     */
+    UnitStats unit_stats(uint8_t unit) const {
+        const UnitState &state = units_[unit];
+        UnitStats stats;
+        stats.holding = state.holding.load(std::memory_order_relaxed);
+        stats.held = state.held.load(std::memory_order_relaxed);
+        stats.reordered = state.reordered.load(std::memory_order_relaxed);
+        stats.expired_holes = state.expired_holes.load(std::memory_order_relaxed);
+        stats.reported_holes = state.reported_holes.load(std::memory_order_relaxed);
+        stats.overflows = state.overflows.load(std::memory_order_relaxed);
+        stats.skipped_messages = state.skipped_messages.load(std::memory_order_relaxed);
+        stats.late = state.late.load(std::memory_order_relaxed);
+        stats.duplicates = state.duplicates.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    uint32_t window() const { return window_; }
+    uint64_t max_hold_ns() const { return max_hold_ns_; }
+    uint64_t recovery_hold_ns() const { return recovery_hold_ns_; }
+
+private:
+    struct Slot {
+        Packet packet{nullptr, 0, {}, 0};
+        uint32_t sequence = 0; ///< 0 = empty (sequence 0 is never held)
+        uint8_t count = 0;
+        uint64_t arrival_ns = 0;
+    };
+
+    struct alignas(64) UnitState {
+        SpinLock lock;
+        uint32_t expected = 0;        ///< Next sequence to release, 0 until the unit is seen
+        uint64_t hold_since_ns = 0;   ///< Arrival of the oldest held packet
+        uint32_t reported_end = 0;    ///< End of the last hole reported to the gap sink
+        uint64_t recovery_deadline_ns = 0; ///< When the reported hole is skipped after all
+        std::atomic<uint32_t> holding{0};
+        std::atomic<uint64_t> held{0};
+        std::atomic<uint64_t> reordered{0};
+        std::atomic<uint64_t> expired_holes{0};
+        std::atomic<uint64_t> reported_holes{0};
+        std::atomic<uint64_t> overflows{0};
+        std::atomic<uint64_t> skipped_messages{0};
+        std::atomic<uint64_t> late{0};
+        std::atomic<uint64_t> duplicates{0};
+    };
+
+    static uint32_t round_up_pow2(uint32_t value) {
+        uint32_t power = 1;
+        while (power < value) power <<= 1;
+        return power;
+    }
+
+    static uint32_t holding(const UnitState &state) { return state.holding.load(std::memory_order_relaxed); }
+
+    template<typename Release>
+    void release_slot(UnitState &state, Slot &slot, Release &release) {
+        release(static_cast<const Packet &>(slot.packet));
+        slot.packet.buffer.reset();
+        slot.sequence = 0;
+        state.holding.store(holding(state) - 1, std::memory_order_relaxed);
+    }
+
+    /// Move the expected sequence to end, then release every held packet that is now in order.
+    template<typename Release>
+    void advance(UnitState &state, Slot *ring, uint32_t end, Release &release) {
+        uint32_t from = state.expected == 0 ? end : state.expected + 1;
+        state.expected = end;
+        while (holding(state) > 0) {
+            // Held packets the new range ran over (different packetization) are released as they are
+            for (uint32_t sequence = from; sequence < state.expected && holding(state) > 0; ++sequence) {
+                Slot &slot = ring[sequence & mask_];
+                if (slot.sequence == sequence) release_slot(state, slot, release);
+            }
+            Slot &slot = ring[state.expected & mask_];
+            if (slot.sequence != state.expected) break;
+            const uint32_t next = slot.sequence + slot.count;
+            add_under_lock(state.reordered);
+            release_slot(state, slot, release);
+            if (next == state.expected) break; // A heartbeat: nothing follows it yet
+            from = state.expected + 1;
+            state.expected = next;
+        }
+        if (holding(state) > 0) state.hold_since_ns = oldest_arrival(state, ring);
+    }
+
+    /// Release everything held, in sequence order, skipping the holes.
+    template<typename Release>
+    void flush(UnitState &state, Slot *ring, Release &release) {
+        while (holding(state) > 0) {
+            const uint32_t sequence = next_held(state, ring, 0);
+            if (sequence == 0) break;
+            Slot &slot = ring[sequence & mask_];
+            add_under_lock(state.skipped_messages, sequence - state.expected);
+            state.expected = sequence + slot.count;
+            release_slot(state, slot, release);
+        }
+    }
+
+    template<typename Release>
+    void expire_unit(UnitState &state, uint8_t unit, Slot *ring, uint64_t now_ns, Release &release) {
+        while (holding(state) > 0 && now_ns >= state.hold_since_ns + max_hold_ns_) {
+            const uint32_t next = next_held(state, ring, 1);
+            if (next == 0) break;
+            if (recovery_hold_ns_ != 0) {
+                if (state.expected >= state.reported_end) { // A new hole (what is left of a reported one is not)
+                    const PacketRef &revealed = ring[next & mask_].packet.buffer;
+                    gap_sink_->report_gap(SequenceGap{unit, state.expected, next - state.expected,
+                                                      revealed ? revealed->rx_timestamp_ns : 0});
+                    add_under_lock(state.reported_holes);
+                    state.reported_end = next;
+                    state.recovery_deadline_ns = now_ns + recovery_hold_ns_;
+                }
+                if (now_ns < state.recovery_deadline_ns) break;
+            }
+            add_under_lock(state.expired_holes);
+            add_under_lock(state.skipped_messages, next - state.expected);
+            state.expected = next;
+            advance(state, ring, next, release);
+        }
+    }
+
+    /// First held sequence at least first_offset past the expected one, 0 if none.
+    uint32_t next_held(const UnitState &state, const Slot *ring, uint32_t first_offset) const {
+        for (uint32_t offset = first_offset; offset < window_; ++offset) {
+            const uint32_t sequence = state.expected + offset;
+            if (ring[sequence & mask_].sequence == sequence) return sequence;
+        }
+        return 0;
+    }
+
+    uint64_t oldest_arrival(const UnitState &state, const Slot *ring) const {
+        uint64_t oldest = UINT64_MAX;
+        uint32_t found = 0;
+        for (uint32_t offset = 0; offset < window_ && found < holding(state); ++offset) {
+            const uint32_t sequence = state.expected + offset;
+            const Slot &slot = ring[sequence & mask_];
+            if (slot.sequence != sequence) continue;
+            ++found;
+            if (slot.arrival_ns < oldest) oldest = slot.arrival_ns;
+        }
+        return oldest;
+    }
+
+    const uint32_t window_;
+    const uint32_t mask_;
+    const uint64_t max_hold_ns_;
+    const uint64_t recovery_hold_ns_; ///< 0 without a gap sink
+    SequenceTracker *const gap_sink_;
+    std::unique_ptr<Slot[]> slots_;
+    std::array<UnitState, kMaxUnits> units_;
+};
+
+} // namespace equix_md
+
+#endif // REORDER_BUFFER_HPP_
@@ -0,0 +1,215 @@
+/**
+ * @file    SequenceTracker.hpp
+ * @brief   Per-unit sequence continuity tracking and gap detection.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: SequenceTracker.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Follows the SeqUnitHeader of every packet the pipeline accepts (after
+ *   A/B arbitration) and keeps, per matching unit, the next expected
+ *   sequence. Each packet is classified as in order, gap, duplicate, reset
+ *   (the unit restarted at sequence 1) or heartbeat (no messages; sequence 0
+ *   is an unsequenced heartbeat, a non-zero sequence announces the unit's
+ *   next sequence and can reveal a lost tail). Every gap is published as a
+ *   SequenceGap event on a lock-free queue for recovery stages to act on.
+ *   Both lines' receive threads may feed the same unit, so each unit has a
+ *   small spin lock (SpinLock.hpp) around classification and its counter
+ *   updates (one locked instruction per packet, cheaper than a
+ *   compare-and-swap plus atomic adds on every counter). Counters are readable from any thread
+ *   without locking.
+ */
+
+#pragma once
+
+#ifndef SEQUENCE_TRACKER_HPP_
+#define SEQUENCE_TRACKER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "SpinLock.hpp"
+#include "concurrent_queue/concurrentqueue.h"
+
+namespace equix_md {
+
+/**
+ * @brief Messages [first_sequence, first_sequence + count) of a unit were not received.
+ */
+struct SequenceGap {
+    uint8_t unit = 0;
+    uint32_t first_sequence = 0;
+    uint32_t count = 0;
+    uint64_t detected_ns = 0; ///< Receive timestamp of the packet that revealed the gap (0 if unknown).
+};
+
+/**
+ * @class SequenceTracker
+ * @brief Sequence continuity for up to 256 units.
+ *
+ * on_packet() and report_gap() may be called from any thread, for any unit.
+ * Counters and gap events are readable from any thread.
+ */
+class SequenceTracker {
+public:
+    static constexpr size_t kMaxUnits = 256;            ///< SeqUnitHeader unit is one byte.
+    static constexpr size_t kGapQueueCapacity = 1024;   ///< Gap events held per producing thread until polled.
+
+    enum class Verdict {
+        InOrder,   ///< Continues the unit (or is its first packet).
+        Gap,       ///< Messages before this packet were missed; a SequenceGap was published.
+        Duplicate, ///< Every message was already seen.
+        Reset,     ///< The unit restarted at sequence 1.
+        Heartbeat  ///< No messages, nothing missed.
+    };
+
+    /**
+     * @brief Per-unit counters (snapshot).
+     */
+    struct UnitStats {
+        uint32_t next_sequence = 0;  ///< Next expected sequence, 0 until the unit is seen.
+        uint64_t packets = 0;        ///< Packets carrying messages (duplicates excluded).
+        uint64_t messages = 0;
+        uint64_t heartbeats = 0;
+        uint64_t gaps = 0;
+        uint64_t lost_messages = 0;  ///< Sum of gap sizes.
+        uint64_t duplicates = 0;
+        uint64_t resets = 0;
+    };
+
+    SequenceTracker() : gap_events_(kGapQueueCapacity) {}
+
+    SequenceTracker(const SequenceTracker &) = delete;
+    SequenceTracker &operator=(const SequenceTracker &) = delete;
+
+    /**
+     * @brief Track one packet's header.
+     * @param timestamp_ns Receive time, copied into any gap event.
+     */
+    Verdict on_packet(uint8_t unit, uint32_t sequence, uint8_t count, uint64_t timestamp_ns = 0) {
+        UnitState &state = units_[unit];
+        SpinGuard guard(state.lock);
+        if (count == 0) add_under_lock(state.heartbeats);
+        if (sequence == 0) return Verdict::Heartbeat;
+
+        const uint32_t end = sequence + count;
+        const uint32_t expected = state.next_sequence.load(std::memory_order_relaxed);
+        Verdict verdict;
+        if (expected == 0 || sequence == expected) {
+            verdict = count ? Verdict::InOrder : Verdict::Heartbeat;
+        } else if (sequence > expected) {
+            verdict = Verdict::Gap;
+        } else if (sequence == 1 && end < expected) {
+            verdict = Verdict::Reset;
+        } else if (end <= expected) {
+            verdict = count ? Verdict::Duplicate : Verdict::Heartbeat;
+        } else {
+            verdict = Verdict::InOrder; // Overlaps the previous packet, continues past it
+        }
+        if (end > expected || verdict == Verdict::Reset) state.next_sequence.store(end, std::memory_order_relaxed);
+
+        switch (verdict) {
+            case Verdict::Gap: {
+                // A reorder window may have reported (part of) this hole already: publish the rest only
+                const uint32_t first = expected > state.reported_end ? expected : state.reported_end;
+                if (sequence > first) {
+                    add_under_lock(state.gaps);
+                    add_under_lock(state.lost_messages, sequence - first);
+                    publish_gap(SequenceGap{unit, first, sequence - first, timestamp_ns});
+                }
+                break;
+            }
+            case Verdict::Duplicate:
+                add_under_lock(state.duplicates);
+                return verdict;
+            case Verdict::Reset:
+                add_under_lock(state.resets);
+                state.reported_end = 0;
+                break;
+            default:
+                break;
+        }
+        if (count) {
+            add_under_lock(state.packets);
+            add_under_lock(state.messages, count);
+        }
+        return verdict;
+    }
+
+    /**
+     * @brief Take the oldest unhandled gap event.
+     * @return false if there is none.
+     */
+    bool poll_gap(SequenceGap &gap) { return gap_events_.try_dequeue(gap); }
+
+    /**
+     * @brief Publish a gap found outside the header stream (e.g. a reorder window timing out).
+     *
+     * When the packets after the hole arrive later, on_packet() does not publish that range again.
+     */
+    void report_gap(const SequenceGap &gap) {
+        UnitState &state = units_[gap.unit];
+        SpinGuard guard(state.lock);
+        const uint32_t end = gap.first_sequence + gap.count;
+        if (end > state.reported_end) state.reported_end = end;
+        add_under_lock(state.gaps);
+        add_under_lock(state.lost_messages, gap.count);
+        publish_gap(gap);
+    }
+
+    /**
+     * @brief Snapshot of one unit's counters.
+     */
+    UnitStats unit_stats(uint8_t unit) const {
+        const UnitState &state = units_[unit];
+        UnitStats stats;
+        stats.next_sequence = state.next_sequence.load(std::memory_order_relaxed);
+        stats.packets = state.packets.load(std::memory_order_relaxed);
+        stats.messages = state.messages.load(std::memory_order_relaxed);
+        stats.heartbeats = state.heartbeats.load(std::memory_order_relaxed);
+        stats.gaps = state.gaps.load(std::memory_order_relaxed);
+        stats.lost_messages = state.lost_messages.load(std::memory_order_relaxed);
+        stats.duplicates = state.duplicates.load(std::memory_order_relaxed);
+        stats.resets = state.resets.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * @brief Next expected sequence of a unit (0 until its first sequenced packet).
+     */
+    uint32_t next_sequence(uint8_t unit) const {
+        return units_[unit].next_sequence.load(std::memory_order_relaxed);
+    }
+
+    /// Gap events lost because the queue was full (nobody polling).
+    uint64_t gap_events_dropped() const { return gap_events_dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) UnitState {
+        SpinLock lock;
+        std::atomic<uint32_t> next_sequence{0};
+        uint32_t reported_end = 0; ///< End of the last range published through report_gap()
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> heartbeats{0};
+        std::atomic<uint64_t> gaps{0};
+        std::atomic<uint64_t> lost_messages{0};
+        std::atomic<uint64_t> duplicates{0};
+        std::atomic<uint64_t> resets{0};
+    };
+
+    void publish_gap(const SequenceGap &gap) {
+        if (!gap_events_.try_enqueue(gap)) gap_events_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::array<UnitState, kMaxUnits> units_;
+    moodycamel::ConcurrentQueue<SequenceGap> gap_events_;
+    alignas(64) std::atomic<uint64_t> gap_events_dropped_{0};
+};
+
+} // namespace equix_md
+
+#endif // SEQUENCE_TRACKER_HPP_
@@ -0,0 +1,95 @@
+/**
+ * @file    SpinLock.hpp
+ * @brief   Small spin lock for short per-unit critical sections shared by the receive threads.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: SpinLock.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   The sequence tracker and the reorder buffer serialize each unit between
+ *   the lines' receive threads with a one-byte lock: uncontended it costs a
+ *   single locked exchange. A waiter spins on a plain load with a CPU pause
+ *   hint (test-and-test-and-set, so the cache line is not bounced while it is
+ *   held), and yields its time slice after kSpinsBeforeYield attempts so a
+ *   holder that was preempted can run on a machine with few cores.
+ */
+
+#pragma once
+
+#ifndef SPIN_LOCK_HPP_
+#define SPIN_LOCK_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace equix_md {
+
+/**
+ * @brief Hint to the CPU that we are in a spin loop (frees pipeline resources for a sibling hyper-thread).
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @class SpinLock
+ * @brief Test-and-test-and-set lock (BasicLockable).
+ */
+class SpinLock {
+public:
+    static constexpr uint32_t kSpinsBeforeYield = 1024;
+
+    void lock() {
+        while (locked_.exchange(true, std::memory_order_acquire)) {
+            uint32_t spins = 0;
+            while (locked_.load(std::memory_order_relaxed)) {
+                if (++spins < kSpinsBeforeYield) {
+                    cpu_relax();
+                } else {
+                    std::this_thread::yield();
+                    spins = 0;
+                }
+            }
+        }
+    }
+
+    void unlock() { locked_.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> locked_{false};
+};
+
+/**
+ * @class SpinGuard
+ * @brief Holds a SpinLock for the guard's scope.
+ */
+class SpinGuard {
+public:
+    explicit SpinGuard(SpinLock &lock) : lock_(lock) { lock_.lock(); }
+    ~SpinGuard() { lock_.unlock(); }
+    SpinGuard(const SpinGuard &) = delete;
+    SpinGuard &operator=(const SpinGuard &) = delete;
+
+private:
+    SpinLock &lock_;
+};
+
+/**
+ * @brief Add to a counter that is only written under a lock but read by any thread.
+ *
+ * A relaxed load and store instead of a locked fetch_add: the lock already orders the writers.
+ */
+inline void add_under_lock(std::atomic<uint64_t> &counter, uint64_t delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+} // namespace equix_md
+
+#endif // SPIN_LOCK_HPP_
@@ -0,0 +1,134 @@
+/**
+ * @file    Symbol.hpp
+ * @brief   Trading symbol packed into one 64-bit word.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: Symbol.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   PITCH symbols are at most 6 ASCII characters, space padded on the wire.
+ *   Symbol keeps up to 8 characters in a uint64_t (first character in the
+ *   lowest byte, unused bytes zero), so copying, comparing and hashing are
+ *   single-word operations and nothing is allocated. Text conversion happens
+ *   only at the edges (wire decode, logging, Kafka topic creation).
+ */
+
+#pragma once
+
+#ifndef SYMBOL_HPP_
+#define SYMBOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace equix_md {
+
+/**
+ * @class Symbol
+ * @brief Trivially copyable, 8-byte symbol value.
+ */
+class Symbol {
+public:
+    static constexpr size_t kMaxLength = 8;  ///< Characters a Symbol can hold
+    static constexpr size_t kWireLength = 6; ///< PITCH symbol field width
+
+    constexpr Symbol() = default;
+
+    /**
+     * @brief Pack text, dropping trailing spaces. Characters past kMaxLength are cut off.
+     */
+    explicit Symbol(std::string_view text) {
+        while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+        const size_t length = text.size() < kMaxLength ? text.size() : kMaxLength;
+        for (size_t i = 0; i < length; ++i)
+            packed_ |= static_cast<uint64_t>(static_cast<uint8_t>(text[i])) << (8 * i);
+    }
+
+    /**
+     * @brief Decode a space-padded PITCH symbol field (kWireLength bytes).
+     */
+    static Symbol from_wire(const uint8_t *field) {
+        uint64_t packed = 0;
+        std::memcpy(&packed, field, kWireLength); // Little-endian: first character in the low byte
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        packed = __builtin_bswap64(packed);
+#endif
+        // Clear right padding one byte at a time from the top
+        for (int shift = 8 * (kWireLength - 1); shift >= 0; shift -= 8) {
+            if (((packed >> shift) & 0xFF) != ' ') break;
+            packed &= ~(uint64_t{0xFF} << shift);
+        }
+        return from_packed(packed);
+    }
+
+    static constexpr Symbol from_packed(uint64_t packed) {
+        Symbol symbol;
+        symbol.packed_ = packed;
+        return symbol;
+    }
+
+    constexpr uint64_t packed() const { return packed_; }
+    constexpr bool empty() const { return packed_ == 0; }
+
+    size_t size() const {
+        size_t length = 0;
+        while (length < kMaxLength && ((packed_ >> (8 * length)) & 0xFF) != 0) ++length;
+        return length;
+    }
+
+    /**
+     * @brief Copy the characters into out (at least kMaxLength bytes); returns the length.
+     */
+    size_t copy_to(char *out) const {
+        const size_t length = size();
+        for (size_t i = 0; i < length; ++i) out[i] = static_cast<char>(packed_ >> (8 * i));
+        return length;
+    }
+
+    std::string to_string() const {
+        char text[kMaxLength];
+        return std::string(text, copy_to(text));
+    }
+
+    constexpr bool operator==(const Symbol &other) const { return packed_ == other.packed_; }
+    constexpr bool operator!=(const Symbol &other) const { return packed_ != other.packed_; }
+    constexpr bool operator<(const Symbol &other) const { return packed_ < other.packed_; }
+
+private:
+    uint64_t packed_ = 0;
+};
+
+/**
+ * @brief Hash for Symbol keys: one multiply and a fold, so symbols that differ
+ *        only in their last characters still spread across buckets.
+ */
+struct SymbolHash {
+    size_t operator()(const Symbol &symbol) const {
+        const unsigned __int128 product =
+                static_cast<unsigned __int128>(symbol.packed()) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64));
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Symbol &symbol) {
+    char text[Symbol::kMaxLength];
+    return os.write(text, static_cast<std::streamsize>(symbol.copy_to(text)));
+}
+
+static_assert(sizeof(Symbol) == sizeof(uint64_t), "Symbol is one word");
+
+} // namespace equix_md
+
+namespace std {
+template<>
+struct hash<equix_md::Symbol> : equix_md::SymbolHash {};
+} // namespace std
+
+#endif // SYMBOL_HPP_
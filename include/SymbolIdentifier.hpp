@@ -8,9 +8,15 @@
  * Created: 28/May/2025
  *
  * Description:
- *   Provides an efficient mapping from unique order IDs to trading symbol strings.
- *   Uses tsl::robin_map for high-performance insert and lookup.
- *   Thread-safety is NOT provided by this class.
+ *   Provides an efficient mapping from unique order IDs to trading symbols.
+ *   Uses tsl::robin_map for high-performance insert and lookup; symbols are
+ *   stored packed (equix_md::Symbol), so entries are two words and nothing
+ *   is allocated per order.
+ *   Every receive thread parses, and so do the main loop (reorder expiry)
+ *   and the gap recovery thread, while consumers look symbols up. The map is
+ *   split into kShards stripes selected by a hash of the order ID, each with
+ *   its own mutex, so threads working on different orders rarely meet on
+ *   the same lock (one global mutex serialized all parsing).
  */
 
 #pragma once
@@ -18,8 +24,12 @@
 #ifndef SYMBOL_IDENTIFIER_HPP_
 #define SYMBOL_IDENTIFIER_HPP_
 
-#include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <optional>
+#include "Symbol.hpp"
 #include "tsl/robin_map.h"
 
 namespace equix_md {
@@ -28,7 +38,8 @@ namespace equix_md {
  * @class SymbolIdentifier
  * @brief Fast mapping from order IDs to trading symbols using robin_map.
  *
- * Not thread-safe: external synchronization is required for concurrent use.
+ * Thread-safe: a call on one order ID locks only that order's stripe; mapping_count() and
+ * reserve() visit the stripes one after another.
  */
 class SymbolIdentifier {
 public:
@@ -41,17 +52,17 @@ public:
     /**
      * @brief Add a mapping from an order ID to a symbol.
      * @param order_id      Unique order identifier.
-     * @param symbol_name   Associated trading symbol string.
+     * @param symbol        Associated trading symbol.
      * @return true if inserted, false if order_id already existed.
      */
-    bool add_mapping(uint64_t order_id, const std::string& symbol_name);
+    bool add_mapping(uint64_t order_id, Symbol symbol);
 
     /**
      * @brief Look up the symbol associated with a given order ID.
      * @param order_id  Unique order identifier.
-     * @return Optional symbol string if found, otherwise std::nullopt.
+     * @return Optional symbol if found, otherwise std::nullopt.
      */
-    std::optional<std::string> find_symbol(uint64_t order_id) const;
+    std::optional<Symbol> find_symbol(uint64_t order_id) const;
 
     /**
      * @brief Remove a mapping for a given order ID.
@@ -72,8 +83,23 @@ public:
      */
     void reserve(size_t min_capacity);
 
+    static constexpr size_t kShards = 64; ///< Lock stripes (power of two).
+
 private:
-    tsl::robin_map<uint64_t, std::string> order_to_symbol_map_; ///< Internal mapping from order ID to symbol name.
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;                             ///< Guards order_to_symbol_map.
+        tsl::robin_map<uint64_t, Symbol> order_to_symbol_map; ///< Mapping from order ID to symbol for this stripe.
+    };
+
+    /// Order IDs are often allocated sequentially: mix the bits before picking a stripe.
+    static size_t shard_index(uint64_t order_id) {
+        return static_cast<size_t>((order_id * 0x9E3779B97F4A7C15ULL) >> 58) & (kShards - 1);
+    }
+
+    Shard &shard_for(uint64_t order_id) { return shards_[shard_index(order_id)]; }
+    const Shard &shard_for(uint64_t order_id) const { return shards_[shard_index(order_id)]; }
+
+    std::array<Shard, kShards> shards_;
 };
 
 } // namespace equix_md
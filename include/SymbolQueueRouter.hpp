@@ -11,6 +11,8 @@
  *   Provides a thread-safe mechanism for routing messages by symbol.
  *   Each unique symbol is associated with its own concurrent queue.
  *   Queues are created on demand and can be safely accessed from multiple threads.
+ *   Keys are packed equix_md::Symbol values: hashing and comparing a key is a
+ *   couple of integer operations and routing never allocates.
  */
 
 #pragma once
@@ -21,8 +23,8 @@
 #include <memory>
 #include <mutex>
 #include <vector>
-#include <string>
 #include <iostream> // DEBUG: for std::cout
+#include "Symbol.hpp"
 #include "tsl/robin_map.h"
 #include "concurrent_queue/concurrentqueue.h"
 #include "pitch/message_factory.h"
@@ -38,7 +40,7 @@
 class SymbolQueueRouter {
 public:
     using Message      = CboePitch::Message;
-    using SymbolId     = std::string;
+    using SymbolId     = equix_md::Symbol;
     using MessagePtr   = std::shared_ptr<Message>;
     using Queue        = moodycamel::ConcurrentQueue<MessagePtr>;
 
@@ -57,31 +59,20 @@ public:
 
     /**
      * @brief Thread-safe: Push a message to the queue for a symbol, creating the queue if needed.
-     * @param symbol    Symbol string (key).
+     * @param symbol    Symbol (key).
      * @param msg       Unique pointer to message.
      * @return true if the message was enqueued, false otherwise.
      */
-    bool push(const SymbolId& symbol, MessagePtr msg) {
-
-        // Capture queue count before
-        size_t before_count = queue_count();
-        auto queue_ptr = get_or_create_queue(symbol);
-        bool enqueued = queue_ptr->try_enqueue(std::move(msg));
-        // DEBUG
-        size_t after_count = queue_count();
-        if (after_count > before_count) {
-            // std::cout << "[SymbolQueueRouter::push] New symbol added: '" << symbol << "'. Now "
-                      // << after_count << " queues.\n";
-        }
-        return enqueued;
+    bool push(SymbolId symbol, MessagePtr msg) {
+        return get_or_create_queue(symbol).try_enqueue(std::move(msg));
     }
 
     /**
      * @brief Thread-safe: Find the queue for a symbol, or nullptr if not found.
-     * @param symbol    Symbol string (key).
+     * @param symbol    Symbol (key).
      * @return Shared pointer to the queue, or nullptr if not found.
      */
-    std::shared_ptr<Queue> find_queue(const SymbolId& symbol) const {
+    std::shared_ptr<Queue> find_queue(SymbolId symbol) const {
         std::lock_guard<std::mutex> lock(router_mutex_);
         auto it = queues_.find(symbol);
         if (it != queues_.end()) {
@@ -93,7 +84,7 @@ public:
 
     /**
      * @brief Get a copy of all known symbols in insertion order.
-     * @return Vector of all registered symbol strings.
+     * @return Vector of all registered symbols.
      */
     std::vector<SymbolId> get_symbol_list() const {
         std::lock_guard<std::mutex> lock(router_mutex_);
@@ -120,15 +111,16 @@ public:
 private:
     /**
      * @brief Internal: Always returns a valid queue, creating it if it doesn't exist.
-     * @param symbol    Symbol string (key).
-     * @return Shared pointer to the queue.
+     * @param symbol    Symbol (key).
+     * @return The queue. Queues are never removed, so the reference stays valid for the
+     *         router's lifetime (and no shared_ptr refcount is touched per message).
      */
-    std::shared_ptr<Queue> get_or_create_queue(const SymbolId& symbol) {
+    Queue& get_or_create_queue(SymbolId symbol) {
         {
             std::lock_guard<std::mutex> lock(router_mutex_);
             auto it = queues_.find(symbol);
             if (it != queues_.end()) {
-                return it->second;
+                return *it->second;
             }
         }
         // Acquire lock again to safely insert new queue if it was not found
@@ -141,12 +133,12 @@ private:
         } else {
             // std::cout << "[SymbolQueueRouter::get_or_create_queue] Queue for symbol=" << symbol << " already created by another thread (race condition)" << std::endl;
         }
-        return queue_ptr;
+        return *queue_ptr;
     }
 
     mutable std::mutex router_mutex_; ///< Mutex protects queues_ and symbol_insertion_order_
-    tsl::robin_map<SymbolId, std::shared_ptr<Queue>> queues_; ///< Map from symbol to concurrent queue
-    std::vector<SymbolId> symbol_insertion_order_; ///< Insertion-order vector of symbol strings
+    tsl::robin_map<SymbolId, std::shared_ptr<Queue>, equix_md::SymbolHash> queues_; ///< Map from symbol to concurrent queue
+    std::vector<SymbolId> symbol_insertion_order_; ///< Insertion-order vector of symbols
     std::vector<std::shared_ptr<Queue>> queue_vector_;
     size_t queue_capacity_; ///< Per-queue capacity hint
 };
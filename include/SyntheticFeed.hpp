@@ -0,0 +1,140 @@
+/**
+ * @file    SyntheticFeed.hpp
+ * @brief   Synthetic PITCH feed generator.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: SyntheticFeed.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Produces sequenced unit datagrams for a configurable symbol universe
+ *   (up to kMaxSymbols) whose activity follows a Zipf distribution: symbol
+ *   rank r is picked with weight 1 / r^s, so a few names dominate and a long
+ *   tail trades rarely, as on a real venue. Orders have a life cycle: adds
+ *   create them, and executes, modifies, size reductions and deletes refer
+ *   to orders that are still live. The operation mix is set by weights.
+ *   Symbols are spread over the matching units, each with its own sequence.
+ *   Output is deterministic for a given seed.
+ */
+
+#ifndef SYNTHETIC_FEED_HPP_
+#define SYNTHETIC_FEED_HPP_
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Symbol.hpp"
+#include "pitch/message_encoder.h"
+#include "pitch/price.h"
+
+namespace equix_md {
+
+/**
+ * @class SyntheticFeed
+ * @brief Generates one datagram at a time; not thread-safe.
+ */
+class SyntheticFeed {
+public:
+    static constexpr size_t kMaxSymbols = 300000;
+
+    enum Operation : size_t { kAdd, kExecute, kModify, kReduce, kDelete, kTrade, kOperationCount };
+
+    struct Config {
+        size_t symbols = 10000;
+        double zipf_exponent = 1.0;            ///< s in 1 / rank^s; 0 = uniform
+        uint8_t units = 4;                     ///< Symbols are spread over units 1..units
+        uint32_t first_sequence = 1;
+        size_t messages_per_packet = 8;        ///< Upper bound; a packet also closes at max_packet_size
+        size_t max_packet_size = CboePitch::SequencedUnitEncoder::DEFAULT_MAX_SIZE;
+        size_t max_live_orders = 1000000;      ///< Adds turn into deletes once the book is this deep
+        /// Relative weights of add, execute, modify, reduce, delete, trade.
+        std::array<uint32_t, kOperationCount> mix = {{45, 10, 15, 5, 20, 5}};
+        uint64_t start_timestamp_ns = 1748304000000000000ULL; ///< 2025-05-27 00:00 UTC, near the example captures
+        uint64_t message_gap_ns = 1000;        ///< Timestamp step between messages
+        uint64_t seed = 1;
+    };
+
+    /**
+     * @brief One generated datagram; points into the generator, valid until the next call.
+     */
+    struct Datagram {
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+        uint8_t unit = 0;
+        uint32_t sequence = 0;   ///< Of the first message
+        size_t messages = 0;
+        uint64_t timestamp_ns = 0; ///< Generator clock when the packet closed
+    };
+
+    /**
+     * @throws std::invalid_argument for an empty or oversized symbol universe, no units or an all-zero mix.
+     */
+    explicit SyntheticFeed(const Config &config);
+
+    /**
+     * @brief Generate messages until one unit's packet is complete, and return it.
+     */
+    Datagram next();
+
+    const Config &config() const { return config_; }
+    const std::vector<Symbol> &symbols() const { return symbols_; }
+    uint8_t unit_of(size_t symbol_index) const { return static_cast<uint8_t>(symbol_index % config_.units + 1); }
+
+    uint64_t messages() const { return messages_; }
+    uint64_t operations(Operation operation) const { return operations_[operation]; }
+    size_t live_orders() const { return live_.size(); }
+
+    /**
+     * @brief Symbol name for a popularity rank: A..Z, AA..ZZ, ... (at most 4 letters for kMaxSymbols).
+     */
+    static Symbol symbol_name(size_t rank);
+
+private:
+    struct Order {
+        uint64_t id;
+        uint32_t symbol;
+        uint32_t quantity;
+        CboePitch::Price price;
+        char side;
+    };
+
+    size_t pick_symbol();
+    CboePitch::Price pick_price(uint32_t symbol);
+    uint32_t pick_quantity();
+
+    /// Encode one operation into its unit's packet; returns that unit's index.
+    size_t generate(Operation operation, uint64_t timestamp_ns);
+
+    /// Add to the unit's packet, emitting the packet first if the message does not fit.
+    template<typename Layout, typename... Values>
+    void append(size_t unit_index, Values &&... values);
+
+    void emit(size_t unit_index);
+
+    Config config_;
+    std::mt19937_64 rng_;
+    std::vector<Symbol> symbols_;
+    std::vector<CboePitch::Price> reference_prices_;
+    std::vector<double> cdf_; ///< Cumulative Zipf weights, last = 1
+    std::discrete_distribution<size_t> operation_dist_;
+    std::vector<CboePitch::SequencedUnitEncoder> encoders_; ///< One per unit
+    std::vector<Order> live_;
+    uint64_t next_order_id_ = 1;
+    uint64_t next_execution_id_ = 1;
+    uint64_t timestamp_ns_;
+
+    std::array<uint8_t, CboePitch::SequencedUnitEncoder::CAPACITY> out_{};
+    Datagram ready_;
+    bool has_ready_ = false;
+
+    uint64_t messages_ = 0;
+    std::array<uint64_t, kOperationCount> operations_{};
+};
+
+} // namespace equix_md
+
+#endif // SYNTHETIC_FEED_HPP_
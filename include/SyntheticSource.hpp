@@ -0,0 +1,96 @@
+/**
+ * @file    SyntheticSource.hpp
+ * @brief   Synthetic feed packet source that feeds the receive callback directly.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: SyntheticSource.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Runs a SyntheticFeed on a background thread and hands its datagrams to
+ *   the same batch callback a UdpReceiver uses, through PacketBufferPool
+ *   buffers, like PcapSource does for capture files. This drives the
+ *   pipeline with symbol universes far larger than the example captures.
+ *   It can run as fast as possible or at a fixed datagram rate.
+ */
+
+#ifndef SYNTHETIC_SOURCE_HPP_
+#define SYNTHETIC_SOURCE_HPP_
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "PacketBufferPool.hpp"
+#include "SyntheticFeed.hpp"
+#include "UdpReceiver.hpp"
+
+/**
+ * @class SyntheticSource
+ * @brief Injects generated PITCH datagrams as if a receiver had read them.
+ */
+class SyntheticSource {
+public:
+    struct Config {
+        equix_md::SyntheticFeed::Config feed;
+        uint64_t packets = 0;       ///< Datagrams to generate (0 = until stopped)
+        uint64_t rate_pps = 0;      ///< Datagrams per second (0 = as fast as the pool allows)
+        size_t batch_size = 32;     ///< Datagrams per callback
+        int cpu_affinity_core = -1; ///< -1 means no affinity
+    };
+
+    struct Stats {
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t messages = 0;
+        uint64_t elapsed_ns = 0;
+        bool finished = false;
+    };
+
+    /**
+     * @param config Generator and pacing settings.
+     * @param pool   Buffer pool datagrams are written into; must outlive the source.
+     * @throws std::invalid_argument for an invalid feed configuration.
+     */
+    SyntheticSource(const Config &config, equix_md::PacketBufferPool &pool);
+
+    ~SyntheticSource();
+
+    SyntheticSource(const SyntheticSource &) = delete;
+    SyntheticSource &operator=(const SyntheticSource &) = delete;
+
+    /**
+     * @brief Start generating on a background thread.
+     */
+    void start(UdpReceiver::BatchPacketCallback callback);
+
+    void stop();
+
+    Stats stats() const;
+
+    const Config &config() const { return config_; }
+
+private:
+    void run(const UdpReceiver::BatchPacketCallback &callback);
+
+    /// Single-writer counter: only the generator thread stores, readers load relaxed.
+    static void bump(std::atomic<uint64_t> &counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    Config config_;
+    equix_md::PacketBufferPool &pool_;
+    equix_md::SyntheticFeed feed_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> finished_{false};
+    std::thread thread_;
+
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> messages_{0};
+    std::atomic<uint64_t> started_ns_{0};
+    std::atomic<uint64_t> finished_ns_{0};
+};
+
+#endif // SYNTHETIC_SOURCE_HPP_
@@ -8,21 +8,59 @@
  * Created: 28/May/2025
  *
  * Description:
- *   UdpReceiver provides asynchronous UDP packet reception. For every
- *   datagram received, it invokes a user-provided callback. The receive
- *   thread can optionally have its CPU affinity or real-time priority set.
+ *   UdpReceiver provides asynchronous UDP packet reception. Datagrams are
+ *   received straight into reference-counted buffers from a shared
+ *   PacketBufferPool and either handed to a per-packet callback or, with
+ *   batched receive enabled, pulled up to Config::batch_size at a time
+ *   (recvmmsg on Linux) and delivered as one batch. Each buffer carries the
+ *   kernel receive timestamp (SO_TIMESTAMPNS). What the thread does when
+ *   the socket is empty is chosen per receiver (busy-spin, spin-then-yield,
+ *   SO_BUSY_POLL or epoll_wait). The receive thread can optionally have its
+ *   CPU affinity or real-time priority set.
+ *
+ *   Instead of a UDP socket, a receiver can read frames from an AF_PACKET
+ *   TPACKET_V3 memory-mapped ring on a named interface (packet_mmap backend).
+ *   A classic BPF filter keeps only IPv4/UDP frames for the configured port,
+ *   frames are re-checked in user space, and the UDP payloads are delivered
+ *   through the same batch callback.
+ *
+ *   The io_uring backend keeps one multishot recvmsg armed on the UDP socket
+ *   with a provided-buffer ring made of pool buffers, so the kernel writes
+ *   each datagram straight into a PacketBuffer and completions are reaped
+ *   in batches. Without kernel support it falls back to the socket path.
+ *
+ *   Every receiver keeps a ReceiveCounters block: packets, bytes, batch-size
+ *   histogram, the longest time the socket went unread while data could be
+ *   pending, and kernel drops (SO_RXQ_OVFL on UDP sockets, PACKET_STATISTICS
+ *   on the packet ring). Each delivered Packet also carries the drops seen
+ *   just before it, so sequence gaps can be blamed on the kernel or upstream.
  */
 
 #ifndef UDP_RECEIVER_HPP_
 #define UDP_RECEIVER_HPP_
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <thread>
 #include <atomic>
 #include <functional>
 #include <vector>
 #include <cstdint>
+#include <optional>
+#include <memory>
+#include "PacketBufferPool.hpp"
+#include "LatencyStats.hpp"
+#include "ReceiveCounters.hpp"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+struct tpacket3_hdr;
+struct io_uring_buf_ring;
+namespace equix_md { class IoUring; }
+#endif
 
 /**
  * @file    UdpReceiver.hpp
@@ -31,32 +69,335 @@
 
 class UdpReceiver {
 public:
+    /**
+     * @brief What the receive thread does when the socket has nothing to read.
+     */
+    enum class IdleStrategy {
+        BusySpin,  ///< Re-poll immediately (lowest latency, burns the core).
+        SpinYield, ///< Busy-spin for idle_spin_count polls, then yield the time slice between polls.
+        BusyPoll,  ///< Busy-spin with SO_BUSY_POLL set, so each empty read polls the NIC queue.
+        Epoll      ///< Block in epoll_wait; wakes on data or after epoll_timeout_ms to check for shutdown.
+    };
+
+    /**
+     * @brief Where datagrams are read from.
+     */
+    enum class Backend {
+        Socket,    ///< Bound UDP socket (recvfrom / recvmmsg).
+        PacketMmap, ///< AF_PACKET TPACKET_V3 ring on capture_interface, filtered to bind_port.
+        IoUring     ///< Multishot recvmsg on the UDP socket into a provided-buffer ring (falls back to Socket).
+    };
+
     struct Config {
         std::string bind_ip = "0.0.0.0";
         uint16_t bind_port = 9000;
         int cpu_affinity_core = -1; ///< -1 means no affinity
         int thread_realtime_priority = 0; ///< 0 = normal priority
+        size_t batch_size = 1; ///< Max datagrams per receive syscall (1 = one recvfrom per datagram)
+        IdleStrategy idle_strategy = IdleStrategy::Epoll;
+        uint32_t idle_spin_count = 10000; ///< SpinYield: empty polls before yielding
+        int busy_poll_usec = 50; ///< BusyPoll: SO_BUSY_POLL budget in microseconds
+        int epoll_timeout_ms = 100; ///< Epoll: max wait before re-checking for shutdown
+        std::string multicast_group; ///< Empty = unicast on bind_ip; otherwise the group to join
+        std::string interface_ip; ///< Local interface address for the membership (empty = kernel choice)
+        std::string source_ip; ///< Non-empty = source-specific join (SSM) to this sender
+        int recv_buffer_bytes = 0; ///< SO_RCVBUF(FORCE) request; 0 keeps the kernel default
+        bool kernel_timestamps = true; ///< Stamp datagrams with SO_TIMESTAMPNS (else user-space clock)
+        Backend backend = Backend::Socket;
+        std::string capture_interface = "lo"; ///< PacketMmap: interface name the ring is bound to
+        uint32_t ring_block_bytes = 1u << 22; ///< PacketMmap: ring block size (multiple of the page size)
+        uint32_t ring_block_count = 64; ///< PacketMmap: number of ring blocks
+        uint32_t ring_block_timeout_ms = 1; ///< PacketMmap: kernel retires a partly filled block after this
+        uint32_t uring_buffer_count = 1024; ///< IoUring: pool buffers lent to the kernel (rounded up to a power of two)
+    };
+
+    /**
+     * @brief Receive counters, written only by the receive thread.
+     */
+    using Stats = equix_md::ReceiveCounters::Snapshot;
+
+    /// Largest datagram accepted; longer ones are truncated by the kernel.
+    static constexpr size_t kMaxDatagramSize = equix_md::PacketBuffer::kCapacity;
+
+    /**
+     * @brief One received datagram inside a batch.
+     *
+     * data/size point into the pooled buffer (not necessarily at its start:
+     * the io_uring backend places a receive header first). The receiver drops its own
+     * reference once the batch callback returns, so copy `buffer` to keep the
+     * bytes alive past the callback. buffer->rx_timestamp_ns holds the
+     * receive time (CLOCK_REALTIME ns).
+     */
+    struct Packet {
+        const char *data;
+        size_t size;
+        equix_md::PacketRef buffer;
+        uint32_t kernel_drops = 0; ///< Datagrams the kernel dropped on this socket just before this one
     };
 
     using PacketCallback = std::function<void(const std::vector<char> &)>;
+    using BatchPacketCallback = std::function<void(const Packet *packets, size_t count)>;
 
-    explicit UdpReceiver(const Config &config);
+    /**
+     * @brief Create and bind the socket.
+     * @param config Socket and thread settings.
+     * @param pool   Buffer pool datagrams are received into; must outlive the receiver
+     *               and every PacketRef handed to the callback.
+     */
+    UdpReceiver(const Config &config, equix_md::PacketBufferPool &pool);
 
     ~UdpReceiver();
 
+    /**
+     * @brief Start receiving, invoking the callback once per datagram (copied into a vector).
+     */
     void start(PacketCallback callback);
 
+    /**
+     * @brief Start receiving, invoking the callback once per receive batch.
+     *
+     * Each call carries between 1 and Config::batch_size datagrams.
+     */
+    void start(BatchPacketCallback callback);
+
     void stop();
 
+    /**
+     * @brief Receive one batch on the calling thread and hand it to the callback.
+     *
+     * For receivers driven by a UdpReceiverGroup instead of start(); a receiver
+     * must be driven by exactly one thread.
+     * @return Datagrams delivered, 0 if none were pending, -1 on error (errno set).
+     */
+    int poll(const BatchPacketCallback &callback);
+
+    /**
+     * @brief Descriptor that turns readable when poll() has work (UDP socket, packet ring or io_uring ring).
+     */
+    int wait_fd() const;
+
+    /// Wait before reading again while the pool is empty (the descriptor stays readable meanwhile).
+    static constexpr std::chrono::microseconds kPoolStallBackoff{50};
+
+    /**
+     * @brief True if the last poll() read nothing because the packet pool had no free buffer.
+     *
+     * The socket may still be readable, so a caller that waits on wait_fd() must back off
+     * (kPoolStallBackoff) instead, or it spins until downstream releases buffers.
+     */
+    bool pool_starved() const { return pool_starved_; }
+
+    /**
+     * @brief Pin the calling thread to a CPU core (no-op for core < 0).
+     */
+    static void pin_current_thread(int core);
+
+    /**
+     * @brief Give the calling thread SCHED_FIFO at the given priority (no-op for priority <= 0).
+     */
+    static void set_current_thread_realtime(int priority);
+
+    /**
+     * @brief Snapshot of the receive counters; safe to call from any thread.
+     */
+    Stats stats() const;
+
+    const Config &config() const { return config_; }
+
+    /**
+     * @brief Receive buffer size reported by the kernel after setup (SO_RCVBUF).
+     */
+    int granted_recv_buffer_bytes() const { return granted_recv_buffer_bytes_; }
+
+    /**
+     * @brief Parse an idle strategy name ("busy_spin", "spin_yield", "busy_poll", "epoll").
+     * @return The strategy, or std::nullopt if the name is unknown.
+     */
+    static std::optional<IdleStrategy> idle_strategy_from_string(const std::string &name);
+
+    /**
+     * @brief Config-file name of an idle strategy.
+     */
+    static const char *idle_strategy_name(IdleStrategy strategy);
+
+    /**
+     * @brief Parse a backend name ("socket", "packet_mmap").
+     * @return The backend, or std::nullopt if the name is unknown.
+     */
+    static std::optional<Backend> backend_from_string(const std::string &name);
+
+    /**
+     * @brief Config-file name of a backend.
+     */
+    static const char *backend_name(Backend backend);
+
 private:
     void setup_thread_affinity();
 
     void setup_realtime_priority();
 
+    /**
+     * @brief Receive up to Config::batch_size datagrams into pooled buffers.
+     * @return Number of datagrams received, 0 if none pending (or pool empty), -1 on error.
+     */
+    int receive_batch();
+
+    /**
+     * @brief Make sure every batch slot holds a pool buffer.
+     * @return Number of leading slots ready to receive into.
+     */
+    size_t refill_batch_slots();
+
+    /**
+     * @brief Create the UDP socket, size its buffer, bind it and join the multicast group if configured.
+     * @throws std::runtime_error on socket, bind or membership failure.
+     */
+    void open_udp_socket();
+
+    /**
+     * @brief Create the AF_PACKET socket, attach the port filter, map the TPACKET_V3 ring and bind it.
+     * @throws std::runtime_error if the interface, ring or mapping cannot be set up.
+     */
+    void open_packet_ring();
+
+    /**
+     * @brief Copy up to Config::batch_size matching UDP payloads out of the ring into pooled buffers.
+     * @return Number of datagrams delivered, 0 if no block is ready (or pool empty).
+     */
+    int receive_ring_batch();
+
+    /**
+     * @brief Create the io_uring instance and provided-buffer ring, and arm the multishot recvmsg.
+     * @return false (after logging the reason) if the kernel lacks support; the socket path is used instead.
+     */
+    bool setup_uring();
+
+    /**
+     * @brief Hand fresh pool buffers to the kernel for every buffer id delivered since the last call.
+     */
+    void provide_uring_buffers();
+
+    /**
+     * @brief Submit the multishot recvmsg SQE.
+     */
+    bool arm_uring_recv();
+
+    /**
+     * @brief Reap up to Config::batch_size completions into batch slots.
+     * @return Number of datagrams delivered, 0 if none completed.
+     */
+    int receive_uring_batch();
+
+    /**
+     * @brief Tear down io_uring state, unmap the ring and close every descriptor the receiver owns.
+     */
+    void close_descriptors();
+
+    /**
+     * @brief Request Config::recv_buffer_bytes (SO_RCVBUFFORCE, then SO_RCVBUF) and log what was granted.
+     */
+    void setup_receive_buffer();
+
+    /**
+     * @brief Join Config::multicast_group (any-source or source-specific) on a socket.
+     * @throws std::runtime_error if the membership cannot be added.
+     */
+    void join_multicast_group(int fd);
+
+    /**
+     * @brief Apply socket options and create the epoll set required by the idle strategy.
+     */
+    void setup_idle_strategy();
+
+    /**
+     * @brief Wait according to the idle strategy after an empty receive.
+     * @param empty_polls Consecutive empty receives so far (reset by the caller on data).
+     */
+    void idle_wait(uint32_t empty_polls);
+
+#ifdef __linux__
+    /**
+     * @brief Control messages of interest attached to one received datagram.
+     */
+    struct ControlData {
+        uint64_t timestamp_ns = 0; ///< SCM_TIMESTAMPNS (CLOCK_REALTIME ns), 0 if absent
+        uint32_t drop_count = 0;   ///< SO_RXQ_OVFL: socket drops so far (absent = none yet)
+    };
+
+    /**
+     * @brief Extract the SCM_TIMESTAMPNS and SO_RXQ_OVFL control messages from a received header.
+     */
+    static ControlData parse_control(const msghdr &header);
+
+    /**
+     * @brief Turn a cumulative SO_RXQ_OVFL count into drops since the previous datagram and record them.
+     */
+    uint32_t account_kernel_drops(uint32_t drop_count);
+
+    /**
+     * @brief Read (and reset) the packet ring's drop statistics into ring_pending_drops_.
+     */
+    void collect_ring_drops();
+
+    /// Control-message space per batch slot.
+    static constexpr size_t kControlBytes = 128;
+
+    /// Control-message space reserved in front of each io_uring payload.
+    static constexpr size_t kUringControlBytes = 64;
+
+    /// TPACKET_V3 frame size hint (blocks hold variable-size frames; the kernel only checks the geometry).
+    static constexpr uint32_t kRingFrameSize = 2048;
+
+    /**
+     * @brief Check one ring frame against the port/address filter and copy its UDP payload into the slot.
+     * @return true if the slot now holds a datagram.
+     */
+    bool accept_ring_frame(const tpacket3_hdr *frame, Packet &slot) const;
+#endif
+
     int socket_fd_{-1};
+    int epoll_fd_{-1};
+    int membership_fd_{-1}; ///< PacketMmap: unbound UDP socket holding the multicast membership
+    int granted_recv_buffer_bytes_{0};
     std::atomic<bool> running_{false};
     std::thread receiver_thread_;
     Config config_;
+    equix_md::PacketBufferPool &pool_;
+    bool pool_exhausted_logged_{false};
+    bool pool_starved_{false}; ///< Last refill found no free buffer
+
+    equix_md::ReceiveCounters counters_;
+    uint32_t last_drop_count_ = 0; ///< Last SO_RXQ_OVFL value seen
+    uint64_t last_data_read_ns_ = 0; ///< Monotonic time the last data-bearing read returned, 0 after an empty read
+
+    // batch_size slots, each holding a pool buffer between receive calls.
+    std::vector<Packet> batch_packets_;
+#ifdef __linux__
+    std::vector<struct mmsghdr> batch_headers_;
+    std::vector<struct iovec> batch_iovecs_;
+    std::vector<char> batch_control_; ///< kControlBytes of cmsg space per slot
+
+    // TPACKET_V3 ring state (PacketMmap), owned by the receive thread.
+    uint8_t *ring_ = nullptr;
+    size_t ring_bytes_ = 0;
+    uint32_t ring_block_ = 0; ///< Block the reader is on
+    bool ring_block_open_ = false; ///< ring_block_ is owned by user space and partly consumed
+    uint32_t ring_frames_left_ = 0;
+    const uint8_t *ring_next_frame_ = nullptr;
+    uint32_t ring_dst_ip_ = 0; ///< Required destination address (network order), INADDR_ANY = any
+    uint32_t ring_pending_drops_ = 0; ///< Ring drops not yet attached to a delivered packet
+
+    // io_uring state (IoUring), owned by the receive thread after construction.
+    std::unique_ptr<equix_md::IoUring> uring_;
+    io_uring_buf_ring *uring_buffers_ = nullptr;
+    size_t uring_buffers_bytes_ = 0;
+    uint16_t uring_tail_ = 0; ///< Next provided-buffer ring slot to fill
+    bool uring_armed_ = false; ///< Multishot recvmsg still posting completions
+    bool uring_exhausted_logged_ = false;
+    std::vector<equix_md::PacketRef> uring_slots_; ///< Pool buffer lent to the kernel, by buffer id
+    std::vector<uint16_t> uring_pending_bids_; ///< Buffer ids delivered and waiting for a fresh pool buffer
+    msghdr uring_msg_{}; ///< recvmsg template: only name/control lengths matter
+#endif
 };
 
 #endif // UDP_RECEIVER_HPP_
@@ -0,0 +1,103 @@
+/**
+ * @file    UdpReceiverGroup.hpp
+ * @brief   Serves many UdpReceivers from one receive thread.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: UdpReceiverGroup.hpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   A full feed is 30+ units, one port each. Rather than one thread per
+ *   receiver, a group owns a single (optionally pinned) thread that waits on
+ *   all member sockets with one epoll set, or busy-polls them round-robin.
+ *   Quiet units can share a group while hot units get a group (and core) of
+ *   their own. Members are ordinary UdpReceivers that are never start()ed;
+ *   the group drives them through UdpReceiver::poll().
+ */
+
+#ifndef UDP_RECEIVER_GROUP_HPP_
+#define UDP_RECEIVER_GROUP_HPP_
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "UdpReceiver.hpp"
+
+class UdpReceiverGroup {
+public:
+    struct Config {
+        std::string name;
+        int cpu_affinity_core = -1; ///< -1 means no affinity
+        int thread_realtime_priority = 0; ///< 0 = normal priority
+        /// Epoll waits on every member at once; the spinning strategies poll members round-robin.
+        UdpReceiver::IdleStrategy idle_strategy = UdpReceiver::IdleStrategy::Epoll;
+        uint32_t idle_spin_count = 10000; ///< SpinYield: empty rounds before yielding
+        int epoll_timeout_ms = 100; ///< Epoll: max wait before re-checking for shutdown
+        uint32_t max_batches_per_wakeup = 16; ///< Epoll: batches drained from one ready member before moving on
+    };
+
+    /**
+     * @brief Group counters, written only by the group thread.
+     */
+    struct Stats {
+        uint64_t wakeups = 0;    ///< epoll_wait returns with ready members, or polling rounds with data
+        uint64_t idle_waits = 0; ///< epoll_wait calls, or empty polling rounds
+    };
+
+    explicit UdpReceiverGroup(const Config &config);
+
+    ~UdpReceiverGroup();
+
+    UdpReceiverGroup(const UdpReceiverGroup &) = delete;
+    UdpReceiverGroup &operator=(const UdpReceiverGroup &) = delete;
+
+    /**
+     * @brief Add a receiver (not started) and the callback for its batches. Call before start().
+     * @param receiver Must outlive the group's thread (stop the group before the receiver).
+     */
+    void add(UdpReceiver &receiver, UdpReceiver::BatchPacketCallback callback);
+
+    /**
+     * @brief Launch the group thread.
+     * @throws std::runtime_error if the epoll set cannot be created.
+     */
+    void start();
+
+    void stop();
+
+    Stats stats() const;
+
+    const Config &config() const { return config_; }
+
+    size_t size() const { return members_.size(); }
+
+private:
+    struct Member {
+        UdpReceiver *receiver;
+        UdpReceiver::BatchPacketCallback callback;
+    };
+
+    void run_epoll();
+
+    void run_polling();
+
+    /// Single-writer counter: only the group thread stores, readers load relaxed.
+    static void bump(std::atomic<uint64_t> &counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    Config config_;
+    std::vector<Member> members_;
+    int epoll_fd_{-1};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    std::atomic<uint64_t> wakeups_{0};
+    std::atomic<uint64_t> idle_waits_{0};
+};
+
+#endif // UDP_RECEIVER_GROUP_HPP_
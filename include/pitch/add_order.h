@@ -7,13 +7,14 @@
 #include <sstream>
 #include <vector>
 #include "message.h"
+#include "message_layout.h"
 #include "SymbolIdentifier.hpp"
 
 namespace CboePitch {
-    class AddOrder : public Message {
+    class AddOrder final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x37;
-        static constexpr size_t MESSAGE_SIZE = 42;
+        static constexpr uint8_t MESSAGE_TYPE = AddOrderLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = AddOrderLayout::SIZE;
 
         static AddOrder parse(const uint8_t *data, size_t size, equix_md::SymbolIdentifier& symbol_map, size_t offset = 0) {
             // std::cout << "Size: " << size << " Offset: " << offset << std::endl;
@@ -22,17 +23,14 @@ namespace CboePitch {
             }
 
             // Parse fields
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            uint64_t orderId = Message::readUint64LE(data + offset + 10);
-            char side = static_cast<char>(data[offset + 18]);
-            uint32_t quantity = Message::readUint32LE(data + offset + 19);
-            std::string symbol = Message::readAscii(data + offset + 23, 6);
-            std::string participantId = Message::readAscii(data + offset + 37, 4);
-            const double price = Message::decodePrice(data + offset + 29);
-
-            // Trim trailing spaces for symbol and participantId
-            symbol = Message::trimRight(symbol);
-            participantId = Message::trimRight(participantId);
+            const LayoutView<AddOrderLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<AddOrderLayout::TIMESTAMP>();
+            uint64_t orderId = wire.get<AddOrderLayout::ORDER_ID>();
+            char side = wire.get<AddOrderLayout::SIDE>();
+            uint32_t quantity = wire.get<AddOrderLayout::QUANTITY>();
+            const equix_md::Symbol symbol = wire.get<AddOrderLayout::SYMBOL>();
+            const Price price = wire.get<AddOrderLayout::PRICE>();
+            std::string participantId(wire.get<AddOrderLayout::PARTICIPANT_ID>()); // Right padding dropped
 
             // Add mapping to SymbolIdentifier
             if (!symbol_map.add_mapping(orderId, symbol)) {
@@ -63,28 +61,27 @@ namespace CboePitch {
         size_t getMessageSize() const override { return MESSAGE_SIZE; }
         uint8_t getMessageType() const override { return MESSAGE_TYPE; }
         uint64_t getOrderId() const override { return orderId; }
-        const std::string &getSymbol() const override { return symbol; } // Use stored symbol
+        equix_md::Symbol getSymbol() const override { return symbol; } // Use stored symbol
 
         // Getters
         uint64_t getTimestamp() const { return timestamp; }
         char getSide() const { return sideIndicator; }
         uint32_t getQuantity() const { return quantity; }
-        double getPrice() const { return price; }
+        Price getPrice() const { return price; }
         std::string getParticipantId() const { return participantId; }
-        const std::vector<uint8_t> &getPayload() const { return payload; }
 
     private:
         uint64_t timestamp;
         uint64_t orderId;
         char sideIndicator;
         uint32_t quantity;
-        std::string symbol; // Store symbol locally for AddOrder
-        double price;
+        equix_md::Symbol symbol; // Store symbol locally for AddOrder
+        Price price;
         std::string participantId;
 
         AddOrder(uint64_t ts, uint64_t ordId, char side, uint32_t qty,
-                 const std::string &sym, double prc, const std::string &pid)
-            : timestamp(ts), orderId(ordId), sideIndicator(side),
+                 equix_md::Symbol sym, Price prc, const std::string &pid)
+            : Message(MESSAGE_TYPE), timestamp(ts), orderId(ordId), sideIndicator(side),
               quantity(qty), symbol(sym), price(prc), participantId(pid) {}
     };
 } // namespace CboePitch
@@ -2,61 +2,61 @@
 #define AUCTION_SUMMARY_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <stdexcept>
 #include <cstring>
 
 namespace CboePitch {
-    class AuctionSummary : public Message {
+    class AuctionSummary final : public Message {
     public:
         static AuctionSummary parse(const uint8_t *data, size_t length, size_t offset = 0) {
             if (length < MESSAGE_SIZE) {
                 throw std::invalid_argument("AuctionSummary message too short");
             }
 
-            uint64_t timestamp = readUint64LE(data + offset + 2);
-            std::string symbol(reinterpret_cast<const char *>(data + offset + 10), 6);
-            symbol = symbol.substr(0, symbol.find_last_not_of(' ') + 1); // trim right padding
-            char auctionType = static_cast<char>(data[offset + 16]);
-
-            double price = decodePrice(data + offset + 17, 7);
-            uint32_t shares = readUint32LE(data + offset + 25);
+            const LayoutView<AuctionSummaryLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<AuctionSummaryLayout::TIMESTAMP>();
+            const equix_md::Symbol symbol = wire.get<AuctionSummaryLayout::SYMBOL>(); // Drops right padding
+            char auctionType = wire.get<AuctionSummaryLayout::AUCTION_TYPE>();
+            Price price = wire.get<AuctionSummaryLayout::PRICE>();
+            uint32_t shares = wire.get<AuctionSummaryLayout::SHARES>();
 
             AuctionSummary auction_summary(timestamp, symbol, auctionType, price, shares);
-            auction_summary.payload.assign(data + offset, data + offset + MESSAGE_SIZE);
+            auction_summary.setPayload(data + offset, MESSAGE_SIZE);
             return auction_summary;
         }
 
         std::string toString() const override {
             return "AuctionSummary{timestamp=" + std::to_string(timestamp) +
-                   ", symbol=" + symbol +
+                   ", symbol=" + symbol.to_string() +
                    ", auctionType=" + std::string(1, auctionType) +
-                   ", clearingPrice=" + std::to_string(clearingPrice) +
+                   ", clearingPrice=" + clearingPrice.toString() +
                    ", executedQuantity=" + std::to_string(executedQuantity) + "}";
         }
 
-        static constexpr size_t MESSAGE_SIZE = 30;
-        static constexpr uint8_t MESSAGE_TYPE = 0x5A;
+        static constexpr size_t MESSAGE_SIZE = AuctionSummaryLayout::SIZE;
+        static constexpr uint8_t MESSAGE_TYPE = AuctionSummaryLayout::TYPE;
 
         size_t getMessageSize() const override { return MESSAGE_SIZE; }
         uint8_t getMessageType() const override { return MESSAGE_TYPE; }
 
         uint64_t getTimestamp() const { return timestamp; }
-        const std::string &getSymbol() const override { return symbol; }
+        equix_md::Symbol getSymbol() const override { return symbol; }
         char getAuctionType() const { return auctionType; }
-        double getClearingPrice() const { return clearingPrice; }
+        Price getClearingPrice() const { return clearingPrice; }
         uint32_t getExecutedQuantity() const { return executedQuantity; }
 
     private:
         uint64_t timestamp;
-        std::string symbol;
+        equix_md::Symbol symbol;
         char auctionType;
-        double clearingPrice;
+        Price clearingPrice;
         uint32_t executedQuantity;
 
-        AuctionSummary(uint64_t ts, const std::string &sym, char auctType,
-                       double price, uint32_t qty)
-            : timestamp(ts), symbol(sym), auctionType(auctType),
+        AuctionSummary(uint64_t ts, equix_md::Symbol sym, char auctType,
+                       Price price, uint32_t qty)
+            : Message(MESSAGE_TYPE), timestamp(ts), symbol(sym), auctionType(auctType),
               clearingPrice(price), executedQuantity(qty) {
         }
     };
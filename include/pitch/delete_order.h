@@ -2,23 +2,25 @@
 #define DELETE_ORDER_H
 
 #include "message.h"
+#include "message_layout.h"
 #include "SymbolIdentifier.hpp"
 #include <stdexcept>
 #include <sstream>
 
 namespace CboePitch {
-    class DeleteOrder : public Message {
+    class DeleteOrder final : public Message {
     public:
-        static constexpr size_t MESSAGE_SIZE = 18;
-        static constexpr uint8_t MESSAGE_TYPE = 0x3C;
+        static constexpr size_t MESSAGE_SIZE = DeleteOrderLayout::SIZE;
+        static constexpr uint8_t MESSAGE_TYPE = DeleteOrderLayout::TYPE;
 
         static DeleteOrder parse(const uint8_t *data, size_t size, equix_md::SymbolIdentifier& symbol_map, size_t offset = 0) {
             if (size < MESSAGE_SIZE) {
                 throw std::invalid_argument("DeleteOrder message too short");
             }
 
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            uint64_t orderId = Message::readUint64LE(data + offset + 10);
+            const LayoutView<DeleteOrderLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<DeleteOrderLayout::TIMESTAMP>();
+            uint64_t orderId = wire.get<DeleteOrderLayout::ORDER_ID>();
 
             DeleteOrder delete_order(timestamp, orderId);
             delete_order.setSymbolMap(&symbol_map);
@@ -51,7 +53,7 @@ namespace CboePitch {
         uint64_t orderId;
 
         DeleteOrder(uint64_t ts, uint64_t ordId)
-            : timestamp(ts), orderId(ordId) {}
+            : Message(MESSAGE_TYPE), timestamp(ts), orderId(ordId) {}
     };
 } // namespace CboePitch
 
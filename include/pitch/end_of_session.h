@@ -2,14 +2,15 @@
 #define END_OF_SESSION_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <stdexcept>
 
 namespace CboePitch {
-    class EndOfSession : public Message {
+    class EndOfSession final : public Message {
     public:
-        static constexpr size_t MESSAGE_SIZE = 6;
-        static constexpr uint8_t MESSAGE_TYPE = 0x2D;
+        static constexpr size_t MESSAGE_SIZE = EndOfSessionLayout::SIZE;
+        static constexpr uint8_t MESSAGE_TYPE = EndOfSessionLayout::TYPE;
 
         static EndOfSession parse(const uint8_t *data, size_t length, size_t offset = 0) {
             if (length < MESSAGE_SIZE) {
@@ -27,7 +28,7 @@ namespace CboePitch {
         uint8_t getMessageType() const override { return MESSAGE_TYPE; }
 
     private:
-        EndOfSession() = default;
+        EndOfSession() : Message(MESSAGE_TYPE) {}
     };
 } // namespace CboePitch
 
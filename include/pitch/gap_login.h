@@ -2,38 +2,49 @@
 #define GAP_LOGIN_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <stdexcept>
 
 namespace CboePitch {
+    // First message of a Gap Request Proxy session; answered by a LoginResponse
     class GapLogin : public Message {
     public:
+        static constexpr uint8_t MESSAGE_TYPE = GapLoginLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = GapLoginLayout::SIZE;
+
         static GapLogin parse(const uint8_t* data, size_t size) {
-            if (size < 14) throw std::invalid_argument("GapLogin too short");
-            std::string subId(reinterpret_cast<const char*>(&data[1]), 4);
-            std::string user(reinterpret_cast<const char*>(&data[5]), 4);
-            char fill = data[9];
-            std::string pass(reinterpret_cast<const char*>(&data[10]), 4);
-            return GapLogin(subId, user, fill, pass);
+            if (size < MESSAGE_SIZE) throw std::invalid_argument("GapLogin too short");
+            const LayoutView<GapLoginLayout> wire(data);
+            return GapLogin(std::string(wire.get<GapLoginLayout::SESSION_SUB_ID>()),
+                            std::string(wire.get<GapLoginLayout::USERNAME>()),
+                            std::string(wire.get<GapLoginLayout::PASSWORD>()));
+        }
+
+        // Length and type bytes included; returns MESSAGE_SIZE
+        static size_t encode(uint8_t* out, const std::string& subId, const std::string& user, const std::string& pass) {
+            return CboePitch::encode<GapLoginLayout>(out, subId, user, "", pass);
         }
 
         std::string toString() const override {
-            return "GapLogin{sessionSubId=" + sessionSubId + ", username=" + username +
-                   ", filler=" + filler + ", password=" + password + "}";
+            return "GapLogin{sessionSubId=" + sessionSubId + ", username=" + username + ", password=***}";
         }
 
-        size_t getMessageSize() const override { return 14; }
-        uint8_t getMessageType() const override { return 0x01; }
+        size_t getMessageSize() const override { return MESSAGE_SIZE; }
+        uint8_t getMessageType() const override { return MESSAGE_TYPE; }
+
+        const std::string& getSessionSubId() const { return sessionSubId; }
+        const std::string& getUsername() const { return username; }
+        const std::string& getPassword() const { return password; }
 
     private:
         std::string sessionSubId;
         std::string username;
-        char filler;
         std::string password;
 
-        GapLogin(const std::string& subId, const std::string& user, char fill, const std::string& pass)
-            : sessionSubId(subId), username(user), filler(fill), password(pass) {}
+        GapLogin(const std::string& subId, const std::string& user, const std::string& pass)
+            : sessionSubId(subId), username(user), password(pass) {}
     };
 } // namespace CboePitch
 
-#endif // GAP_LOGIN_H
\ No newline at end of file
+#endif // GAP_LOGIN_H
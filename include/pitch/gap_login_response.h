@@ -2,23 +2,39 @@
 #define GAP_LOGIN_RESPONSE_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <stdexcept>
 
 namespace CboePitch {
     class LoginResponse : public Message {
     public:
+        static constexpr uint8_t MESSAGE_TYPE = LoginResponseLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = LoginResponseLayout::SIZE;
+
+        // Status codes
+        static constexpr char ACCEPTED = 'A';
+        static constexpr char NOT_AUTHORIZED = 'N';
+        static constexpr char SESSION_IN_USE = 'B';
+        static constexpr char INVALID_SESSION = 'S';
+
         static LoginResponse parse(const uint8_t* data, size_t size) {
-            if (size < 1) throw std::invalid_argument("LoginResponse too short");
-            char stat = data[0];
-            return LoginResponse(stat);
+            if (size < MESSAGE_SIZE) throw std::invalid_argument("LoginResponse too short");
+            return LoginResponse(LayoutView<LoginResponseLayout>(data).get<LoginResponseLayout::STATUS>());
+        }
+
+        static size_t encode(uint8_t* out, char status) {
+            return CboePitch::encode<LoginResponseLayout>(out, status);
         }
 
         std::string toString() const override {
             return "LoginResponse{status=" + std::string(1, status) + "}";
         }
 
-        size_t getMessageSize() const override { return 1; }
-        uint8_t getMessageType() const override { return 0x02; }
+        size_t getMessageSize() const override { return MESSAGE_SIZE; }
+        uint8_t getMessageType() const override { return MESSAGE_TYPE; }
+
+        char getStatus() const { return status; }
+        bool isAccepted() const { return status == ACCEPTED; }
 
     private:
         char status;
@@ -27,4 +43,4 @@ namespace CboePitch {
     };
 } // namespace CboePitch
 
-#endif // GAP_LOGIN_RESPONSE_H
\ No newline at end of file
+#endif // GAP_LOGIN_RESPONSE_H
@@ -6,13 +6,35 @@
 #define GAP_REQUEST_H
 
 #include "message.h"
+#include "message_layout.h"
+#include <stdexcept>
+#include <string>
 
 namespace CboePitch {
+    // Asks the Gap Request Proxy to replay count messages of a unit, from sequence on
     class GapRequest final : public Message {
     public:
-        static GapRequest parse(const uint8_t *data, size_t length);
+        static constexpr uint8_t MESSAGE_TYPE = GapRequestLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = GapRequestLayout::SIZE;
+
+        static GapRequest parse(const uint8_t *data, size_t length) {
+            if (length < MESSAGE_SIZE) throw std::invalid_argument("GapRequest too short");
+            const LayoutView<GapRequestLayout> wire(data);
+            return GapRequest(wire.get<GapRequestLayout::UNIT>(), wire.get<GapRequestLayout::SEQUENCE>(),
+                              wire.get<GapRequestLayout::COUNT>());
+        }
+
+        static size_t encode(uint8_t *out, uint8_t unit, uint32_t sequence, uint16_t count) {
+            return CboePitch::encode<GapRequestLayout>(out, unit, sequence, count);
+        }
+
+        std::string toString() const override {
+            return "GapRequest{unit=" + std::to_string(unit) + ", sequence=" + std::to_string(sequence) +
+                   ", count=" + std::to_string(count) + "}";
+        }
 
-        std::string toString() const override;
+        size_t getMessageSize() const override { return MESSAGE_SIZE; }
+        uint8_t getMessageType() const override { return MESSAGE_TYPE; }
 
         uint8_t getUnit() const { return unit; }
         uint32_t getSequence() const { return sequence; }
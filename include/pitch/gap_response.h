@@ -6,18 +6,53 @@
 #define GAP_RESPONSE_H
 
 #include "message.h"
+#include "message_layout.h"
+#include <stdexcept>
+#include <string>
 
 namespace CboePitch {
+    // Answer to one GapRequest; an accepted request is followed by the replayed messages
     class GapResponse final : public Message {
     public:
-        static GapResponse parse(const uint8_t *data, size_t length);
+        static constexpr uint8_t MESSAGE_TYPE = GapResponseLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = GapResponseLayout::SIZE;
 
-        std::string toString() const override;
+        // Status codes
+        static constexpr char ACCEPTED = 'A';
+        static constexpr char OUT_OF_RANGE = 'O';
+        static constexpr char DAILY_QUOTA = 'D';
+        static constexpr char MINUTE_QUOTA = 'M';
+        static constexpr char SECOND_QUOTA = 'S';
+        static constexpr char COUNT_LIMIT = 'C';
+        static constexpr char INVALID_UNIT = 'I';
+        static constexpr char UNIT_UNAVAILABLE = 'U';
+
+        static GapResponse parse(const uint8_t *data, size_t length) {
+            if (length < MESSAGE_SIZE) throw std::invalid_argument("GapResponse too short");
+            const LayoutView<GapResponseLayout> wire(data);
+            return GapResponse(wire.get<GapResponseLayout::UNIT>(), wire.get<GapResponseLayout::SEQUENCE>(),
+                               wire.get<GapResponseLayout::COUNT>(), wire.get<GapResponseLayout::STATUS>());
+        }
+
+        static size_t encode(uint8_t *out, uint8_t unit, uint32_t sequence, uint16_t count, char status) {
+            return CboePitch::encode<GapResponseLayout>(out, unit, sequence, count, status);
+        }
+
+        std::string toString() const override {
+            return "GapResponse{unit=" + std::to_string(unit) + ", sequence=" + std::to_string(sequence) +
+                   ", count=" + std::to_string(count) + ", status=" + std::string(1, status) + "}";
+        }
+
+        size_t getMessageSize() const override { return MESSAGE_SIZE; }
+        uint8_t getMessageType() const override { return MESSAGE_TYPE; }
 
         uint8_t getUnit() const { return unit; }
         uint32_t getSequence() const { return sequence; }
         uint16_t getCount() const { return count; }
         char getStatus() const { return status; }
+        bool isAccepted() const { return status == ACCEPTED; }
+        // Quota rejections clear up by themselves; the request may be sent again later
+        bool isRetryable() const { return status == SECOND_QUOTA || status == MINUTE_QUOTA || status == UNIT_UNAVAILABLE; }
 
     private:
         uint8_t unit;
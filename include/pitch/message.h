@@ -2,30 +2,67 @@
 #define MESSAGE_H
 
 #include <string>
-#include <cmath>
 #include <stdexcept>
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include "price.h"
+#include "Symbol.hpp"
 #include "SymbolIdentifier.hpp"
+#include "PacketBufferPool.hpp"
 
 namespace CboePitch {
+    // Non-owning view of a message's raw bytes inside the datagram it was parsed from
+    class Payload {
+    public:
+        Payload() = default;
+
+        Payload(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+        const uint8_t *data() const { return data_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const uint8_t *begin() const { return data_; }
+        const uint8_t *end() const { return data_ + size_; }
+        uint8_t operator[](size_t i) const { return data_[i]; }
+
+    private:
+        const uint8_t *data_ = nullptr;
+        size_t size_ = 0;
+    };
+
     class Message {
     public:
+        Message() = default;
+
+        // Messages of the closed PITCH set record their type so visitMessage() can dispatch without the vtable
+        explicit Message(uint16_t typeTag) : typeTag_(typeTag) {}
+
+        // Explicitly defaulted: the virtual destructor would otherwise turn every move into a copy
+        Message(const Message &) = default;
+        Message(Message &&) noexcept = default;
+        Message &operator=(const Message &) = default;
+        Message &operator=(Message &&) noexcept = default;
+
         virtual ~Message() = default;
 
         virtual std::string toString() const = 0;
 
-        virtual const std::string &getSymbol() const {
+        // Packed symbol, returned by value; order-based messages resolve it through the SymbolIdentifier
+        virtual equix_md::Symbol getSymbol() const {
+            return lookupSymbol(getOrderId());
+        }
+
+        // Symbol of a live order, "Unknown" if it is not (or no longer) mapped
+        equix_md::Symbol lookupSymbol(uint64_t orderId) const {
             if (symbol_map_) {
-                auto symbol_opt = symbol_map_->find_symbol(getOrderId());
+                auto symbol_opt = symbol_map_->find_symbol(orderId);
                 if (symbol_opt) {
-                    cached_symbol_ = *symbol_opt;
-                    return cached_symbol_;
+                    return *symbol_opt;
                 }
             }
-            static const std::string empty = "Unknown";
-            return empty;
+            static const equix_md::Symbol unknown("Unknown");
+            return unknown;
         }
 
         virtual size_t getMessageSize() const = 0;
@@ -36,16 +73,42 @@ namespace CboePitch {
             return 0; // Default for messages without orderId
         }
 
+        // Same value as getMessageType() for the PITCH sequenced messages, without a virtual call. Wrappers
+        // such as RawMessage use tags above 0xFF; 0 for messages outside the closed set
+        uint16_t getTypeTag() const {
+            return typeTag_;
+        }
+
         // Set the SymbolIdentifier for symbol lookup
         void setSymbolMap(equix_md::SymbolIdentifier* symbol_map) {
             symbol_map_ = symbol_map;
         }
 
-        // Get the raw message payload
-        const std::vector<uint8_t> &getPayload() const {
+        // Get the raw message payload (a slice of the packet buffer, no copy)
+        const Payload &getPayload() const {
             return payload;
         }
 
+        // Keep the packet buffer the payload points into alive for the lifetime of this message
+        void attachPacket(const equix_md::PacketRef &packet) {
+            packet_ = packet;
+        }
+
+        // Receive time of the datagram this message came from (CLOCK_REALTIME ns, 0 if unknown)
+        uint64_t getReceiveTimestamp() const {
+            return receive_timestamp_ns_;
+        }
+
+        void setReceiveTimestamp(uint64_t timestamp_ns) {
+            receive_timestamp_ns_ = timestamp_ns;
+        }
+
+        // Drop the payload and this message's packet reference; call once the payload has been published
+        void releasePayload() {
+            payload = Payload();
+            packet_.reset();
+        }
+
         // Utility to read Little Endian unsigned integers
         static uint64_t readUintLE(const uint8_t *ptr, size_t length) {
             if (length > 8) {
@@ -116,17 +179,6 @@ namespace CboePitch {
             printPayloadHex();
         }
 
-        // Price decode: raw 8-byte LE uint64_t → double with 7 decimal places
-        static double decodePrice(const uint8_t *ptr, int decimalPlaces = 7) {
-            uint64_t raw = readUint64LE(ptr);
-            return static_cast<double>(raw) / std::pow(10.0, decimalPlaces);
-        }
-
-        // Price encode: double → raw uint64_t with 7 decimal places
-        static uint64_t encodePrice(double price) {
-            return static_cast<uint64_t>(price * 10000000.0 + 0.5); // round to nearest
-        }
-
         static std::string readAscii(const uint8_t *data, size_t length) {
             return std::string(reinterpret_cast<const char *>(data), length);
         }
@@ -137,13 +189,15 @@ namespace CboePitch {
         }
 
     protected:
-        std::vector<uint8_t> payload; // Stores the raw message body
+        Payload payload; // View of the raw message body inside packet_
+        equix_md::PacketRef packet_; // Pooled datagram buffer that owns the payload bytes
+        uint64_t receive_timestamp_ns_ = 0; // Kernel receive time of the datagram, kept after releasePayload()
         equix_md::SymbolIdentifier* symbol_map_ = nullptr; // Pointer to shared SymbolIdentifier
-        mutable std::string cached_symbol_; // Cache for symbol lookup
+        uint16_t typeTag_ = 0; // MESSAGE_TYPE of the concrete class, see getTypeTag()
 
-        // Set the raw message payload during parsing
+        // Set the raw message payload during parsing (records the slice, does not copy)
         void setPayload(const uint8_t *data, size_t length) {
-            payload.assign(data, data + length);
+            payload = Payload(data, length);
         }
     };
 } // namespace CboePitch
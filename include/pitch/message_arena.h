@@ -0,0 +1,176 @@
+#ifndef MESSAGE_ARENA_H
+#define MESSAGE_ARENA_H
+
+#include "message.h"
+#include "message_dispatcher.h"
+#include "message_index.h"
+#include "PacketBufferPool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace CboePitch {
+    class MessageArenaPool;
+
+    // Bump-allocated slab for every message parsed from one datagram.
+    //
+    // open() places a single shared owner (the lease) at the front of the slab; each message is
+    // constructed behind it and handed out as a shared_ptr aliasing the lease. The packet thus
+    // has one refcount and no per-message allocation. When the last message is dropped the
+    // lease destroys the messages, lets go of the packet buffer and returns the slab to its pool.
+    class MessageArena {
+    public:
+        static constexpr size_t CAPACITY = 8192; // Typical datagrams carry well under 60 messages
+
+        MessageArena() = default;
+        MessageArena(const MessageArena &) = delete;
+        MessageArena &operator=(const MessageArena &) = delete;
+
+        // Start a new lease over packet; the returned owner must be kept until all messages are handed out
+        std::shared_ptr<void> open(const equix_md::PacketRef &packet);
+
+        // Parse the message at data + offset into the slab; nullptr if it does not fit
+        Message *emplace(const MessageDispatchInfo &info, const uint8_t *data, size_t size, size_t offset,
+                         equix_md::SymbolIdentifier &symbol_map) {
+            if (count_ == MessageIndex::MAX_MESSAGES) return nullptr;
+            void *where = allocate(info.objectSize, info.objectAlign);
+            if (where == nullptr) return nullptr;
+            Message *message = info.emplace(where, data, size, offset, symbol_map);
+            messages_[count_++] = message;
+            return message;
+        }
+
+        // Construct a message of any type in the slab (e.g. a RawMessage); nullptr if it does not fit
+        template<typename T, typename... Args>
+        Message *construct(Args &&... args) {
+            if (count_ == MessageIndex::MAX_MESSAGES) return nullptr;
+            void *where = allocate(sizeof(T), alignof(T));
+            if (where == nullptr) return nullptr;
+            Message *message = new(where) T(std::forward<Args>(args)...);
+            messages_[count_++] = message;
+            return message;
+        }
+
+    private:
+        friend class MessageArenaPool;
+
+        // Shared owner of everything in the slab
+        struct Lease {
+            MessageArena *arena;
+
+            explicit Lease(MessageArena *a) : arena(a) {}
+            Lease(const Lease &) = delete;
+            Lease &operator=(const Lease &) = delete;
+
+            ~Lease() {
+                for (size_t i = arena->count_; i > 0; --i) arena->messages_[i - 1]->~Message();
+                arena->count_ = 0;
+                arena->packet_.reset();
+            }
+        };
+
+        // Places the lease's control block in the slab; the slab is handed back to the pool only
+        // once the control block is gone (deallocate runs on a copy of the allocator outside it)
+        template<typename T>
+        struct LeaseAllocator {
+            using value_type = T;
+
+            MessageArena *arena;
+
+            explicit LeaseAllocator(MessageArena *a) : arena(a) {}
+
+            template<typename U>
+            LeaseAllocator(const LeaseAllocator<U> &other) : arena(other.arena) {}
+
+            T *allocate(size_t n) {
+                void *where = arena->allocate(n * sizeof(T), alignof(T));
+                if (where == nullptr) throw std::bad_alloc();
+                return static_cast<T *>(where);
+            }
+
+            void deallocate(T *, size_t) { arena->release(); }
+
+            template<typename U>
+            bool operator==(const LeaseAllocator<U> &other) const { return arena == other.arena; }
+
+            template<typename U>
+            bool operator!=(const LeaseAllocator<U> &other) const { return arena != other.arena; }
+        };
+
+        void *allocate(size_t size, size_t align) {
+            const size_t start = (used_ + align - 1) & ~(align - 1);
+            if (size == 0 || start + size > CAPACITY) return nullptr;
+            used_ = start + size;
+            return storage_ + start;
+        }
+
+        void release() {
+            used_ = 0;
+            in_use_.store(false, std::memory_order_release);
+        }
+
+        alignas(64) unsigned char storage_[CAPACITY];
+        size_t used_ = 0;
+        size_t count_ = 0;
+        Message *messages_[MessageIndex::MAX_MESSAGES];
+        equix_md::PacketRef packet_; // Keeps the datagram the payloads point into
+        std::atomic<bool> in_use_{false};
+    };
+
+    inline std::shared_ptr<void> MessageArena::open(const equix_md::PacketRef &packet) {
+        packet_ = packet;
+        return std::allocate_shared<Lease>(LeaseAllocator<Lease>(this), this);
+    }
+
+    // Fixed set of arenas, allocated once. Any thread may acquire; a lease returns its arena from
+    // whichever thread drops the last message. When every probed arena is busy the caller falls back
+    // to one heap allocation per message.
+    class MessageArenaPool {
+    public:
+        static constexpr size_t PROBES = 8; // Arenas come back roughly in order, so the next one is usually free
+
+        explicit MessageArenaPool(size_t arena_count)
+            : arena_count_(arena_count), arenas_(new MessageArena[arena_count]) {
+        }
+
+        MessageArenaPool(const MessageArenaPool &) = delete;
+        MessageArenaPool &operator=(const MessageArenaPool &) = delete;
+
+        MessageArena *acquire() {
+            if (arena_count_ == 0) return nullptr;
+            for (size_t probe = 0; probe < PROBES; ++probe) {
+                MessageArena &arena = arenas_[cursor_.fetch_add(1, std::memory_order_relaxed) % arena_count_];
+                bool expected = false;
+                if (!arena.in_use_.load(std::memory_order_relaxed) &&
+                    arena.in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return &arena;
+                }
+            }
+            exhausted_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        size_t capacity() const { return arena_count_; }
+
+        // Packets parsed with per-message heap allocation because no arena was free
+        uint64_t exhausted() const { return exhausted_.load(std::memory_order_relaxed); }
+
+        // Approximate while messages are in flight
+        size_t inUse() const {
+            size_t busy = 0;
+            for (size_t i = 0; i < arena_count_; ++i) busy += arenas_[i].in_use_.load(std::memory_order_relaxed);
+            return busy;
+        }
+
+    private:
+        size_t arena_count_;
+        std::unique_ptr<MessageArena[]> arenas_;
+        alignas(64) std::atomic<size_t> cursor_{0};
+        alignas(64) std::atomic<uint64_t> exhausted_{0};
+    };
+} // namespace CboePitch
+
+#endif // MESSAGE_ARENA_H
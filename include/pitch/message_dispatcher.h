@@ -17,122 +17,106 @@
 #include "auction_update.h"
 #include "auction_summary.h"
 #include "SymbolIdentifier.hpp"
+#include <array>
 #include <cstdint>
-#include <functional>
-#include <unordered_map>
 #include <memory>
+#include <new>
 
 namespace CboePitch {
+    // Parses one message at data + offset; size counts the bytes available from data
+    using MessageParser = std::shared_ptr<Message> (*)(const uint8_t *data, size_t size, size_t offset,
+                                                       equix_md::SymbolIdentifier &symbol_map);
+
+    // Same as MessageParser, but constructs the message in caller-provided storage (objectSize/objectAlign)
+    using MessageEmplacer = Message *(*)(void *where, const uint8_t *data, size_t size, size_t offset,
+                                         equix_md::SymbolIdentifier &symbol_map);
+
     struct MessageDispatchInfo {
-        size_t length;
-        std::function<std::shared_ptr<Message>(const uint8_t *, size_t, size_t, equix_md::SymbolIdentifier &)> parser;
+        uint8_t length = 0; // Fixed wire length; 0 marks an unknown message type
+        MessageParser parser = nullptr;
+        uint16_t objectSize = 0;
+        uint16_t objectAlign = 0;
+        MessageEmplacer emplace = nullptr;
     };
 
+    // Parsers for messages that resolve or record symbols through the SymbolIdentifier
+    template<typename T>
+    std::shared_ptr<Message> parseOrderMessage(const uint8_t *data, size_t size, size_t offset,
+                                               equix_md::SymbolIdentifier &symbol_map) {
+        return std::make_shared<T>(T::parse(data, size, symbol_map, offset));
+    }
+
+    // Parsers for messages that carry everything they need (symbol included)
+    template<typename T>
+    std::shared_ptr<Message> parsePlainMessage(const uint8_t *data, size_t size, size_t offset,
+                                               equix_md::SymbolIdentifier &) {
+        return std::make_shared<T>(T::parse(data, size, offset));
+    }
+
+    template<typename T>
+    Message *emplaceOrderMessage(void *where, const uint8_t *data, size_t size, size_t offset,
+                                 equix_md::SymbolIdentifier &symbol_map) {
+        return new(where) T(T::parse(data, size, symbol_map, offset));
+    }
+
+    template<typename T>
+    Message *emplacePlainMessage(void *where, const uint8_t *data, size_t size, size_t offset,
+                                 equix_md::SymbolIdentifier &) {
+        return new(where) T(T::parse(data, size, offset));
+    }
+
+    using MessageDispatchTable = std::array<MessageDispatchInfo, 256>;
+
+    namespace detail {
+        template<typename T>
+        constexpr void addOrderMessage(MessageDispatchTable &table) {
+            static_assert(T::MESSAGE_SIZE <= UINT8_MAX, "PITCH message length is one byte");
+            table[T::MESSAGE_TYPE] = {static_cast<uint8_t>(T::MESSAGE_SIZE), &parseOrderMessage<T>,
+                                      sizeof(T), alignof(T), &emplaceOrderMessage<T>};
+        }
+
+        template<typename T>
+        constexpr void addPlainMessage(MessageDispatchTable &table) {
+            static_assert(T::MESSAGE_SIZE <= UINT8_MAX, "PITCH message length is one byte");
+            table[T::MESSAGE_TYPE] = {static_cast<uint8_t>(T::MESSAGE_SIZE), &parsePlainMessage<T>,
+                                      sizeof(T), alignof(T), &emplacePlainMessage<T>};
+        }
+
+        constexpr MessageDispatchTable makeDispatchTable() {
+            MessageDispatchTable table{};
+            addPlainMessage<UnitClear>(table);
+            addPlainMessage<TradingStatus>(table);
+            addOrderMessage<AddOrder>(table);
+            addOrderMessage<OrderExecuted>(table);
+            addOrderMessage<OrderExecutedAtPrice>(table);
+            addOrderMessage<ReduceSize>(table);
+            addOrderMessage<ModifyOrder>(table);
+            addOrderMessage<DeleteOrder>(table);
+            addOrderMessage<Trade>(table);
+            addOrderMessage<TradeBreak>(table);
+            addPlainMessage<CalculatedValue>(table);
+            addPlainMessage<EndOfSession>(table);
+            addPlainMessage<AuctionUpdate>(table);
+            addPlainMessage<AuctionSummary>(table);
+            return table;
+        }
+    } // namespace detail
+
+    // Flat table indexed by the message type byte, built at compile time: one load, no hashing,
+    // no type-erased call
+    inline constexpr MessageDispatchTable kMessageDispatchTable = detail::makeDispatchTable();
+
+    static_assert(kMessageDispatchTable[AddOrder::MESSAGE_TYPE].length == AddOrder::MESSAGE_SIZE);
+    static_assert(kMessageDispatchTable[0x00].parser == nullptr);
+
     class MessageDispatch {
     public:
-        static const std::unordered_map<uint8_t, MessageDispatchInfo> &getDispatchTable() {
-            static const std::unordered_map<uint8_t, MessageDispatchInfo> dispatchTable = {
-                {
-                    0x97, {
-                        6, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<UnitClear>(UnitClear::parse(d, s, o));
-                        }
-                    }
-                },
-                {
-                    0x3B, {
-                        22, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<TradingStatus>(TradingStatus::parse(d, s, o));
-                        }
-                    }
-                },
-                {
-                    0x37, {
-                        42, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<AddOrder>(AddOrder::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0x38, {
-                        43, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<OrderExecuted>(OrderExecuted::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0x58, {
-                        52, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<OrderExecutedAtPrice>(OrderExecutedAtPrice::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0x39, {
-                        22, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<ReduceSize>(ReduceSize::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0x3A, {
-                        31, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<ModifyOrder>(ModifyOrder::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0x3C, {
-                        18, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<DeleteOrder>(DeleteOrder::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0x3D, {
-                        72, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<Trade>(Trade::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0x3E, {
-                        18, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<TradeBreak>(
-                                TradeBreak::parse(d, s, sm, o));
-                        }
-                    }
-                },
-                {
-                    0xE3, {
-                        33, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<CalculatedValue>(CalculatedValue::parse(d, s, o));
-                        }
-                    }
-                },
-                {
-                    0x2D, {
-                        6, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<EndOfSession>(EndOfSession::parse(d, s, o));
-                        }
-                    }
-                },
-                {
-                    0x59, {
-                        34, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<AuctionUpdate>(AuctionUpdate::parse(d, s, o));
-                        }
-                    }
-                },
-                {
-                    0x5A, {
-                        30, [](const uint8_t *d, size_t s, size_t o, equix_md::SymbolIdentifier &sm) {
-                            return std::make_shared<AuctionSummary>(AuctionSummary::parse(d, s, o));
-                        }
-                    }
-                },
-            };
-            return dispatchTable;
+        static constexpr const MessageDispatchTable &getDispatchTable() {
+            return kMessageDispatchTable;
+        }
+
+        static constexpr const MessageDispatchInfo &lookup(uint8_t messageType) {
+            return kMessageDispatchTable[messageType];
         }
     };
 } // namespace CboePitch
@@ -0,0 +1,87 @@
+#ifndef MESSAGE_ENCODER_H
+#define MESSAGE_ENCODER_H
+
+#include "message_layout.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace CboePitch {
+    // Builds sequenced unit datagrams: the 8-byte SeqUnitHeader followed by messages encoded from
+    // their layouts. The header is kept current after every add, so data()/size() are always a
+    // valid packet. reset() starts the next packet, continuing the unit's sequence numbers.
+    //
+    //   SequencedUnitEncoder unit(1);
+    //   unit.add<AddOrderLayout>(ts, orderId, 'B', 100, equix_md::Symbol("ABC"), Price::fromRaw(1250000), "");
+    //   send(unit.data(), unit.size());
+    //   unit.reset();
+    class SequencedUnitEncoder {
+    public:
+        static constexpr size_t HEADER_SIZE = 8;
+        static constexpr size_t MAX_MESSAGES = UINT8_MAX; // Header count is one byte
+        static constexpr size_t CAPACITY = 1500;
+        static constexpr size_t DEFAULT_MAX_SIZE = 1400; // Room for IP/UDP headers inside a 1500-byte MTU
+
+        explicit SequencedUnitEncoder(uint8_t unit, uint32_t sequence = 1, size_t maxSize = DEFAULT_MAX_SIZE)
+            : unit_(unit), sequence_(sequence),
+              maxSize_(maxSize < HEADER_SIZE ? HEADER_SIZE : (maxSize > CAPACITY ? CAPACITY : maxSize)) {
+            writeHeader();
+        }
+
+        // Append one message; false (nothing written) if the packet is full
+        template<typename Layout, typename... Values>
+        bool add(Values &&... values) {
+            if (!fits(Layout::SIZE)) return false;
+            size_ += encode<Layout>(buffer_ + size_, std::forward<Values>(values)...);
+            ++count_;
+            writeHeader();
+            return true;
+        }
+
+        // Append an already encoded message (length byte first)
+        bool addRaw(const uint8_t *message, size_t length) {
+            if (length < 2 || !fits(length)) return false;
+            std::memcpy(buffer_ + size_, message, length);
+            size_ += length;
+            ++count_;
+            writeHeader();
+            return true;
+        }
+
+        bool fits(size_t length) const { return count_ < MAX_MESSAGES && size_ + length <= maxSize_; }
+
+        const uint8_t *data() const { return buffer_; }
+        size_t size() const { return size_; }
+        size_t count() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        uint8_t unit() const { return unit_; }
+        uint32_t sequence() const { return sequence_; } // Of the first message in this packet
+        uint32_t nextSequence() const { return sequence_ + count_; }
+
+        // Start the next packet; an empty packet is a heartbeat carrying the next expected sequence
+        void reset() {
+            sequence_ += static_cast<uint32_t>(count_);
+            count_ = 0;
+            size_ = HEADER_SIZE;
+            writeHeader();
+        }
+
+    private:
+        void writeHeader() {
+            wire::storeLE<uint16_t>(buffer_, static_cast<uint16_t>(size_));
+            buffer_[2] = static_cast<uint8_t>(count_);
+            buffer_[3] = unit_;
+            wire::storeLE<uint32_t>(buffer_ + 4, sequence_);
+        }
+
+        uint8_t buffer_[CAPACITY];
+        uint8_t unit_;
+        uint32_t sequence_;
+        size_t maxSize_;
+        size_t size_ = HEADER_SIZE;
+        size_t count_ = 0;
+    };
+} // namespace CboePitch
+
+#endif // MESSAGE_ENCODER_H
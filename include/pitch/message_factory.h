@@ -3,7 +3,10 @@
 
 #include "message.h"
 #include "seq_unit_header.h"
+#include "message_index.h"
+#include "message_arena.h"
 #include "SymbolIdentifier.hpp"
+#include "PacketBufferPool.hpp"
 #include <memory>
 #include <vector>
 #include <cstdint>
@@ -13,7 +16,26 @@ namespace CboePitch {
     public:
         static std::shared_ptr<Message> parseMessage(const uint8_t *data, size_t size, equix_md::SymbolIdentifier& symbol_map);
         static SeqUnitHeader parseHeader(const uint8_t *data, size_t size);
-        static std::vector<std::shared_ptr<Message>> parseMessages(const uint8_t *data, size_t length, equix_md::SymbolIdentifier& symbol_map);
+        // Message payloads are views into data. Pass the pooled packet that owns data so every
+        // message keeps it alive; without one, data must outlive the returned messages.
+        // With an arena pool, all messages of the datagram share one slab and one refcount
+        // (see MessageArena); messages fall back to one heap allocation each when no arena is free.
+        static std::vector<std::shared_ptr<Message>> parseMessages(const uint8_t *data, size_t length, equix_md::SymbolIdentifier& symbol_map,
+                                                                   const equix_md::PacketRef &packet = equix_md::PacketRef(),
+                                                                   MessageArenaPool *arenas = nullptr);
+        // Parse entries [first, last) of a pre-scanned index. Add/Delete messages update symbol_map, so
+        // ranges of one packet must share it in packet order (or each worker keeps its own map).
+        static std::vector<std::shared_ptr<Message>> parseMessages(const uint8_t *data, const MessageIndex &index,
+                                                                   size_t first, size_t last,
+                                                                   equix_md::SymbolIdentifier& symbol_map,
+                                                                   const equix_md::PacketRef &packet = equix_md::PacketRef(),
+                                                                   MessageArenaPool *arenas = nullptr);
+        // First phase of lazy decoding: one RawMessage per message (type, order id and symbol only, see
+        // raw_message.h), with the same SymbolIdentifier upkeep, packet ownership and arenas as parseMessages
+        static std::vector<std::shared_ptr<Message>> routeMessages(const uint8_t *data, size_t length,
+                                                                   equix_md::SymbolIdentifier& symbol_map,
+                                                                   const equix_md::PacketRef &packet = equix_md::PacketRef(),
+                                                                   MessageArenaPool *arenas = nullptr);
         // static std::vector<std::shared_ptr<Message>> parseMessages(const uint8_t *data, size_t length);
     };
 } // namespace CboePitch
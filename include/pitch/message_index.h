@@ -0,0 +1,91 @@
+#ifndef MESSAGE_INDEX_H
+#define MESSAGE_INDEX_H
+
+#include "message_dispatcher.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace CboePitch {
+    struct MessageIndexEntry {
+        uint16_t offset; // From the start of the datagram
+        uint8_t type;
+        uint8_t length; // Length byte as sent (may exceed the parser's fixed size for newer layouts)
+    };
+
+    // Framing pass over one datagram: walks the per-message length bytes after the sequenced unit
+    // header and records (offset, type) for every message this build can parse. Unknown or newer
+    // message types are stepped over by their length byte instead of ending the packet, so the
+    // parse phase never needs to frame anything itself and can run over the index in any order:
+    // all of it, one type at a time, or split by index range across threads.
+    class MessageIndex {
+    public:
+        static constexpr size_t HEADER_SIZE = 8;
+        static constexpr size_t MAX_MESSAGES = UINT8_MAX; // Header count is one byte
+
+        MessageIndex() = default;
+
+        // Returns false if the packet is shorter than its header says or a message runs past the
+        // end (entries before the fault are kept); true otherwise
+        bool scan(const uint8_t *data, size_t size) {
+            count_ = 0;
+            skipped_ = 0;
+            malformed_ = 0;
+            truncated_ = false;
+            if (size < HEADER_SIZE) {
+                truncated_ = true;
+                return false;
+            }
+            const size_t headerLength = static_cast<size_t>(data[0]) | static_cast<size_t>(data[1]) << 8;
+            const uint8_t headerCount = data[2];
+            if (headerLength > size) truncated_ = true;
+            const size_t end = headerLength < size ? headerLength : size;
+
+            size_t offset = HEADER_SIZE;
+            uint8_t seen = 0;
+            for (; seen < headerCount; ++seen) {
+                if (offset + 2 > end) break;
+                const uint8_t length = data[offset];
+                const uint8_t type = data[offset + 1];
+                if (length < 2 || offset + length > end) break;
+                const MessageDispatchInfo &info = MessageDispatch::lookup(type);
+                if (info.parser == nullptr) {
+                    ++skipped_;
+                } else if (length < info.length) {
+                    ++malformed_; // Known type, too short for its fields: framing still holds
+                } else {
+                    entries_[count_++] = MessageIndexEntry{static_cast<uint16_t>(offset), type, length};
+                }
+                offset += length;
+            }
+            if (seen != headerCount || offset != end) truncated_ = true;
+            return !truncated_;
+        }
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        const MessageIndexEntry &operator[](size_t i) const { return entries_[i]; }
+        const MessageIndexEntry *begin() const { return entries_.data(); }
+        const MessageIndexEntry *end() const { return entries_.data() + count_; }
+
+        size_t skipped() const { return skipped_; }     // Unknown types stepped over
+        size_t malformed() const { return malformed_; } // Known types shorter than their layout
+        bool truncated() const { return truncated_; }   // Framing ended early or did not fill the header length
+
+        // Entries of one message type, in packet order
+        template<typename Fn>
+        void forEachOfType(uint8_t type, Fn &&fn) const {
+            for (size_t i = 0; i < count_; ++i)
+                if (entries_[i].type == type) fn(entries_[i]);
+        }
+
+    private:
+        std::array<MessageIndexEntry, MAX_MESSAGES> entries_;
+        size_t count_ = 0;
+        size_t skipped_ = 0;
+        size_t malformed_ = 0;
+        bool truncated_ = false;
+    };
+} // namespace CboePitch
+
+#endif // MESSAGE_INDEX_H
@@ -0,0 +1,607 @@
+#ifndef MESSAGE_LAYOUT_H
+#define MESSAGE_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "price.h"
+#include "Symbol.hpp"
+
+// Wire layout of every PITCH message, written down once.
+//
+// Each XxxLayout lists its fields as constexpr (name, offset, width, kind) entries. Everything
+// that touches message bytes is generated from those tables: the message classes' parse(), the
+// flyweight views, encode() for tools and synthetic feeds, and the debug text / JSON formatters.
+// A field read is resolved at compile time to one unaligned load at a fixed offset.
+
+namespace CboePitch {
+    namespace wire {
+        template<typename T>
+        inline T loadLE(const uint8_t *p) {
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            if constexpr (sizeof(T) == 2) value = static_cast<T>(__builtin_bswap16(value));
+            if constexpr (sizeof(T) == 4) value = static_cast<T>(__builtin_bswap32(value));
+            if constexpr (sizeof(T) == 8) value = static_cast<T>(__builtin_bswap64(value));
+#endif
+            return value;
+        }
+
+        template<typename T>
+        inline void storeLE(uint8_t *p, T value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            if constexpr (sizeof(T) == 2) value = static_cast<T>(__builtin_bswap16(value));
+            if constexpr (sizeof(T) == 4) value = static_cast<T>(__builtin_bswap32(value));
+            if constexpr (sizeof(T) == 8) value = static_cast<T>(__builtin_bswap64(value));
+#endif
+            std::memcpy(p, &value, sizeof(T));
+        }
+
+        // Space-padded ASCII field without its right padding
+        inline std::string_view asciiField(const uint8_t *p, size_t length) {
+            while (length > 0 && p[length - 1] == ' ') --length;
+            return std::string_view(reinterpret_cast<const char *>(p), length);
+        }
+
+        // Write text left-aligned and space padded (cut off at length)
+        inline void storeAscii(uint8_t *p, size_t length, std::string_view text) {
+            const size_t n = text.size() < length ? text.size() : length;
+            std::memcpy(p, text.data(), n);
+            std::memset(p + n, ' ', length - n);
+        }
+    } // namespace wire
+
+    enum class FieldKind : uint8_t {
+        UInt,   // Little-endian unsigned integer, 1/2/4/8 bytes
+        Char,   // Single ASCII code
+        Alpha,  // Space-padded ASCII text
+        Symbol, // 6-byte space-padded symbol
+        Price,  // 8-byte signed, 7 implied decimals
+    };
+
+    struct FieldDesc {
+        const char *name;
+        uint8_t offset; // From the message's length byte
+        uint8_t width;
+        FieldKind kind;
+    };
+
+    // Value type and wire codec for each (kind, width)
+    template<FieldKind Kind, size_t Width>
+    struct FieldCodec;
+
+    template<typename T>
+    struct UIntCodec {
+        using type = T;
+        static type read(const uint8_t *p) { return wire::loadLE<T>(p); }
+        static void write(uint8_t *p, type value) { wire::storeLE<T>(p, value); }
+    };
+
+    template<> struct FieldCodec<FieldKind::UInt, 1> : UIntCodec<uint8_t> {};
+    template<> struct FieldCodec<FieldKind::UInt, 2> : UIntCodec<uint16_t> {};
+    template<> struct FieldCodec<FieldKind::UInt, 4> : UIntCodec<uint32_t> {};
+    template<> struct FieldCodec<FieldKind::UInt, 8> : UIntCodec<uint64_t> {};
+
+    template<>
+    struct FieldCodec<FieldKind::Char, 1> {
+        using type = char;
+        static type read(const uint8_t *p) { return static_cast<char>(*p); }
+        static void write(uint8_t *p, type value) { *p = static_cast<uint8_t>(value); }
+    };
+
+    template<size_t Width>
+    struct FieldCodec<FieldKind::Alpha, Width> {
+        using type = std::string_view; // Points into the message; trailing spaces dropped
+        static type read(const uint8_t *p) { return wire::asciiField(p, Width); }
+        static void write(uint8_t *p, type value) { wire::storeAscii(p, Width, value); }
+    };
+
+    template<>
+    struct FieldCodec<FieldKind::Symbol, equix_md::Symbol::kWireLength> {
+        using type = equix_md::Symbol;
+        static type read(const uint8_t *p) { return equix_md::Symbol::from_wire(p); }
+
+        static void write(uint8_t *p, type value) {
+            char text[equix_md::Symbol::kMaxLength];
+            wire::storeAscii(p, equix_md::Symbol::kWireLength, std::string_view(text, value.copy_to(text)));
+        }
+    };
+
+    template<>
+    struct FieldCodec<FieldKind::Price, Price::WIRE_SIZE> {
+        using type = Price;
+        static type read(const uint8_t *p) { return Price::fromWire(p); }
+        static void write(uint8_t *p, type value) { value.toWire(p); }
+    };
+
+    template<typename Layout, size_t I>
+    using FieldCodecOf = FieldCodec<Layout::FIELDS[I].kind, Layout::FIELDS[I].width>;
+
+    template<typename Layout, size_t I>
+    using FieldType = typename FieldCodecOf<Layout, I>::type;
+
+    // ---- Layouts (offsets and widths per the Cboe PITCH specification) ----
+
+    struct UnitClearLayout {
+        static constexpr const char *NAME = "UnitClear";
+        static constexpr uint8_t TYPE = 0x97;
+        static constexpr size_t SIZE = 6;
+        enum Field : size_t { RESERVED };
+        static constexpr std::array<FieldDesc, 1> FIELDS{{
+            {"reserved", 2, 4, FieldKind::UInt},
+        }};
+    };
+
+    struct TradingStatusLayout {
+        static constexpr const char *NAME = "TradingStatus";
+        static constexpr uint8_t TYPE = 0x3B;
+        static constexpr size_t SIZE = 22;
+        enum Field : size_t { TIMESTAMP, SYMBOL, TRADING_STATUS, MARKET_ID };
+        static constexpr std::array<FieldDesc, 4> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"symbol", 10, 6, FieldKind::Symbol},
+            {"tradingStatus", 16, 1, FieldKind::Char},
+            {"marketId", 17, 4, FieldKind::Alpha},
+        }};
+    };
+
+    struct AddOrderLayout {
+        static constexpr const char *NAME = "AddOrder";
+        static constexpr uint8_t TYPE = 0x37;
+        static constexpr size_t SIZE = 42;
+        enum Field : size_t { TIMESTAMP, ORDER_ID, SIDE, QUANTITY, SYMBOL, PRICE, PARTICIPANT_ID };
+        static constexpr std::array<FieldDesc, 7> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"orderId", 10, 8, FieldKind::UInt},
+            {"side", 18, 1, FieldKind::Char},
+            {"quantity", 19, 4, FieldKind::UInt},
+            {"symbol", 23, 6, FieldKind::Symbol},
+            {"price", 29, 8, FieldKind::Price},
+            {"participantId", 37, 4, FieldKind::Alpha},
+        }};
+    };
+
+    struct OrderExecutedLayout {
+        static constexpr const char *NAME = "OrderExecuted";
+        static constexpr uint8_t TYPE = 0x38;
+        static constexpr size_t SIZE = 43;
+        enum Field : size_t { TIMESTAMP, ORDER_ID, EXECUTED_QUANTITY, EXECUTION_ID, CONTRA_ORDER_ID, CONTRA_PID };
+        static constexpr std::array<FieldDesc, 6> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"orderId", 10, 8, FieldKind::UInt},
+            {"executedQuantity", 18, 4, FieldKind::UInt},
+            {"executionId", 22, 8, FieldKind::UInt},
+            {"contraOrderId", 30, 8, FieldKind::UInt},
+            {"contraPID", 38, 4, FieldKind::Alpha},
+        }};
+    };
+
+    struct OrderExecutedAtPriceLayout {
+        static constexpr const char *NAME = "OrderExecutedAtPrice";
+        static constexpr uint8_t TYPE = 0x58;
+        static constexpr size_t SIZE = 52;
+        enum Field : size_t {
+            TIMESTAMP, ORDER_ID, EXECUTED_QUANTITY, EXECUTION_ID, CONTRA_ORDER_ID, CONTRA_PID, EXECUTION_TYPE, PRICE
+        };
+        static constexpr std::array<FieldDesc, 8> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"orderId", 10, 8, FieldKind::UInt},
+            {"executedQuantity", 18, 4, FieldKind::UInt},
+            {"executionId", 22, 8, FieldKind::UInt},
+            {"contraOrderId", 30, 8, FieldKind::UInt},
+            {"contraPid", 38, 4, FieldKind::Alpha},
+            {"executionType", 42, 1, FieldKind::Char},
+            {"price", 43, 8, FieldKind::Price},
+        }};
+    };
+
+    struct ReduceSizeLayout {
+        static constexpr const char *NAME = "ReduceSize";
+        static constexpr uint8_t TYPE = 0x39;
+        static constexpr size_t SIZE = 22;
+        enum Field : size_t { TIMESTAMP, ORDER_ID, CANCELLED_QUANTITY };
+        static constexpr std::array<FieldDesc, 3> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"orderId", 10, 8, FieldKind::UInt},
+            {"cancelledQuantity", 18, 4, FieldKind::UInt},
+        }};
+    };
+
+    struct ModifyOrderLayout {
+        static constexpr const char *NAME = "ModifyOrder";
+        static constexpr uint8_t TYPE = 0x3A;
+        static constexpr size_t SIZE = 31;
+        enum Field : size_t { TIMESTAMP, ORDER_ID, QUANTITY, PRICE, FLAGS };
+        static constexpr std::array<FieldDesc, 5> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"orderId", 10, 8, FieldKind::UInt},
+            {"quantity", 18, 4, FieldKind::UInt},
+            {"price", 22, 8, FieldKind::Price},
+            {"flags", 30, 1, FieldKind::UInt},
+        }};
+    };
+
+    struct DeleteOrderLayout {
+        static constexpr const char *NAME = "DeleteOrder";
+        static constexpr uint8_t TYPE = 0x3C;
+        static constexpr size_t SIZE = 18;
+        enum Field : size_t { TIMESTAMP, ORDER_ID };
+        static constexpr std::array<FieldDesc, 2> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"orderId", 10, 8, FieldKind::UInt},
+        }};
+    };
+
+    struct TradeLayout {
+        static constexpr const char *NAME = "Trade";
+        static constexpr uint8_t TYPE = 0x3D;
+        static constexpr size_t SIZE = 72;
+        enum Field : size_t {
+            TIMESTAMP, SYMBOL, QUANTITY, PRICE, EXECUTION_ID, ORDER_ID, CONTRA_ORDER_ID, PID, CONTRA_PID,
+            TRADE_TYPE, TRADE_DESIGNATION, TRADE_REPORT_TYPE, TRADE_TRANSACTION_TIME, FLAGS
+        };
+        static constexpr std::array<FieldDesc, 14> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"symbol", 10, 6, FieldKind::Symbol},
+            {"quantity", 16, 4, FieldKind::UInt},
+            {"price", 20, 8, FieldKind::Price},
+            {"executionId", 28, 8, FieldKind::UInt},
+            {"orderId", 36, 8, FieldKind::UInt},
+            {"contraOrderId", 44, 8, FieldKind::UInt},
+            {"pid", 52, 4, FieldKind::Alpha},
+            {"contraPid", 56, 4, FieldKind::Alpha},
+            {"tradeType", 60, 1, FieldKind::Char},
+            {"tradeDesignation", 61, 1, FieldKind::Char},
+            {"tradeReportType", 62, 1, FieldKind::Char},
+            {"tradeTransactionTime", 63, 8, FieldKind::UInt},
+            {"flags", 71, 1, FieldKind::UInt},
+        }};
+    };
+
+    struct TradeBreakLayout {
+        static constexpr const char *NAME = "TradeBreak";
+        static constexpr uint8_t TYPE = 0x3E;
+        static constexpr size_t SIZE = 18;
+        enum Field : size_t { TIMESTAMP, EXECUTION_ID };
+        static constexpr std::array<FieldDesc, 2> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"executionId", 10, 8, FieldKind::UInt},
+        }};
+    };
+
+    struct CalculatedValueLayout {
+        static constexpr const char *NAME = "CalculatedValue";
+        static constexpr uint8_t TYPE = 0xE3;
+        static constexpr size_t SIZE = 33;
+        enum Field : size_t { TIMESTAMP, SYMBOL, VALUE_CATEGORY, VALUE, VALUE_TIMESTAMP };
+        static constexpr std::array<FieldDesc, 5> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"symbol", 10, 6, FieldKind::Symbol},
+            {"valueCategory", 16, 1, FieldKind::Char},
+            {"value", 17, 8, FieldKind::Price},
+            {"valueTimestamp", 25, 8, FieldKind::UInt},
+        }};
+    };
+
+    struct EndOfSessionLayout {
+        static constexpr const char *NAME = "EndOfSession";
+        static constexpr uint8_t TYPE = 0x2D;
+        static constexpr size_t SIZE = 6;
+        static constexpr std::array<FieldDesc, 0> FIELDS{};
+    };
+
+    struct AuctionUpdateLayout {
+        static constexpr const char *NAME = "AuctionUpdate";
+        static constexpr uint8_t TYPE = 0x59;
+        static constexpr size_t SIZE = 34;
+        enum Field : size_t { TIMESTAMP, SYMBOL, AUCTION_TYPE, BUY_SHARES, SELL_SHARES, INDICATIVE_PRICE };
+        static constexpr std::array<FieldDesc, 6> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"symbol", 10, 6, FieldKind::Symbol},
+            {"auctionType", 16, 1, FieldKind::Char},
+            {"buyShares", 17, 4, FieldKind::UInt},
+            {"sellShares", 21, 4, FieldKind::UInt},
+            {"indicativePrice", 25, 8, FieldKind::Price},
+        }};
+    };
+
+    struct AuctionSummaryLayout {
+        static constexpr const char *NAME = "AuctionSummary";
+        static constexpr uint8_t TYPE = 0x5A;
+        static constexpr size_t SIZE = 30;
+        enum Field : size_t { TIMESTAMP, SYMBOL, AUCTION_TYPE, PRICE, SHARES };
+        static constexpr std::array<FieldDesc, 5> FIELDS{{
+            {"timestamp", 2, 8, FieldKind::UInt},
+            {"symbol", 10, 6, FieldKind::Symbol},
+            {"auctionType", 16, 1, FieldKind::Char},
+            {"price", 17, 8, FieldKind::Price},
+            {"shares", 25, 4, FieldKind::UInt},
+        }};
+    };
+
+    // Every layout, in dispatch-table order
+    using MessageLayouts = std::tuple<UnitClearLayout, TradingStatusLayout, AddOrderLayout, OrderExecutedLayout,
+                                      OrderExecutedAtPriceLayout, ReduceSizeLayout, ModifyOrderLayout,
+                                      DeleteOrderLayout, TradeLayout, TradeBreakLayout, CalculatedValueLayout,
+                                      EndOfSessionLayout, AuctionUpdateLayout, AuctionSummaryLayout>;
+
+    // ---- Gap Request Proxy session (TCP, framed by a SeqUnitHeader with unit 0 and sequence 0) ----
+    // Not part of MessageLayouts: their type codes are only meaningful on the gap session.
+
+    struct GapLoginLayout {
+        static constexpr const char *NAME = "GapLogin";
+        static constexpr uint8_t TYPE = 0x01;
+        static constexpr size_t SIZE = 22;
+        enum Field : size_t { SESSION_SUB_ID, USERNAME, FILLER, PASSWORD };
+        static constexpr std::array<FieldDesc, 4> FIELDS{{
+            {"sessionSubId", 2, 4, FieldKind::Alpha},
+            {"username", 6, 4, FieldKind::Alpha},
+            {"filler", 10, 2, FieldKind::Alpha},
+            {"password", 12, 10, FieldKind::Alpha},
+        }};
+    };
+
+    struct LoginResponseLayout {
+        static constexpr const char *NAME = "LoginResponse";
+        static constexpr uint8_t TYPE = 0x02;
+        static constexpr size_t SIZE = 3;
+        enum Field : size_t { STATUS };
+        static constexpr std::array<FieldDesc, 1> FIELDS{{
+            {"status", 2, 1, FieldKind::Char},
+        }};
+    };
+
+    struct GapRequestLayout {
+        static constexpr const char *NAME = "GapRequest";
+        static constexpr uint8_t TYPE = 0x03;
+        static constexpr size_t SIZE = 9;
+        enum Field : size_t { UNIT, SEQUENCE, COUNT };
+        static constexpr std::array<FieldDesc, 3> FIELDS{{
+            {"unit", 2, 1, FieldKind::UInt},
+            {"sequence", 3, 4, FieldKind::UInt},
+            {"count", 7, 2, FieldKind::UInt},
+        }};
+    };
+
+    struct GapResponseLayout {
+        static constexpr const char *NAME = "GapResponse";
+        static constexpr uint8_t TYPE = 0x04;
+        static constexpr size_t SIZE = 10;
+        enum Field : size_t { UNIT, SEQUENCE, COUNT, STATUS };
+        static constexpr std::array<FieldDesc, 4> FIELDS{{
+            {"unit", 2, 1, FieldKind::UInt},
+            {"sequence", 3, 4, FieldKind::UInt},
+            {"count", 7, 2, FieldKind::UInt},
+            {"status", 9, 1, FieldKind::Char},
+        }};
+    };
+
+    using GapSessionLayouts = std::tuple<GapLoginLayout, LoginResponseLayout, GapRequestLayout, GapResponseLayout>;
+
+    // ---- Compile-time checks ----
+
+    constexpr bool fieldWidthMatchesKind(const FieldDesc &field) {
+        switch (field.kind) {
+            case FieldKind::UInt: return field.width == 1 || field.width == 2 || field.width == 4 || field.width == 8;
+            case FieldKind::Char: return field.width == 1;
+            case FieldKind::Alpha: return field.width > 0;
+            case FieldKind::Symbol: return field.width == equix_md::Symbol::kWireLength;
+            case FieldKind::Price: return field.width == Price::WIRE_SIZE;
+        }
+        return false;
+    }
+
+    // Fields in offset order, after the length/type bytes, not overlapping and inside SIZE
+    template<typename Layout>
+    constexpr bool isValidLayout() {
+        size_t next = 2;
+        for (const FieldDesc &field : Layout::FIELDS) {
+            if (field.offset < next || !fieldWidthMatchesKind(field)) return false;
+            next = static_cast<size_t>(field.offset) + field.width;
+        }
+        return next <= Layout::SIZE && Layout::SIZE <= UINT8_MAX;
+    }
+
+    namespace detail {
+        template<typename... Layouts>
+        constexpr bool allLayoutsValid(std::tuple<Layouts...> *) {
+            return (isValidLayout<Layouts>() && ...);
+        }
+    } // namespace detail
+
+    static_assert(detail::allLayoutsValid(static_cast<MessageLayouts *>(nullptr)), "Inconsistent message layout");
+    static_assert(detail::allLayoutsValid(static_cast<GapSessionLayouts *>(nullptr)), "Inconsistent gap session layout");
+
+    // ---- Generated access ----
+
+    template<typename Layout, size_t I>
+    inline FieldType<Layout, I> readField(const uint8_t *message) {
+        return FieldCodecOf<Layout, I>::read(message + Layout::FIELDS[I].offset);
+    }
+
+    template<typename Layout, size_t I>
+    inline void writeField(uint8_t *message, FieldType<Layout, I> value) {
+        FieldCodecOf<Layout, I>::write(message + Layout::FIELDS[I].offset, value);
+    }
+
+    // Zero-copy access to one message in place: view.get<AddOrderLayout::PRICE>()
+    template<typename Layout>
+    class LayoutView {
+    public:
+        using layout = Layout;
+        static constexpr uint8_t MESSAGE_TYPE = Layout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = Layout::SIZE;
+
+        explicit LayoutView(const uint8_t *data) : data_(data) {}
+
+        template<size_t I>
+        FieldType<Layout, I> get() const { return readField<Layout, I>(data_); }
+
+        const uint8_t *data() const { return data_; }
+        uint8_t getLength() const { return data_[0]; }
+        uint8_t getMessageType() const { return data_[1]; }
+
+    protected:
+        const uint8_t *data_;
+    };
+
+    namespace detail {
+        template<typename Layout, size_t... Is>
+        auto decodeFields(const uint8_t *message, std::index_sequence<Is...>) {
+            return std::make_tuple(readField<Layout, Is>(message)...);
+        }
+
+        template<typename Layout, typename Values, size_t... Is>
+        void encodeFields(uint8_t *message, const Values &values, std::index_sequence<Is...>) {
+            (writeField<Layout, Is>(message, std::get<Is>(values)), ...);
+        }
+
+        template<typename Layout, typename Fn, size_t... Is>
+        void forEachField(const uint8_t *message, Fn &fn, std::index_sequence<Is...>) {
+            (fn(Layout::FIELDS[Is], readField<Layout, Is>(message)), ...);
+        }
+
+        template<typename Layout>
+        using FieldIndices = std::make_index_sequence<Layout::FIELDS.size()>;
+    } // namespace detail
+
+    // All field values as a tuple, in layout order
+    template<typename Layout>
+    using LayoutValues = decltype(detail::decodeFields<Layout>(nullptr, detail::FieldIndices<Layout>{}));
+
+    template<typename Layout>
+    LayoutValues<Layout> decode(const uint8_t *message) {
+        return detail::decodeFields<Layout>(message, detail::FieldIndices<Layout>{});
+    }
+
+    // Write a complete message (length and type bytes included, unlisted bytes zeroed) into
+    // Layout::SIZE bytes at out; returns the bytes written
+    template<typename Layout>
+    size_t encodeValues(uint8_t *out, const LayoutValues<Layout> &values) {
+        std::memset(out, 0, Layout::SIZE);
+        out[0] = static_cast<uint8_t>(Layout::SIZE);
+        out[1] = Layout::TYPE;
+        detail::encodeFields<Layout>(out, values, detail::FieldIndices<Layout>{});
+        return Layout::SIZE;
+    }
+
+    // encode<AddOrderLayout>(out, timestamp, orderId, 'B', quantity, symbol, price, "PID")
+    template<typename Layout, typename... Values>
+    size_t encode(uint8_t *out, Values &&... values) {
+        static_assert(sizeof...(Values) == Layout::FIELDS.size(), "One value per layout field");
+        return encodeValues<Layout>(out, LayoutValues<Layout>(std::forward<Values>(values)...));
+    }
+
+    // fn(const FieldDesc &, value) for every field, in order
+    template<typename Layout, typename Fn>
+    void forEachField(const uint8_t *message, Fn &&fn) {
+        detail::forEachField<Layout>(message, fn, detail::FieldIndices<Layout>{});
+    }
+
+    // Call fn(Layout{}) for the layout of messageType; false if no layout matches
+    template<typename Fn>
+    bool withLayout(uint8_t messageType, Fn &&fn) {
+        return std::apply([&](auto... layouts) {
+            return ((messageType == decltype(layouts)::TYPE ? (fn(layouts), true) : false) || ...);
+        }, MessageLayouts{});
+    }
+
+    // ---- Text and JSON ----
+
+    namespace format {
+        template<typename T>
+        using IfUInt = std::enable_if_t<std::is_unsigned_v<T> && !std::is_same_v<T, char>, int>;
+
+        template<typename T, IfUInt<T> = 0>
+        inline void appendText(std::string &out, T value) { out += std::to_string(static_cast<uint64_t>(value)); }
+
+        inline void appendText(std::string &out, char value) { out.push_back(value); }
+        inline void appendText(std::string &out, std::string_view value) { out.append(value); }
+        inline void appendText(std::string &out, Price value) { value.appendTo(out); }
+
+        inline void appendText(std::string &out, equix_md::Symbol value) {
+            char text[equix_md::Symbol::kMaxLength];
+            out.append(text, value.copy_to(text));
+        }
+
+        inline void appendJsonString(std::string &out, std::string_view value) {
+            static constexpr char HEX[] = "0123456789abcdef";
+            out.push_back('"');
+            for (char c : value) {
+                const auto byte = static_cast<unsigned char>(c);
+                if (c == '"' || c == '\\') {
+                    out.push_back('\\');
+                    out.push_back(c);
+                } else if (byte < 0x20 || byte >= 0x7F) {
+                    out += "\\u00";
+                    out.push_back(HEX[byte >> 4]);
+                    out.push_back(HEX[byte & 0xF]);
+                } else {
+                    out.push_back(c);
+                }
+            }
+            out.push_back('"');
+        }
+
+        template<typename T, IfUInt<T> = 0>
+        inline void appendJson(std::string &out, T value) { out += std::to_string(static_cast<uint64_t>(value)); }
+
+        inline void appendJson(std::string &out, Price value) { value.appendTo(out); } // Exact JSON number
+        inline void appendJson(std::string &out, char value) { appendJsonString(out, std::string_view(&value, 1)); }
+        inline void appendJson(std::string &out, std::string_view value) { appendJsonString(out, value); }
+
+        inline void appendJson(std::string &out, equix_md::Symbol value) {
+            char text[equix_md::Symbol::kMaxLength];
+            appendJsonString(out, std::string_view(text, value.copy_to(text)));
+        }
+    } // namespace format
+
+    // "AddOrder{timestamp=..., orderId=..., ...}", same shape as Message::toString()
+    template<typename Layout>
+    void appendText(std::string &out, const uint8_t *message) {
+        out += Layout::NAME;
+        out.push_back('{');
+        bool first = true;
+        forEachField<Layout>(message, [&](const FieldDesc &field, auto value) {
+            if (!first) out += ", ";
+            first = false;
+            out += field.name;
+            out.push_back('=');
+            format::appendText(out, value);
+        });
+        out.push_back('}');
+    }
+
+    // {"type":"AddOrder","timestamp":...,"price":12.5,"symbol":"ABC",...}
+    template<typename Layout>
+    void appendJson(std::string &out, const uint8_t *message) {
+        out += "{\"type\":\"";
+        out += Layout::NAME;
+        out.push_back('"');
+        forEachField<Layout>(message, [&](const FieldDesc &field, auto value) {
+            out += ",\"";
+            out += field.name;
+            out += "\":";
+            format::appendJson(out, value);
+        });
+        out.push_back('}');
+    }
+
+    // Any known message by its type byte; false (nothing appended) for unknown types
+    inline bool appendMessageText(std::string &out, const uint8_t *message) {
+        return withLayout(message[1], [&](auto layout) { appendText<decltype(layout)>(out, message); });
+    }
+
+    inline bool appendMessageJson(std::string &out, const uint8_t *message) {
+        return withLayout(message[1], [&](auto layout) { appendJson<decltype(layout)>(out, message); });
+    }
+} // namespace CboePitch
+
+#endif // MESSAGE_LAYOUT_H
@@ -0,0 +1,259 @@
+#ifndef MESSAGE_VIEWS_H
+#define MESSAGE_VIEWS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include "message_layout.h"
+
+// Flyweight, allocation-free access to PITCH messages in place.
+//
+// A view is one pointer into the datagram; accessors decode their field on every call, so read
+// each field once if it is used repeatedly. Views do not own or pin the bytes: they are only
+// valid while the packet buffer is (inside a receive callback, or while a PacketRef is held).
+// The Message class hierarchy remains the owning, debug-friendly API.
+
+namespace CboePitch {
+    // Sequenced unit header in front of every packet's messages
+    class SeqUnitHeaderView {
+    public:
+        static constexpr size_t SIZE = 8;
+
+        explicit SeqUnitHeaderView(const uint8_t *data) : data_(data) {}
+
+        uint16_t getLength() const { return wire::loadLE<uint16_t>(data_); }
+        uint8_t getCount() const { return data_[2]; }
+        uint8_t getUnit() const { return data_[3]; }
+        uint32_t getSequence() const { return wire::loadLE<uint32_t>(data_ + 4); }
+
+    private:
+        const uint8_t *data_;
+    };
+
+    // Named getters over the generated field access; offsets and widths live in message_layout.h
+
+    class UnitClearView : public LayoutView<UnitClearLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint32_t getReserved() const { return get<layout::RESERVED>(); }
+    };
+
+    class TradingStatusView : public LayoutView<TradingStatusLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        equix_md::Symbol getSymbol() const { return get<layout::SYMBOL>(); }
+        char getTradingStatus() const { return get<layout::TRADING_STATUS>(); }
+        std::string_view getMarketId() const { return get<layout::MARKET_ID>(); }
+    };
+
+    class AddOrderView : public LayoutView<AddOrderLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        uint64_t getOrderId() const { return get<layout::ORDER_ID>(); }
+        char getSide() const { return get<layout::SIDE>(); }
+        uint32_t getQuantity() const { return get<layout::QUANTITY>(); }
+        equix_md::Symbol getSymbol() const { return get<layout::SYMBOL>(); }
+        Price getPrice() const { return get<layout::PRICE>(); }
+        std::string_view getParticipantId() const { return get<layout::PARTICIPANT_ID>(); }
+    };
+
+    class OrderExecutedView : public LayoutView<OrderExecutedLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        uint64_t getOrderId() const { return get<layout::ORDER_ID>(); }
+        uint32_t getExecutedQuantity() const { return get<layout::EXECUTED_QUANTITY>(); }
+        uint64_t getExecutionId() const { return get<layout::EXECUTION_ID>(); }
+        uint64_t getContraOrderId() const { return get<layout::CONTRA_ORDER_ID>(); }
+        std::string_view getContraPID() const { return get<layout::CONTRA_PID>(); }
+    };
+
+    class OrderExecutedAtPriceView : public LayoutView<OrderExecutedAtPriceLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        uint64_t getOrderId() const { return get<layout::ORDER_ID>(); }
+        uint32_t getExecutedQuantity() const { return get<layout::EXECUTED_QUANTITY>(); }
+        uint64_t getExecutionId() const { return get<layout::EXECUTION_ID>(); }
+        uint64_t getContraOrderId() const { return get<layout::CONTRA_ORDER_ID>(); }
+        std::string_view getContraPid() const { return get<layout::CONTRA_PID>(); }
+        char getExecutionType() const { return get<layout::EXECUTION_TYPE>(); }
+        Price getPrice() const { return get<layout::PRICE>(); }
+    };
+
+    class ReduceSizeView : public LayoutView<ReduceSizeLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        uint64_t getOrderId() const { return get<layout::ORDER_ID>(); }
+        uint32_t getCancelledQuantity() const { return get<layout::CANCELLED_QUANTITY>(); }
+    };
+
+    class ModifyOrderView : public LayoutView<ModifyOrderLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        uint64_t getOrderId() const { return get<layout::ORDER_ID>(); }
+        uint32_t getQuantity() const { return get<layout::QUANTITY>(); }
+        Price getPrice() const { return get<layout::PRICE>(); }
+        uint8_t getFlags() const { return get<layout::FLAGS>(); }
+    };
+
+    class DeleteOrderView : public LayoutView<DeleteOrderLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        uint64_t getOrderId() const { return get<layout::ORDER_ID>(); }
+    };
+
+    class TradeView : public LayoutView<TradeLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        equix_md::Symbol getSymbol() const { return get<layout::SYMBOL>(); }
+        uint32_t getQuantity() const { return get<layout::QUANTITY>(); }
+        Price getPrice() const { return get<layout::PRICE>(); }
+        uint64_t getExecutionId() const { return get<layout::EXECUTION_ID>(); }
+        uint64_t getOrderId() const { return get<layout::ORDER_ID>(); }
+        uint64_t getContraOrderId() const { return get<layout::CONTRA_ORDER_ID>(); }
+        std::string_view getPid() const { return get<layout::PID>(); }
+        std::string_view getContraPid() const { return get<layout::CONTRA_PID>(); }
+        char getTradeType() const { return get<layout::TRADE_TYPE>(); }
+        char getTradeDesignation() const { return get<layout::TRADE_DESIGNATION>(); }
+        char getTradeReportType() const { return get<layout::TRADE_REPORT_TYPE>(); }
+        uint64_t getTradeTransactionTime() const { return get<layout::TRADE_TRANSACTION_TIME>(); }
+        uint8_t getFlags() const { return get<layout::FLAGS>(); }
+    };
+
+    class TradeBreakView : public LayoutView<TradeBreakLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        uint64_t getExecutionId() const { return get<layout::EXECUTION_ID>(); }
+    };
+
+    class CalculatedValueView : public LayoutView<CalculatedValueLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        equix_md::Symbol getSymbol() const { return get<layout::SYMBOL>(); }
+        char getValueCategory() const { return get<layout::VALUE_CATEGORY>(); }
+        Price getValue() const { return get<layout::VALUE>(); }
+        uint64_t getValueTimestamp() const { return get<layout::VALUE_TIMESTAMP>(); }
+    };
+
+    class EndOfSessionView : public LayoutView<EndOfSessionLayout> {
+    public:
+        using LayoutView::LayoutView;
+    };
+
+    class AuctionUpdateView : public LayoutView<AuctionUpdateLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        equix_md::Symbol getSymbol() const { return get<layout::SYMBOL>(); }
+        char getAuctionType() const { return get<layout::AUCTION_TYPE>(); }
+        uint32_t getBuyShares() const { return get<layout::BUY_SHARES>(); }
+        uint32_t getSellShares() const { return get<layout::SELL_SHARES>(); }
+        Price getIndicativePrice() const { return get<layout::INDICATIVE_PRICE>(); }
+    };
+
+    class AuctionSummaryView : public LayoutView<AuctionSummaryLayout> {
+    public:
+        using LayoutView::LayoutView;
+        uint64_t getTimestamp() const { return get<layout::TIMESTAMP>(); }
+        equix_md::Symbol getSymbol() const { return get<layout::SYMBOL>(); }
+        char getAuctionType() const { return get<layout::AUCTION_TYPE>(); }
+        Price getPrice() const { return get<layout::PRICE>(); }
+        uint32_t getShares() const { return get<layout::SHARES>(); }
+    };
+
+    // A message type this build does not decode (length and type bytes only)
+    class UnknownMessageView {
+    public:
+        static constexpr size_t MESSAGE_SIZE = 2;
+
+        explicit UnknownMessageView(const uint8_t *data) : data_(data) {}
+
+        const uint8_t *data() const { return data_; }
+        uint8_t getLength() const { return data_[0]; }
+        uint8_t getMessageType() const { return data_[1]; }
+
+    private:
+        const uint8_t *data_;
+    };
+
+    static_assert(std::is_trivially_copyable_v<AddOrderView> && sizeof(AddOrderView) == sizeof(void *),
+                  "Views are a single pointer");
+
+    // Combine lambdas into one visitor: for_each_message(p, n, Overloaded{[](AddOrderView v) {...}, ...})
+    template<typename... Fs>
+    struct Overloaded : Fs... {
+        using Fs::operator()...;
+    };
+
+    template<typename... Fs>
+    Overloaded(Fs...) -> Overloaded<Fs...>;
+
+    namespace detail {
+        template<typename View, typename Visitor>
+        inline bool visitView(const uint8_t *message, uint8_t length, Visitor &visitor) {
+            if (length < View::MESSAGE_SIZE) return false; // Shorter than the fields we would read
+            visitor(View(message));
+            return true;
+        }
+    } // namespace detail
+
+    // Call visitor(XxxView) for one framed message (length byte first). Unknown types reach the
+    // visitor as UnknownMessageView; false (visitor not called) if the message is shorter than its
+    // type's fields.
+    template<typename Visitor>
+    bool visit_message(const uint8_t *message, Visitor &&visitor) {
+        const uint8_t length = message[0];
+        switch (message[1]) {
+            case UnitClearView::MESSAGE_TYPE: return detail::visitView<UnitClearView>(message, length, visitor);
+            case TradingStatusView::MESSAGE_TYPE: return detail::visitView<TradingStatusView>(message, length, visitor);
+            case AddOrderView::MESSAGE_TYPE: return detail::visitView<AddOrderView>(message, length, visitor);
+            case OrderExecutedView::MESSAGE_TYPE: return detail::visitView<OrderExecutedView>(message, length, visitor);
+            case OrderExecutedAtPriceView::MESSAGE_TYPE: return detail::visitView<OrderExecutedAtPriceView>(message, length, visitor);
+            case ReduceSizeView::MESSAGE_TYPE: return detail::visitView<ReduceSizeView>(message, length, visitor);
+            case ModifyOrderView::MESSAGE_TYPE: return detail::visitView<ModifyOrderView>(message, length, visitor);
+            case DeleteOrderView::MESSAGE_TYPE: return detail::visitView<DeleteOrderView>(message, length, visitor);
+            case TradeView::MESSAGE_TYPE: return detail::visitView<TradeView>(message, length, visitor);
+            case TradeBreakView::MESSAGE_TYPE: return detail::visitView<TradeBreakView>(message, length, visitor);
+            case CalculatedValueView::MESSAGE_TYPE: return detail::visitView<CalculatedValueView>(message, length, visitor);
+            case EndOfSessionView::MESSAGE_TYPE: return detail::visitView<EndOfSessionView>(message, length, visitor);
+            case AuctionUpdateView::MESSAGE_TYPE: return detail::visitView<AuctionUpdateView>(message, length, visitor);
+            case AuctionSummaryView::MESSAGE_TYPE: return detail::visitView<AuctionSummaryView>(message, length, visitor);
+            default: return detail::visitView<UnknownMessageView>(message, length, visitor);
+        }
+    }
+
+    // Call visitor(XxxView) for every message in a packet (SeqUnitHeader + messages), in order.
+    // Messages are framed by their own length byte, so unknown types reach the visitor as
+    // UnknownMessageView and are stepped over. A known type shorter than its fields is skipped
+    // by its length byte (framing still holds, as in MessageIndex::scan). Never allocates or
+    // throws; stops at the first message whose length breaks the framing.
+    // Returns the number of messages visited.
+    template<typename Visitor>
+    size_t for_each_message(const uint8_t *packet, size_t size, Visitor &&visitor) {
+        if (size < SeqUnitHeaderView::SIZE) return 0;
+        const SeqUnitHeaderView header(packet);
+        const size_t end = header.getLength() < size ? header.getLength() : size;
+        size_t offset = SeqUnitHeaderView::SIZE;
+        size_t visited = 0;
+        for (uint8_t i = 0; i < header.getCount() && offset + 2 <= end; ++i) {
+            const uint8_t *message = packet + offset;
+            const uint8_t length = message[0];
+            if (length < 2 || offset + length > end) break;
+            if (visit_message(message, visitor)) ++visited;
+            offset += length;
+        }
+        return visited;
+    }
+} // namespace CboePitch
+
+#endif // MESSAGE_VIEWS_H
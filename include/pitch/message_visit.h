@@ -0,0 +1,100 @@
+#ifndef MESSAGE_VISIT_H
+#define MESSAGE_VISIT_H
+
+#include <cstdint>
+#include <type_traits>
+#include "message.h"
+#include "unit_clear.h"
+#include "trading_status.h"
+#include "add_order.h"
+#include "order_executed.h"
+#include "order_executed_at_price.h"
+#include "reduce_size.h"
+#include "modify_order.h"
+#include "delete_order.h"
+#include "trade.h"
+#include "trade_break.h"
+#include "calculated_value.h"
+#include "end_of_session.h"
+#include "auction_update.h"
+#include "auction_summary.h"
+#include "raw_message.h"
+
+// Static dispatch over the closed set of PITCH sequenced messages.
+//
+// The fourteen message classes are final and record their MESSAGE_TYPE in the Message base, so a
+// Message& can be visited like a variant: one switch on the stored tag, then the visitor is called
+// with the concrete type and every call inside it resolves (and inlines) at compile time. Messages
+// routed but not yet decoded (lazy decoding) arrive as RawMessage; anything else (tag 0) reaches
+// the visitor as the Message base. Overloaded (message_views.h) combines per-type lambdas:
+//
+//   visitMessage(*msgPtr, Overloaded{[](const AddOrder &m) {...}, [](const auto &m) {...}});
+//
+// The virtual API stays for debugging and for code that does not care about the per-message cost.
+
+namespace CboePitch {
+    namespace detail {
+        template<typename T, typename M>
+        using LikeConst = std::conditional_t<std::is_const_v<M>, const T, T>;
+
+        // True if T declares the member itself, false if it inherits Message's
+        template<typename T>
+        constexpr bool ownsGetSymbol = !std::is_same_v<decltype(&T::getSymbol), equix_md::Symbol (Message::*)() const>;
+        template<typename T>
+        constexpr bool ownsGetOrderId = !std::is_same_v<decltype(&T::getOrderId), uint64_t (Message::*)() const>;
+    } // namespace detail
+
+    // Call visitor(concrete message) and return its result; every branch must return the same type
+    template<typename M, typename Visitor,
+             typename = std::enable_if_t<std::is_same_v<std::remove_const_t<M>, Message> > >
+    decltype(auto) visitMessage(M &message, Visitor &&visitor) {
+        using detail::LikeConst;
+        switch (message.getTypeTag()) {
+            case UnitClear::MESSAGE_TYPE: return visitor(static_cast<LikeConst<UnitClear, M> &>(message));
+            case TradingStatus::MESSAGE_TYPE: return visitor(static_cast<LikeConst<TradingStatus, M> &>(message));
+            case AddOrder::MESSAGE_TYPE: return visitor(static_cast<LikeConst<AddOrder, M> &>(message));
+            case OrderExecuted::MESSAGE_TYPE: return visitor(static_cast<LikeConst<OrderExecuted, M> &>(message));
+            case OrderExecutedAtPrice::MESSAGE_TYPE: return visitor(static_cast<LikeConst<OrderExecutedAtPrice, M> &>(message));
+            case ReduceSize::MESSAGE_TYPE: return visitor(static_cast<LikeConst<ReduceSize, M> &>(message));
+            case ModifyOrder::MESSAGE_TYPE: return visitor(static_cast<LikeConst<ModifyOrder, M> &>(message));
+            case DeleteOrder::MESSAGE_TYPE: return visitor(static_cast<LikeConst<DeleteOrder, M> &>(message));
+            case Trade::MESSAGE_TYPE: return visitor(static_cast<LikeConst<Trade, M> &>(message));
+            case TradeBreak::MESSAGE_TYPE: return visitor(static_cast<LikeConst<TradeBreak, M> &>(message));
+            case CalculatedValue::MESSAGE_TYPE: return visitor(static_cast<LikeConst<CalculatedValue, M> &>(message));
+            case EndOfSession::MESSAGE_TYPE: return visitor(static_cast<LikeConst<EndOfSession, M> &>(message));
+            case AuctionUpdate::MESSAGE_TYPE: return visitor(static_cast<LikeConst<AuctionUpdate, M> &>(message));
+            case AuctionSummary::MESSAGE_TYPE: return visitor(static_cast<LikeConst<AuctionSummary, M> &>(message));
+            case RawMessage::TYPE_TAG: return visitor(static_cast<LikeConst<RawMessage, M> &>(message));
+            default: return visitor(message);
+        }
+    }
+
+    // Non-virtual accessors for a concrete message; the Message overloads fall back to the vtable
+    template<typename T>
+    uint64_t orderIdOf(const T &message) {
+        if constexpr (std::is_same_v<T, Message>) return message.getOrderId();
+        else if constexpr (detail::ownsGetOrderId<T>) return message.T::getOrderId();
+        else return 0;
+    }
+
+    template<typename T>
+    equix_md::Symbol symbolOf(const T &message) {
+        if constexpr (std::is_same_v<T, Message>) return message.getSymbol();
+        else if constexpr (detail::ownsGetSymbol<T>) return message.T::getSymbol();
+        else return message.lookupSymbol(orderIdOf(message));
+    }
+
+    template<typename T>
+    uint8_t messageTypeOf(const T &message) {
+        if constexpr (std::is_same_v<T, Message>) return message.getMessageType();
+        else if constexpr (std::is_same_v<T, RawMessage>) return message.RawMessage::getMessageType();
+        else return T::MESSAGE_TYPE;
+    }
+
+    // Routing key of any message: its own symbol, or the symbol of the order it refers to
+    inline equix_md::Symbol routingSymbol(const Message &message) {
+        return visitMessage(message, [](const auto &m) { return symbolOf(m); });
+    }
+} // namespace CboePitch
+
+#endif // MESSAGE_VISIT_H
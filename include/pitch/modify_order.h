@@ -2,26 +2,28 @@
 #define MODIFY_ORDER_H
 
 #include "message.h"
+#include "message_layout.h"
 #include "SymbolIdentifier.hpp"
 #include <string>
 #include <stdexcept>
 #include <sstream>
 
 namespace CboePitch {
-    class ModifyOrder : public Message {
+    class ModifyOrder final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x3A;
-        static constexpr size_t MESSAGE_SIZE = 31;
+        static constexpr uint8_t MESSAGE_TYPE = ModifyOrderLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = ModifyOrderLayout::SIZE;
 
         static ModifyOrder parse(const uint8_t *data, size_t size, equix_md::SymbolIdentifier& symbol_map, size_t offset = 0) {
             if (size < MESSAGE_SIZE) {
                 throw std::invalid_argument("ModifyOrder message too short");
             }
 
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            uint64_t orderId = Message::readUint64LE(data + offset + 10);
-            uint32_t quantity = Message::readUint32LE(data + offset + 18);
-            double price = Message::decodePrice(data + offset + 22);
+            const LayoutView<ModifyOrderLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<ModifyOrderLayout::TIMESTAMP>();
+            uint64_t orderId = wire.get<ModifyOrderLayout::ORDER_ID>();
+            uint32_t quantity = wire.get<ModifyOrderLayout::QUANTITY>();
+            Price price = wire.get<ModifyOrderLayout::PRICE>();
 
             ModifyOrder modify_order(timestamp, orderId, quantity, price);
             modify_order.setSymbolMap(&symbol_map);
@@ -46,16 +48,16 @@ namespace CboePitch {
         // Accessors
         uint64_t getTimestamp() const { return timestamp; }
         uint32_t getQuantity() const { return quantity; }
-        double getPrice() const { return price; }
+        Price getPrice() const { return price; }
 
     private:
         uint64_t timestamp;
         uint64_t orderId;
         uint32_t quantity;
-        double price;
+        Price price;
 
-        ModifyOrder(uint64_t ts, uint64_t ordId, uint32_t qty, double prc)
-            : timestamp(ts), orderId(ordId), quantity(qty), price(prc) {}
+        ModifyOrder(uint64_t ts, uint64_t ordId, uint32_t qty, Price prc)
+            : Message(MESSAGE_TYPE), timestamp(ts), orderId(ordId), quantity(qty), price(prc) {}
     };
 } // namespace CboePitch
 
@@ -2,15 +2,16 @@
 #define ORDER_EXECUTED_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <stdexcept>
 #include <sstream>
 
 namespace CboePitch {
-    class OrderExecuted : public Message {
+    class OrderExecuted final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x38;
-        static constexpr size_t MESSAGE_SIZE = 43;
+        static constexpr uint8_t MESSAGE_TYPE = OrderExecutedLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = OrderExecutedLayout::SIZE;
 
         static OrderExecuted parse(const uint8_t *data, size_t size, equix_md::SymbolIdentifier &symbol_map,
                                    size_t offset = 0) {
@@ -18,20 +19,17 @@ namespace CboePitch {
                 throw std::invalid_argument("OrderExecuted message too short");
             }
 
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            uint64_t orderId = Message::readUint64LE(data + offset + 10);
-            uint32_t executedQuantity = Message::readUint32LE(data + offset + 18);
-            uint64_t executionId = Message::readUint64LE(data + offset + 22);
-            uint64_t contraOrderId = Message::readUint64LE(data + offset + 30);
-
-            // Contra PID is 4 bytes ASCII, right padded with spaces
-            std::string contraPID(reinterpret_cast<const char *>(data + offset + 38), 4);
-            // Trim trailing spaces
-            contraPID.erase(contraPID.find_last_not_of(' ') + 1);
+            const LayoutView<OrderExecutedLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<OrderExecutedLayout::TIMESTAMP>();
+            uint64_t orderId = wire.get<OrderExecutedLayout::ORDER_ID>();
+            uint32_t executedQuantity = wire.get<OrderExecutedLayout::EXECUTED_QUANTITY>();
+            uint64_t executionId = wire.get<OrderExecutedLayout::EXECUTION_ID>();
+            uint64_t contraOrderId = wire.get<OrderExecutedLayout::CONTRA_ORDER_ID>();
+            std::string contraPID(wire.get<OrderExecutedLayout::CONTRA_PID>()); // Right padding dropped
 
             OrderExecuted order_executed(timestamp, orderId, executedQuantity, executionId, contraOrderId, contraPID);
             order_executed.setSymbolMap(&symbol_map);
-            order_executed.payload.assign(data + offset, data + offset + MESSAGE_SIZE);
+            order_executed.setPayload(data + offset, MESSAGE_SIZE);
             return order_executed;
         }
 
@@ -67,7 +65,7 @@ namespace CboePitch {
 
         OrderExecuted(uint64_t ts, uint64_t ordId, uint32_t qty, uint64_t execId,
                       uint64_t contraOrdId, std::string pid)
-            : timestamp(ts), orderId(ordId), executedQuantity(qty), executionId(execId),
+            : Message(MESSAGE_TYPE), timestamp(ts), orderId(ordId), executedQuantity(qty), executionId(execId),
               contraOrderId(contraOrdId), contraPID(std::move(pid)) {
         }
     };
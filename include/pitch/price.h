@@ -0,0 +1,116 @@
+#ifndef PRICE_H
+#define PRICE_H
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace CboePitch {
+    // PITCH price: signed 64-bit integer with 7 implied decimal places, kept exactly as on the wire.
+    // Compare and add in integer units; convert to double or text only for display and JSON.
+    class Price {
+    public:
+        static constexpr int DECIMALS = 7;
+        static constexpr int64_t SCALE = 10000000; // 10^DECIMALS
+        static constexpr size_t WIRE_SIZE = 8;
+
+        constexpr Price() = default;
+
+        static constexpr Price fromRaw(int64_t raw) {
+            Price price;
+            price.raw_ = raw;
+            return price;
+        }
+
+        // 8-byte little-endian wire field
+        static Price fromWire(const uint8_t *ptr) {
+            uint64_t raw;
+            std::memcpy(&raw, ptr, sizeof(raw));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            raw = __builtin_bswap64(raw);
+#endif
+            return fromRaw(static_cast<int64_t>(raw));
+        }
+
+        // Nearest representable price (tools and tests; the feed never goes through double)
+        static Price fromDouble(double value) {
+            const double scaled = value * static_cast<double>(SCALE);
+            return fromRaw(static_cast<int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
+        }
+
+        void toWire(uint8_t *ptr) const {
+            uint64_t raw = static_cast<uint64_t>(raw_);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            raw = __builtin_bswap64(raw);
+#endif
+            std::memcpy(ptr, &raw, sizeof(raw));
+        }
+
+        constexpr int64_t raw() const { return raw_; }
+        constexpr int64_t wholePart() const { return raw_ / SCALE; }
+        constexpr int64_t fractionPart() const { return raw_ % SCALE; }
+
+        // Display only: not every price is exactly representable as a double
+        double toDouble() const { return static_cast<double>(raw_) / static_cast<double>(SCALE); }
+
+        // Exact decimal text without trailing zeros ("12.5", "100", "-0.0001"); valid as a JSON number
+        std::string toString() const {
+            std::string text;
+            appendTo(text);
+            return text;
+        }
+
+        void appendTo(std::string &out) const {
+            uint64_t magnitude = raw_ < 0 ? 0 - static_cast<uint64_t>(raw_) : static_cast<uint64_t>(raw_);
+            if (raw_ < 0) out.push_back('-');
+            out += std::to_string(magnitude / SCALE);
+            uint64_t fraction = magnitude % SCALE;
+            if (fraction == 0) return;
+            char digits[DECIMALS];
+            for (int i = DECIMALS - 1; i >= 0; --i) {
+                digits[i] = static_cast<char>('0' + fraction % 10);
+                fraction /= 10;
+            }
+            int length = DECIMALS;
+            while (digits[length - 1] == '0') --length;
+            out.push_back('.');
+            out.append(digits, static_cast<size_t>(length));
+        }
+
+        constexpr bool operator==(Price other) const { return raw_ == other.raw_; }
+        constexpr bool operator!=(Price other) const { return raw_ != other.raw_; }
+        constexpr bool operator<(Price other) const { return raw_ < other.raw_; }
+        constexpr bool operator<=(Price other) const { return raw_ <= other.raw_; }
+        constexpr bool operator>(Price other) const { return raw_ > other.raw_; }
+        constexpr bool operator>=(Price other) const { return raw_ >= other.raw_; }
+
+        constexpr Price operator+(Price other) const { return fromRaw(raw_ + other.raw_); }
+        constexpr Price operator-(Price other) const { return fromRaw(raw_ - other.raw_); }
+        constexpr Price operator-() const { return fromRaw(-raw_); }
+        constexpr Price operator*(int64_t factor) const { return fromRaw(raw_ * factor); }
+        constexpr Price operator/(int64_t divisor) const { return fromRaw(raw_ / divisor); }
+
+        Price &operator+=(Price other) {
+            raw_ += other.raw_;
+            return *this;
+        }
+
+        Price &operator-=(Price other) {
+            raw_ -= other.raw_;
+            return *this;
+        }
+
+    private:
+        int64_t raw_ = 0;
+    };
+
+    inline std::ostream &operator<<(std::ostream &os, Price price) {
+        return os << price.toString();
+    }
+
+    static_assert(sizeof(Price) == Price::WIRE_SIZE, "Price is the raw wire value");
+    static_assert(Price::fromRaw(12345000) + Price::fromRaw(5000) == Price::fromRaw(12350000));
+} // namespace CboePitch
+
+#endif // PRICE_H
@@ -0,0 +1,102 @@
+#ifndef RAW_MESSAGE_H
+#define RAW_MESSAGE_H
+
+#include "message.h"
+#include "message_layout.h"
+#include "message_views.h"
+#include "SymbolIdentifier.hpp"
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace CboePitch {
+    namespace detail {
+        template<typename Layout, typename = void>
+        struct HasOrderIdField : std::false_type {};
+        template<typename Layout>
+        struct HasOrderIdField<Layout, std::void_t<decltype(Layout::ORDER_ID)> > : std::true_type {};
+
+        template<typename Layout, typename = void>
+        struct HasSymbolField : std::false_type {};
+        template<typename Layout>
+        struct HasSymbolField<Layout, std::void_t<decltype(Layout::SYMBOL)> > : std::true_type {};
+    } // namespace detail
+
+    // First phase of lazy decoding: a message routed but not decoded. The receive thread reads only
+    // the type, the order id and the symbol (from the wire, or through the SymbolIdentifier for
+    // order-based messages) and forwards the raw slice of the datagram. Everything else is decoded
+    // on demand by the worker that consumes it, with decode() or toString().
+    class RawMessage final : public Message {
+    public:
+        static constexpr uint16_t TYPE_TAG = 0x100; // Above every wire type byte, see Message::getTypeTag()
+
+        // Same SymbolIdentifier upkeep as the full parsers: adds record their order, deletes drop it
+        // (after the symbol is taken, so a delete still routes to its symbol)
+        static RawMessage route(const uint8_t *data, size_t size, size_t offset,
+                                equix_md::SymbolIdentifier &symbol_map) {
+            if (size < offset + 2) {
+                throw std::invalid_argument("RawMessage too short");
+            }
+            const uint8_t *message = data + offset;
+            RawMessage raw(message[1]);
+            const bool known = withLayout(raw.type_, [&](auto layout) {
+                using Layout = decltype(layout);
+                if (size < offset + Layout::SIZE) {
+                    throw std::invalid_argument(std::string(Layout::NAME) + " message too short");
+                }
+                if constexpr (detail::HasOrderIdField<Layout>::value)
+                    raw.orderId_ = readField<Layout, Layout::ORDER_ID>(message);
+                if constexpr (detail::HasSymbolField<Layout>::value)
+                    raw.symbol_ = readField<Layout, Layout::SYMBOL>(message);
+                raw.size_ = static_cast<uint8_t>(Layout::SIZE);
+                raw.setPayload(message, Layout::SIZE);
+            });
+            if (!known) {
+                throw std::invalid_argument("RawMessage: unknown message type " + std::to_string(raw.type_));
+            }
+
+            if (raw.type_ == AddOrderLayout::TYPE) {
+                if (!symbol_map.add_mapping(raw.orderId_, raw.symbol_)) {
+                    std::cerr << "Warning: Order ID " << raw.orderId_ << " already exists in SymbolIdentifier" << std::endl;
+                }
+            } else if (raw.symbol_.empty()) {
+                raw.setSymbolMap(&symbol_map);
+                raw.symbol_ = raw.lookupSymbol(raw.orderId_);
+                if (raw.type_ == DeleteOrderLayout::TYPE && !symbol_map.remove_mapping(raw.orderId_)) {
+                    std::cerr << "Warning: Order ID " << raw.orderId_ << " not found in SymbolIdentifier" << std::endl;
+                }
+            }
+            return raw;
+        }
+
+        // Second phase: call visitor(XxxView) over the payload; false once the payload is released
+        template<typename Visitor>
+        bool decode(Visitor &&visitor) const {
+            return !payload.empty() && visit_message(payload.data(), visitor);
+        }
+
+        std::string toString() const override {
+            std::string out;
+            if (payload.empty() || !appendMessageText(out, payload.data())) {
+                out = "RawMessage{type=" + std::to_string(type_) + ", orderId=" + std::to_string(orderId_) +
+                      ", symbol=" + symbol_.to_string() + "}";
+            }
+            return out;
+        }
+
+        equix_md::Symbol getSymbol() const override { return symbol_; }
+        size_t getMessageSize() const override { return size_; }
+        uint8_t getMessageType() const override { return type_; }
+        uint64_t getOrderId() const override { return orderId_; }
+
+    private:
+        uint8_t type_;
+        uint8_t size_ = 0;
+        uint64_t orderId_ = 0;
+        equix_md::Symbol symbol_;
+
+        explicit RawMessage(uint8_t type) : Message(TYPE_TAG), type_(type) {}
+    };
+} // namespace CboePitch
+
+#endif // RAW_MESSAGE_H
@@ -2,15 +2,16 @@
 #define REDUCE_SIZE_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <sstream>
 #include <stdexcept>
 
 namespace CboePitch {
-    class ReduceSize : public Message {
+    class ReduceSize final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x39;
-        static constexpr size_t MESSAGE_SIZE = 22;
+        static constexpr uint8_t MESSAGE_TYPE = ReduceSizeLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = ReduceSizeLayout::SIZE;
 
         static ReduceSize parse(const uint8_t *data, size_t size, equix_md::SymbolIdentifier &symbol_map,
                                 size_t offset = 0) {
@@ -18,13 +19,14 @@ namespace CboePitch {
                 throw std::invalid_argument("ReduceSize message too short");
             }
 
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            uint64_t orderId = Message::readUint64LE(data + offset + 10);
-            uint32_t cancelledQuantity = Message::readUint32LE(data + offset + 18);
+            const LayoutView<ReduceSizeLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<ReduceSizeLayout::TIMESTAMP>();
+            uint64_t orderId = wire.get<ReduceSizeLayout::ORDER_ID>();
+            uint32_t cancelledQuantity = wire.get<ReduceSizeLayout::CANCELLED_QUANTITY>();
 
             ReduceSize reduce_size(timestamp, orderId, cancelledQuantity);
             reduce_size.setSymbolMap(&symbol_map);
-            reduce_size.payload.assign(data + offset, data + offset + MESSAGE_SIZE);
+            reduce_size.setPayload(data + offset, MESSAGE_SIZE);
             return reduce_size;
         }
 
@@ -49,7 +51,7 @@ namespace CboePitch {
         uint32_t cancelledQuantity;
 
         ReduceSize(uint64_t ts, uint64_t ordId, uint32_t cancelQty)
-            : timestamp(ts), orderId(ordId), cancelledQuantity(cancelQty) {
+            : Message(MESSAGE_TYPE), timestamp(ts), orderId(ordId), cancelledQuantity(cancelQty) {
         }
     };
 } // namespace CboePitch
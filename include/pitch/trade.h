@@ -2,51 +2,49 @@
 #define TRADE_MESSAGE_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <sstream>
 #include <stdexcept>
 #include <iomanip>
 
 namespace CboePitch {
-    class Trade : public Message {
+    class Trade final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x3D;
-        static constexpr size_t MESSAGE_SIZE = 72;
+        static constexpr uint8_t MESSAGE_TYPE = TradeLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = TradeLayout::SIZE;
 
         static Trade parse(const uint8_t *data, size_t size, equix_md::SymbolIdentifier& symbol_map, size_t offset = 0) {
             if (size < MESSAGE_SIZE) {
                 throw std::invalid_argument("Trade message too short");
             }
 
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            std::string symbol(reinterpret_cast<const char *>(data + offset + 10), 6);
-            symbol = Message::trimRight(symbol);
+            const LayoutView<TradeLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<TradeLayout::TIMESTAMP>();
+            const equix_md::Symbol symbol = wire.get<TradeLayout::SYMBOL>();
 
-            uint32_t quantity = Message::readUint32LE(data + offset + 16);
-            double price = Message::decodePrice(data + offset + 20);
+            uint32_t quantity = wire.get<TradeLayout::QUANTITY>();
+            Price price = wire.get<TradeLayout::PRICE>();
 
-            uint64_t executionId = Message::readUint64LE(data + offset + 28);
-            uint64_t orderId = Message::readUint64LE(data + offset + 36);
-            uint64_t contraOrderId = Message::readUint64LE(data + offset + 44);
+            uint64_t executionId = wire.get<TradeLayout::EXECUTION_ID>();
+            uint64_t orderId = wire.get<TradeLayout::ORDER_ID>();
+            uint64_t contraOrderId = wire.get<TradeLayout::CONTRA_ORDER_ID>();
 
-            std::string pid(reinterpret_cast<const char *>(data + offset + 52), 4);
-            pid = Message::trimRight(pid);
+            std::string pid(wire.get<TradeLayout::PID>());
+            std::string contraPid(wire.get<TradeLayout::CONTRA_PID>());
 
-            std::string contraPid(reinterpret_cast<const char *>(data + offset + 56), 4);
-            contraPid = Message::trimRight(contraPid);
+            char tradeType = wire.get<TradeLayout::TRADE_TYPE>();
+            char tradeDesignation = wire.get<TradeLayout::TRADE_DESIGNATION>();
+            char tradeReportType = wire.get<TradeLayout::TRADE_REPORT_TYPE>();
 
-            char tradeType = static_cast<char>(data[offset + 60]);
-            char tradeDesignation = static_cast<char>(data[offset + 61]);
-            char tradeReportType = static_cast<char>(data[offset + 62]);
-
-            uint64_t tradeTxnTime = Message::readUint64LE(data + offset + 63);
-            uint8_t flags = data[offset + 71];
+            uint64_t tradeTxnTime = wire.get<TradeLayout::TRADE_TRANSACTION_TIME>();
+            uint8_t flags = wire.get<TradeLayout::FLAGS>();
 
             Trade trade(timestamp, symbol, quantity, price, executionId, orderId,
                         contraOrderId, pid, contraPid, tradeType,
                         tradeDesignation, tradeReportType, tradeTxnTime, flags);
             trade.setSymbolMap(&symbol_map);
-            trade.payload.assign(data + offset, data + offset + MESSAGE_SIZE);
+            trade.setPayload(data + offset, MESSAGE_SIZE);
             return trade;
         }
 
@@ -75,9 +73,9 @@ namespace CboePitch {
 
         // Accessors
         uint64_t getTimestamp() const { return timestamp; }
-        const std::string &getSymbol() const override { return symbol; }
+        equix_md::Symbol getSymbol() const override { return symbol; }
         uint32_t getQuantity() const { return quantity; }
-        double getPrice() const { return price; }
+        Price getPrice() const { return price; }
         uint64_t getExecutionId() const { return executionId; }
         uint64_t getOrderId() const { return orderId; }
         uint64_t getContraOrderId() const { return contraOrderId; }
@@ -91,9 +89,9 @@ namespace CboePitch {
 
     private:
         uint64_t timestamp;
-        std::string symbol;
+        equix_md::Symbol symbol;
         uint32_t quantity;
-        double price;
+        Price price;
         uint64_t executionId;
         uint64_t orderId;
         uint64_t contraOrderId;
@@ -105,10 +103,10 @@ namespace CboePitch {
         uint64_t tradeTxnTime;
         uint8_t flags;
 
-        Trade(uint64_t ts, const std::string &sym, uint32_t qty, double prc, uint64_t execId,
+        Trade(uint64_t ts, equix_md::Symbol sym, uint32_t qty, Price prc, uint64_t execId,
               uint64_t ordId, uint64_t contraId, const std::string &p, const std::string &contraP,
               char tt, char td, char trt, uint64_t txnTime, uint8_t flgs)
-            : timestamp(ts), symbol(sym), quantity(qty), price(prc), executionId(execId),
+            : Message(MESSAGE_TYPE), timestamp(ts), symbol(sym), quantity(qty), price(prc), executionId(execId),
               orderId(ordId), contraOrderId(contraId), pid(p), contraPid(contraP),
               tradeType(tt), tradeDesignation(td), tradeReportType(trt),
               tradeTxnTime(txnTime), flags(flgs) {
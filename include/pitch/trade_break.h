@@ -2,15 +2,16 @@
 #define TRADE_BREAK_MESSAGE_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <sstream>
 #include <stdexcept>
 
 namespace CboePitch {
-    class TradeBreak : public Message {
+    class TradeBreak final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x3E;
-        static constexpr size_t MESSAGE_SIZE = 18;
+        static constexpr uint8_t MESSAGE_TYPE = TradeBreakLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = TradeBreakLayout::SIZE;
 
         static TradeBreak parse(const uint8_t *data, size_t size, equix_md::SymbolIdentifier &symbol_map,
                                 size_t offset = 0) {
@@ -18,11 +19,12 @@ namespace CboePitch {
                 throw std::invalid_argument("Trade Break message too short");
             }
 
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            uint64_t executionId = Message::readUint64LE(data + offset + 10);
+            const LayoutView<TradeBreakLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<TradeBreakLayout::TIMESTAMP>();
+            uint64_t executionId = wire.get<TradeBreakLayout::EXECUTION_ID>();
 
             TradeBreak trade(timestamp, executionId);
-            trade.payload.assign(data + offset, data + offset + MESSAGE_SIZE);
+            trade.setPayload(data + offset, MESSAGE_SIZE);
             trade.setSymbolMap(&symbol_map);
             return trade;
         }
@@ -45,7 +47,7 @@ namespace CboePitch {
         uint64_t executionId;
 
         TradeBreak(uint64_t ts, uint64_t execId)
-            : timestamp(ts), executionId(execId) {
+            : Message(MESSAGE_TYPE), timestamp(ts), executionId(execId) {
         }
     };
 } // namespace CboePitch
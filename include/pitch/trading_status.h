@@ -2,28 +2,30 @@
 #define TRADING_STATUS_MESSAGE_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <string>
 #include <sstream>
 #include <stdexcept>
 
 namespace CboePitch {
-    class TradingStatus : public Message {
+    class TradingStatus final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x3B;
-        static constexpr size_t MESSAGE_SIZE = 22;
+        static constexpr uint8_t MESSAGE_TYPE = TradingStatusLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = TradingStatusLayout::SIZE;
 
         static TradingStatus parse(const uint8_t *data, size_t size, size_t offset = 0) {
             if (size < offset + MESSAGE_SIZE) {
                 throw std::invalid_argument("Trading Status message too short");
             }
 
-            uint64_t timestamp = Message::readUint64LE(data + offset + 2);
-            std::string symbol = Message::readAscii(data + offset + 10, 6);
-            char tradingStatus = static_cast<char>(data[offset + 16]);
-            std::string marketId = Message::readAscii(data + offset + 17, 4);
+            const LayoutView<TradingStatusLayout> wire(data + offset);
+            uint64_t timestamp = wire.get<TradingStatusLayout::TIMESTAMP>();
+            const equix_md::Symbol symbol = wire.get<TradingStatusLayout::SYMBOL>();
+            char tradingStatus = wire.get<TradingStatusLayout::TRADING_STATUS>();
+            std::string marketId(wire.get<TradingStatusLayout::MARKET_ID>());
 
             TradingStatus trading_status(timestamp, symbol, tradingStatus, marketId);
-            trading_status.payload.assign(data + offset, data + offset + MESSAGE_SIZE);
+            trading_status.setPayload(data + offset, MESSAGE_SIZE);
             return trading_status;
         }
 
@@ -41,18 +43,18 @@ namespace CboePitch {
         uint8_t getMessageType() const override { return MESSAGE_TYPE; }
 
         uint64_t getTimestamp() const { return timestamp; }
-        const std::string &getSymbol() const override { return symbol; }
+        equix_md::Symbol getSymbol() const override { return symbol; }
         char getTradingStatus() const { return tradingStatus; }
         const std::string &getMarketId() const { return marketId; }
 
     private:
         uint64_t timestamp;
-        std::string symbol;
+        equix_md::Symbol symbol;
         char tradingStatus;
         std::string marketId;
 
-        TradingStatus(uint64_t ts, const std::string &sym, char status, const std::string &market)
-            : timestamp(ts), symbol(sym), tradingStatus(status), marketId(market) {
+        TradingStatus(uint64_t ts, equix_md::Symbol sym, char status, const std::string &market)
+            : Message(MESSAGE_TYPE), timestamp(ts), symbol(sym), tradingStatus(status), marketId(market) {
         }
     };
 } // namespace CboePitch
@@ -2,21 +2,23 @@
 #define UNIT_CLEAR_MESSAGE_H
 
 #include "message.h"
+#include "message_layout.h"
 #include <sstream>
 #include <stdexcept>
 
 namespace CboePitch {
-    class UnitClear : public Message {
+    class UnitClear final : public Message {
     public:
-        static constexpr uint8_t MESSAGE_TYPE = 0x97;
-        static constexpr size_t MESSAGE_SIZE = 6;
+        static constexpr uint8_t MESSAGE_TYPE = UnitClearLayout::TYPE;
+        static constexpr size_t MESSAGE_SIZE = UnitClearLayout::SIZE;
 
         static UnitClear parse(const uint8_t *data, size_t size, size_t offset = 0) {
             if (size < offset + MESSAGE_SIZE) {
                 throw std::invalid_argument("Unit Clear message too short");
             }
 
-            uint32_t reserved = Message::readUint32LE(data + offset + 2);
+            const LayoutView<UnitClearLayout> wire(data + offset);
+            uint32_t reserved = wire.get<UnitClearLayout::RESERVED>();
             return UnitClear(reserved);
         }
 
@@ -35,7 +37,7 @@ namespace CboePitch {
         uint32_t reserved;
 
         explicit UnitClear(uint32_t res)
-            : reserved(res) {
+            : Message(MESSAGE_TYPE), reserved(res) {
         }
     };
 } // namespace CboePitch
@@ -0,0 +1,557 @@
+/**
+ * @file    GapRecoveryClient.cpp
+ * @brief   Gap Request Proxy client implementation.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: GapRecoveryClient.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Session thread: connects and logs in, turns gap events into rate limited
+ *   GapRequests, matches GapResponses and replayed unit packets (from the
+ *   gap response channel, or in-band) to the requests in flight, and injects
+ *   the replayed messages in pool buffers.
+ */
+
+#include "GapRecoveryClient.hpp"
+#include "LatencyStats.hpp"
+#include "pitch/gap_login.h"
+#include "pitch/gap_login_response.h"
+#include "pitch/gap_request.h"
+#include "pitch/gap_response.h"
+#include "pitch/message_encoder.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+using equix_md::PacketRef;
+using CboePitch::wire::loadLE;
+using CboePitch::wire::storeLE;
+
+namespace {
+
+    constexpr uint64_t kNsPerMs = 1000000ULL;
+    constexpr size_t kHeaderSize = CboePitch::SequencedUnitEncoder::HEADER_SIZE;
+    constexpr int kPollTimeoutMs = 10;
+
+    std::string describe(uint8_t unit, uint32_t sequence, uint32_t count) {
+        return "unit " + std::to_string(unit) + " sequences " + std::to_string(sequence) + ".." +
+               std::to_string(sequence + count - 1);
+    }
+}
+
+GapRecoveryClient::GapRecoveryClient(const Config &config, equix_md::SequenceTracker &tracker,
+                                     equix_md::PacketBufferPool &pool)
+    : config_(config), tracker_(tracker), pool_(pool) {
+    if (config_.port == 0) throw std::invalid_argument("gap_recovery port is required");
+    in_addr address{};
+    if (inet_pton(AF_INET, config_.host.c_str(), &address) != 1) {
+        throw std::invalid_argument("gap_recovery host '" + config_.host + "' is not an IPv4 address");
+    }
+    config_.max_batch_messages = std::min<uint32_t>(std::max<uint32_t>(config_.max_batch_messages, 1), UINT16_MAX);
+    if (config_.max_outstanding == 0) config_.max_outstanding = 1;
+    if (config_.batch_size == 0) config_.batch_size = 1;
+    // A batch is flushed between buffers, so it may overrun batch_size by one buffer's packets
+    batch_.resize(config_.batch_size + equix_md::PacketBuffer::kCapacity / (kHeaderSize + 2));
+
+    if (config_.replay_port != 0) {
+        UdpReceiver::Config replay_config;
+        replay_config.bind_ip = config_.replay_bind_ip;
+        replay_config.bind_port = config_.replay_port;
+        replay_config.multicast_group = config_.replay_multicast_group;
+        replay_config.interface_ip = config_.replay_interface_ip;
+        replay_config.source_ip = config_.replay_source_ip;
+        replay_config.batch_size = config_.batch_size;
+        replay_receiver_ = std::make_unique<UdpReceiver>(replay_config, pool_);
+    }
+}
+
+GapRecoveryClient::~GapRecoveryClient() {
+    stop();
+}
+
+void GapRecoveryClient::start(ReplayCallback callback) {
+    if (running_) return;
+    std::cout << "[GapRecovery] Gap Request Proxy " << config_.host << ":" << config_.port << ", "
+              << (config_.max_requests_per_second
+                      ? std::to_string(config_.max_requests_per_second) + " requests/s"
+                      : std::string("no rate limit"))
+              << ", up to " << config_.max_batch_messages << " messages per request, "
+              << config_.max_outstanding << " in flight, replays "
+              << (!replay_receiver_ ? std::string("in-band")
+                  : "on " + (config_.replay_multicast_group.empty() ? config_.replay_bind_ip
+                                                                    : config_.replay_multicast_group) +
+                        ":" + std::to_string(config_.replay_port))
+              << std::endl;
+    callback_ = std::move(callback);
+    running_ = true;
+    thread_ = std::thread([this]() {
+        UdpReceiver::pin_current_thread(config_.cpu_affinity_core);
+        run();
+    });
+}
+
+void GapRecoveryClient::stop() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void GapRecoveryClient::run() {
+    while (running_) {
+        uint64_t now = equix_md::monotonic_now_ns();
+        take_gaps();
+
+        if (session_ == Session::Disconnected) {
+            if (now < deadline_ns_ || !connect_session(now)) {
+                read_replays(); // Nothing is outstanding: keeps the socket from backing up
+                std::this_thread::sleep_for(std::chrono::milliseconds(kPollTimeoutMs));
+                continue;
+            }
+        } else if (session_ == Session::LoggingIn && now >= deadline_ns_) {
+            std::cerr << "[GapRecovery] No LoginResponse within " << config_.request_timeout_ms << " ms" << std::endl;
+            close_session(now);
+            continue;
+        }
+        if (session_ == Session::Ready) {
+            expire_requests(now);
+            send_requests(now);
+        }
+        if (!flush_tx()) {
+            close_session(now);
+            continue;
+        }
+
+        pollfd descriptors[2] = {{fd_, static_cast<short>(POLLIN | (tx_.empty() ? 0 : POLLOUT)), 0},
+                                 {replay_receiver_ ? replay_receiver_->wait_fd() : -1, POLLIN, 0}};
+        int ready = poll(descriptors, replay_receiver_ ? 2 : 1, kPollTimeoutMs);
+        if (ready > 0 && (descriptors[1].revents & POLLIN)) read_replays();
+        if (ready > 0 && (descriptors[0].revents & (POLLIN | POLLHUP | POLLERR)) &&
+            !read_session(equix_md::monotonic_now_ns())) {
+            close_session(equix_md::monotonic_now_ns());
+        }
+        flush_batch();
+    }
+    flush_batch();
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    logged_in_.store(false, std::memory_order_relaxed);
+}
+
+void GapRecoveryClient::take_gaps() {
+    equix_md::SequenceGap gap;
+    while (tracker_.poll_gap(gap)) {
+        bump(gaps_);
+        std::cerr << "[Sequence] Gap on unit " << static_cast<int>(gap.unit) << ": sequences "
+                << gap.first_sequence << ".." << gap.first_sequence + gap.count - 1
+                << " (" << gap.count << " messages), requesting replay\n";
+        add_range(Range{gap.unit, gap.first_sequence, gap.count});
+    }
+}
+
+void GapRecoveryClient::add_range(const Range &range) {
+    if (range.count == 0) return;
+    // Batching: a gap right after the unit's last queued one extends it
+    for (auto it = pending_.rbegin(); it != pending_.rend(); ++it) {
+        if (it->unit != range.unit) continue;
+        if (it->sequence + it->count == range.sequence) {
+            it->count += range.count;
+            return;
+        }
+        break;
+    }
+    pending_.push_back(range);
+    trim_pending();
+}
+
+void GapRecoveryClient::requeue(const Range &range) {
+    if (range.count == 0) return;
+    // Keep each unit's ranges in sequence order so the replay stays in order
+    auto position = pending_.begin();
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+        if (it->unit != range.unit) continue;
+        if (it->sequence > range.sequence) {
+            position = it;
+            break;
+        }
+        position = it + 1;
+    }
+    pending_.insert(position, range);
+    trim_pending();
+}
+
+void GapRecoveryClient::trim_pending() {
+    while (pending_.size() > kMaxPendingRanges) {
+        give_up(pending_.front(), "too many pending ranges");
+        pending_.pop_front();
+    }
+}
+
+void GapRecoveryClient::give_up(const Range &range, const char *why) {
+    if (range.count == 0) return;
+    bump(unrecovered_messages_, range.count);
+    std::cerr << "[GapRecovery] Giving up " << describe(range.unit, range.sequence, range.count) << ": " << why
+            << std::endl;
+}
+
+bool GapRecoveryClient::connect_session(uint64_t now_ns) {
+    deadline_ns_ = now_ns + config_.retry_delay_ms * kNsPerMs;
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        std::cerr << "[GapRecovery] Failed to create TCP socket: " << strerror(errno) << std::endl;
+        return false;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    inet_pton(AF_INET, config_.host.c_str(), &address.sin_addr);
+
+    int error = 0;
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        error = errno;
+        if (error == EINPROGRESS) {
+            pollfd descriptor{fd, POLLOUT, 0};
+            int ready = poll(&descriptor, 1, static_cast<int>(config_.connect_timeout_ms));
+            socklen_t length = sizeof(error);
+            if (ready <= 0) error = ready == 0 ? ETIMEDOUT : errno;
+            else if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0) error = errno;
+        }
+    }
+    if (error != 0) {
+        if (!connect_failed_) {
+            std::cerr << "[GapRecovery] Connect to " << config_.host << ":" << config_.port << " failed: "
+                    << strerror(error) << " (retrying every " << config_.retry_delay_ms << " ms)" << std::endl;
+        }
+        connect_failed_ = true;
+        ::close(fd);
+        return false;
+    }
+    connect_failed_ = false;
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fd_ = fd;
+
+    CboePitch::SequencedUnitEncoder frame(0, 0);
+    uint8_t login[CboePitch::GapLogin::MESSAGE_SIZE];
+    CboePitch::GapLogin::encode(login, config_.session_sub_id, config_.username, config_.password);
+    frame.addRaw(login, sizeof(login));
+    tx_.assign(frame.data(), frame.data() + frame.size());
+    rx_.clear();
+    session_ = Session::LoggingIn;
+    deadline_ns_ = equix_md::monotonic_now_ns() + config_.request_timeout_ms * kNsPerMs;
+    std::cout << "[GapRecovery] Connected to " << config_.host << ":" << config_.port << ", logging in as '"
+              << config_.username << "'" << std::endl;
+    return true;
+}
+
+void GapRecoveryClient::close_session(uint64_t now_ns) {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    if (session_ == Session::Ready) std::cerr << "[GapRecovery] Session lost, reconnecting" << std::endl;
+    session_ = Session::Disconnected;
+    logged_in_.store(false, std::memory_order_relaxed);
+    deadline_ns_ = now_ns + config_.retry_delay_ms * kNsPerMs;
+    // Whatever was still in flight is asked for again on the next session
+    for (const Request &request: outstanding_) {
+        requeue(Range{request.range.unit, request.next, request.range.sequence + request.range.count - request.next});
+    }
+    outstanding_.clear();
+    tx_.clear();
+    rx_.clear();
+}
+
+bool GapRecoveryClient::flush_tx() {
+    while (!tx_.empty()) {
+        ssize_t sent = ::send(fd_, tx_.data(), tx_.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            if (errno == EINTR) continue;
+            std::cerr << "[GapRecovery] Send failed: " << strerror(errno) << std::endl;
+            return false;
+        }
+        tx_.erase(tx_.begin(), tx_.begin() + sent);
+    }
+    return true;
+}
+
+bool GapRecoveryClient::read_session(uint64_t now_ns) {
+    uint8_t chunk[16384];
+    for (;;) {
+        ssize_t received = ::recv(fd_, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            rx_.insert(rx_.end(), chunk, chunk + received);
+            continue;
+        }
+        if (received == 0) {
+            std::cerr << "[GapRecovery] Connection closed by the proxy" << std::endl;
+            return false;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        std::cerr << "[GapRecovery] Receive failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    size_t offset = 0;
+    while (rx_.size() - offset >= kHeaderSize) {
+        const size_t length = loadLE<uint16_t>(rx_.data() + offset);
+        if (length < kHeaderSize) {
+            std::cerr << "[GapRecovery] Bad frame length " << length << std::endl;
+            return false;
+        }
+        if (rx_.size() - offset < length) break;
+        if (!on_frame(rx_.data() + offset, length, now_ns)) return false;
+        offset += length;
+    }
+    rx_.erase(rx_.begin(), rx_.begin() + static_cast<std::ptrdiff_t>(offset));
+    return true;
+}
+
+bool GapRecoveryClient::on_frame(const uint8_t *frame, size_t size, uint64_t now_ns) {
+    const uint32_t sequence = loadLE<uint32_t>(frame + 4);
+    if (sequence != 0) {
+        if (session_ == Session::Ready && !replay_receiver_) on_replay(frame, size);
+        return true;
+    }
+    // Session messages
+    size_t offset = kHeaderSize;
+    for (uint8_t i = 0; i < frame[2] && offset + 2 <= size; ++i) {
+        const size_t length = frame[offset];
+        if (length < 2 || offset + length > size) break;
+        if (!on_control(frame + offset, length, now_ns)) return false;
+        offset += length;
+    }
+    return true;
+}
+
+bool GapRecoveryClient::on_control(const uint8_t *message, size_t size, uint64_t now_ns) {
+    switch (message[1]) {
+        case CboePitch::LoginResponse::MESSAGE_TYPE: {
+            auto response = CboePitch::LoginResponse::parse(message, size);
+            if (session_ != Session::LoggingIn) return true;
+            if (!response.isAccepted()) {
+                std::cerr << "[GapRecovery] Login rejected (status " << response.getStatus() << ")" << std::endl;
+                return false;
+            }
+            session_ = Session::Ready;
+            logged_in_.store(true, std::memory_order_relaxed);
+            bump(logins_);
+            tokens_ = config_.max_requests_per_second;
+            tokens_ns_ = now_ns;
+            std::cout << "[GapRecovery] Logged in, " << pending_.size() << " range(s) pending" << std::endl;
+            return true;
+        }
+        case CboePitch::GapResponse::MESSAGE_TYPE: {
+            auto response = CboePitch::GapResponse::parse(message, size);
+            auto it = std::find_if(outstanding_.begin(), outstanding_.end(), [&response](const Request &request) {
+                return !request.answered && request.range.unit == response.getUnit() &&
+                       request.range.sequence == response.getSequence();
+            });
+            if (it == outstanding_.end()) return true; // Timed out already
+            if (response.isAccepted()) {
+                it->answered = true;
+                bump(accepted_);
+                return true;
+            }
+            const Range rest{it->range.unit, it->next, it->range.sequence + it->range.count - it->next};
+            outstanding_.erase(it);
+            if (response.isRetryable()) {
+                bump(retried_);
+                retry_after_ns_ = now_ns + config_.retry_delay_ms * kNsPerMs;
+                std::cerr << "[GapRecovery] " << describe(rest.unit, rest.sequence, rest.count)
+                        << " rejected (status " << response.getStatus() << "), retrying in "
+                        << config_.retry_delay_ms << " ms" << std::endl;
+                requeue(rest);
+            } else {
+                bump(rejected_);
+                give_up(rest, ("rejected with status " + std::string(1, response.getStatus())).c_str());
+            }
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+void GapRecoveryClient::on_replay(const uint8_t *frame, size_t size) {
+    const uint8_t count = frame[2];
+    const uint8_t unit = frame[3];
+    const uint32_t first = loadLE<uint32_t>(frame + 4);
+    const uint32_t end = first + count;
+    uint32_t position = first;
+    // A replayed packet may straddle requests (ranges split at max_batch_messages): hand each part over
+    while (position < end) {
+        auto it = std::find_if(outstanding_.begin(), outstanding_.end(), [&](const Request &request) {
+            return request.range.unit == unit && request.next < end &&
+                   request.range.sequence + request.range.count > position;
+        });
+        if (it == outstanding_.end()) return; // Duplicate or not requested
+        Request &request = *it;
+        const uint32_t request_end = request.range.sequence + request.range.count;
+        const uint32_t start = std::max(position, request.next);
+        if (start > request.next) give_up(Range{unit, request.next, start - request.next}, "missing from the replay");
+        const uint32_t keep = std::min(end, request_end) - start;
+        deliver(frame, size, unit, start, start - first, keep);
+        request.next = start + keep;
+        position = request.next;
+        if (request.next == request_end) outstanding_.erase(it);
+    }
+}
+
+void GapRecoveryClient::read_replays() {
+    if (!replay_receiver_) return;
+    const auto on_datagrams = [this](const UdpReceiver::Packet *packets, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto *datagram = reinterpret_cast<const uint8_t *>(packets[i].data);
+            if (packets[i].size < kHeaderSize) continue;
+            const size_t length = loadLE<uint16_t>(datagram);
+            if (length < kHeaderSize || length > packets[i].size || loadLE<uint32_t>(datagram + 4) == 0) continue;
+            on_replay(datagram, length);
+        }
+    };
+    // Bounded so a busy channel cannot starve the TCP session
+    for (size_t batches = 0; batches < 64 && replay_receiver_->poll(on_datagrams) > 0; ++batches) {
+    }
+}
+
+void GapRecoveryClient::send_requests(uint64_t now_ns) {
+    if (pending_.empty() || now_ns < retry_after_ns_) return;
+    const double rate = config_.max_requests_per_second;
+    if (rate > 0) {
+        tokens_ = std::min(rate, tokens_ + static_cast<double>(now_ns - tokens_ns_) * rate / 1e9);
+        tokens_ns_ = now_ns;
+    }
+    // Every request due goes out in one frame
+    CboePitch::SequencedUnitEncoder frame(0, 0);
+    while (!pending_.empty() && outstanding_.size() < config_.max_outstanding && (rate == 0 || tokens_ >= 1.0) &&
+           frame.fits(CboePitch::GapRequest::MESSAGE_SIZE)) {
+        Range &range = pending_.front();
+        const uint32_t count = std::min(range.count, config_.max_batch_messages);
+        uint8_t request[CboePitch::GapRequest::MESSAGE_SIZE];
+        CboePitch::GapRequest::encode(request, range.unit, range.sequence, static_cast<uint16_t>(count));
+        frame.addRaw(request, sizeof(request));
+        outstanding_.push_back(Request{Range{range.unit, range.sequence, count}, range.sequence, now_ns, false});
+        range.sequence += count;
+        range.count -= count;
+        if (range.count == 0) pending_.pop_front();
+        if (rate > 0) tokens_ -= 1.0;
+        bump(requests_);
+    }
+    if (!frame.empty()) tx_.insert(tx_.end(), frame.data(), frame.data() + frame.size());
+}
+
+void GapRecoveryClient::expire_requests(uint64_t now_ns) {
+    const uint64_t timeout_ns = config_.request_timeout_ms * kNsPerMs;
+    for (auto it = outstanding_.begin(); it != outstanding_.end();) {
+        if (now_ns - it->sent_ns < timeout_ns) {
+            ++it;
+            continue;
+        }
+        bump(timed_out_);
+        give_up(Range{it->range.unit, it->next, it->range.sequence + it->range.count - it->next},
+                "request timed out");
+        it = outstanding_.erase(it);
+    }
+}
+
+void GapRecoveryClient::deliver(const uint8_t *frame, size_t size, uint8_t unit, uint32_t sequence, size_t skip,
+                                size_t keep) {
+    if (keep == 0) return;
+    // Messages [skip, skip + keep) become one-message packets packed into pool buffers: the reorder
+    // buffer then drops exactly the messages a live line delivered meanwhile.
+    PacketRef buffer;
+    size_t used = 0;
+    size_t in = kHeaderSize;
+    size_t copied = 0;
+    for (size_t i = 0; i < skip + keep && in + 2 <= size; ++i) {
+        const size_t length = frame[in];
+        if (length < 2 || in + length > size) break;
+        if (i >= skip) {
+            if (buffer && used + kHeaderSize + length > equix_md::PacketBuffer::kCapacity) seal(buffer, used);
+            if (!buffer) {
+                buffer = acquire_buffer();
+                if (!buffer) break;
+                used = 0;
+            }
+            uint8_t *out = buffer->data + used;
+            storeLE<uint16_t>(out, static_cast<uint16_t>(kHeaderSize + length));
+            out[2] = 1;
+            out[3] = unit;
+            storeLE<uint32_t>(out + 4, static_cast<uint32_t>(sequence + copied));
+            std::memcpy(out + kHeaderSize, frame + in, length);
+
+            UdpReceiver::Packet &packet = batch_[batch_count_++];
+            packet.data = reinterpret_cast<const char *>(out);
+            packet.size = kHeaderSize + length;
+            packet.buffer = buffer;
+            used += kHeaderSize + length;
+            ++copied;
+        }
+        in += length;
+    }
+    if (buffer) seal(buffer, used);
+    if (copied < keep) give_up(Range{unit, static_cast<uint32_t>(sequence + copied), static_cast<uint32_t>(keep - copied)},
+                               "malformed replay packet");
+    if (copied == 0) return;
+    bump(recovered_packets_);
+}
+
+equix_md::PacketRef GapRecoveryClient::acquire_buffer() {
+    PacketRef buffer = pool_.acquire();
+    while (!buffer && running_) {
+        // Downstream still holds every buffer: hand over what we have and wait for releases.
+        flush_batch();
+        std::this_thread::yield();
+        buffer = pool_.acquire();
+    }
+    if (buffer) buffer->rx_timestamp_ns = equix_md::realtime_now_ns();
+    return buffer;
+}
+
+void GapRecoveryClient::seal(PacketRef &buffer, size_t used) {
+    // Packets of a buffer are handed over only once it is complete
+    buffer->size = used;
+    buffer.reset();
+    if (batch_count_ >= config_.batch_size) flush_batch();
+}
+
+void GapRecoveryClient::flush_batch() {
+    if (batch_count_ == 0) return;
+    // Replayed messages count as recovered only once the callback (the reorder window) took them
+    const size_t accepted = std::min(callback_(batch_.data(), batch_count_), batch_count_);
+    bump(recovered_messages_, accepted);
+    bump(discarded_messages_, batch_count_ - accepted);
+    for (size_t i = 0; i < batch_count_; ++i) batch_[i].buffer.reset();
+    batch_count_ = 0;
+}
+
+GapRecoveryClient::Stats GapRecoveryClient::stats() const {
+    Stats snapshot;
+    snapshot.logged_in = logged_in_.load(std::memory_order_relaxed);
+    snapshot.logins = logins_.load(std::memory_order_relaxed);
+    snapshot.gaps = gaps_.load(std::memory_order_relaxed);
+    snapshot.requests = requests_.load(std::memory_order_relaxed);
+    snapshot.accepted = accepted_.load(std::memory_order_relaxed);
+    snapshot.rejected = rejected_.load(std::memory_order_relaxed);
+    snapshot.retried = retried_.load(std::memory_order_relaxed);
+    snapshot.timed_out = timed_out_.load(std::memory_order_relaxed);
+    snapshot.recovered_packets = recovered_packets_.load(std::memory_order_relaxed);
+    snapshot.recovered_messages = recovered_messages_.load(std::memory_order_relaxed);
+    snapshot.discarded_messages = discarded_messages_.load(std::memory_order_relaxed);
+    snapshot.unrecovered_messages = unrecovered_messages_.load(std::memory_order_relaxed);
+    return snapshot;
+}
@@ -166,6 +166,7 @@ void KafkaProducer::shutdown() {
                 rd_kafka_topic_destroy(kv.second); // Release each topic handle
         }
         topic_cache_.clear(); // Remove all entries
+        symbol_topic_cache_.clear();
     }
     // Flush and destroy the producer
     if (producer_) {
@@ -208,3 +209,26 @@ rd_kafka_topic_t* KafkaProducer::get_or_create_topic(const std::string& topic_na
     std::cerr << "[KafkaProducer] Created handle for topic: " << topic_name << std::endl;
     return topic;
 }
+
+/**
+ * @brief   Symbol-keyed front of get_or_create_topic(topic_name).
+ *
+ *          The hot path is a shared-lock lookup on the packed symbol. On a miss the handle is fetched
+ *          (or created) by name and remembered under the symbol.
+ *
+ * @param   symbol  Symbol whose text is the topic name.
+ * @return  Pointer to the rd_kafka_topic_t handle for the topic, or nullptr if topic creation failed.
+ */
+rd_kafka_topic_t* KafkaProducer::get_or_create_topic(equix_md::Symbol symbol) {
+    {
+        std::shared_lock lock(topic_cache_mutex_);
+        auto it = symbol_topic_cache_.find(symbol);
+        if (it != symbol_topic_cache_.end()) return it->second;
+    }
+    rd_kafka_topic_t* topic = get_or_create_topic(symbol.to_string());
+    if (topic) {
+        std::unique_lock lock(topic_cache_mutex_);
+        symbol_topic_cache_.emplace(symbol, topic);
+    }
+    return topic;
+}
@@ -1,6 +1,8 @@
 #include <iostream>
 #include "pitch/message_factory.h"
 #include "pitch/message_dispatcher.h"
+#include "pitch/message_index.h"
+#include "pitch/raw_message.h"
 #include "pitch/seq_unit_header.h"
 #include "SymbolIdentifier.hpp"
 #include <stdexcept>
@@ -14,65 +16,104 @@ namespace CboePitch {
             throw std::invalid_argument("Data too short");
         }
         uint8_t messageType = data[0];
-        const auto &dispatchTable = MessageDispatch::getDispatchTable();
-        auto it = dispatchTable.find(messageType);
-        if (it == dispatchTable.end()) {
+        const MessageDispatchInfo &dispatchInfo = MessageDispatch::lookup(messageType);
+        if (dispatchInfo.parser == nullptr) {
             throw std::runtime_error("Unknown message type: " + std::to_string(messageType));
         }
 
-        return it->second.parser(data, size, 0, symbol_map);
+        return dispatchInfo.parser(data, size, 0, symbol_map);
     }
 
     SeqUnitHeader MessageFactory::parseHeader(const uint8_t *data, size_t size) {
         return SeqUnitHeader::parse(data, size);
     }
 
-    std::vector<std::shared_ptr<Message>> MessageFactory::parseMessages(const uint8_t *data, size_t length, equix_md::SymbolIdentifier& symbol_map) {
+    std::vector<std::shared_ptr<Message>> MessageFactory::parseMessages(const uint8_t *data, size_t length, equix_md::SymbolIdentifier& symbol_map,
+                                                                        const equix_md::PacketRef &packet,
+                                                                        MessageArenaPool *arenas) {
         if (length < 8) {
             throw std::runtime_error("Data too short for SeqUnitHeader");
         }
 
-        SeqUnitHeader header = SeqUnitHeader::parse(data, length);
-        std::vector<std::shared_ptr<Message>> messages;
-        messages.reserve(header.getCount());
-        size_t offset = 8; // Skip 8-byte header
-        size_t remainingLength = header.getLength() - 8;
-        if (remainingLength > length - offset) {
-            throw std::runtime_error("Insufficient data for all messages");
+        // Frame first by the length bytes; unknown types are already stepped over in the index
+        MessageIndex index;
+        if (!index.scan(data, length)) {
+            std::cerr << "[MessageFactory] Truncated packet: " << SeqUnitHeader::parse(data, length).toString()
+                      << ", datagram=" << length << " bytes, parsing the " << index.size() << " framed messages"
+                      << std::endl;
         }
+        return parseMessages(data, index, 0, index.size(), symbol_map, packet, arenas);
+    }
 
-        const auto &dispatchTable = MessageDispatch::getDispatchTable();
-
-        for (uint8_t i = 0; i < header.getCount() && offset < length; ++i) {
-            if (offset >= header.getLength()) break;
-            if (remainingLength == 0) break;
-            uint8_t messageLength = data[offset];
-            uint8_t messageType = data[offset + 1];
-            auto it = dispatchTable.find(messageType);
-            if (it == dispatchTable.end()) {
-                std::cerr << "Skipping unknown message type: " << std::to_string(messageType) << std::endl;
-                throw std::runtime_error("Unknown message type: " + std::to_string(messageType));
-            }
+    std::vector<std::shared_ptr<Message>> MessageFactory::parseMessages(const uint8_t *data, const MessageIndex &index,
+                                                                        size_t first, size_t last,
+                                                                        equix_md::SymbolIdentifier& symbol_map,
+                                                                        const equix_md::PacketRef &packet,
+                                                                        MessageArenaPool *arenas) {
+        if (last > index.size()) last = index.size();
+        std::vector<std::shared_ptr<Message>> messages;
+        if (first >= last) return messages;
+        messages.reserve(last - first);
 
-            const auto &dispatchInfo = it->second;
-            size_t msgLength = dispatchInfo.length;
+        // One owner for the whole packet: arena messages alias it and it holds the packet buffer
+        MessageArena *arena = arenas ? arenas->acquire() : nullptr;
+        std::shared_ptr<void> owner;
+        if (arena) owner = arena->open(packet);
 
-            if (msgLength > remainingLength) {
-                throw std::runtime_error("Message length exceeds remaining data");
+        for (size_t i = first; i < last; ++i) {
+            const MessageIndexEntry &entry = index[i];
+            const MessageDispatchInfo &info = MessageDispatch::lookup(entry.type);
+            // The index only holds known types long enough for their parser; bound each parse by the
+            // message's own length byte
+            const size_t size = static_cast<size_t>(entry.offset) + entry.length;
+            std::shared_ptr<Message> msg;
+            if (Message *placed = arena ? arena->emplace(info, data, size, entry.offset, symbol_map) : nullptr) {
+                msg = std::shared_ptr<Message>(owner, placed);
+            } else {
+                msg = info.parser(data, size, entry.offset, symbol_map);
+                if (packet) msg->attachPacket(packet);
             }
+            if (packet) msg->setReceiveTimestamp(packet->rx_timestamp_ns);
+            messages.push_back(std::move(msg));
+        }
+        return messages;
+    }
 
-            std::shared_ptr<Message> msg = dispatchInfo.parser(data, remainingLength, offset, symbol_map);
-            // msg->printPayloadHex();
-            messages.push_back(msg);
-
-            offset += msgLength;
-            remainingLength -= msgLength;
+    std::vector<std::shared_ptr<Message>> MessageFactory::routeMessages(const uint8_t *data, size_t length,
+                                                                        equix_md::SymbolIdentifier& symbol_map,
+                                                                        const equix_md::PacketRef &packet,
+                                                                        MessageArenaPool *arenas) {
+        if (length < 8) {
+            throw std::runtime_error("Data too short for SeqUnitHeader");
         }
 
-        if (offset != header.getLength()) {
-            throw std::runtime_error("Decoded length does not match Hdr Length");
+        MessageIndex index;
+        if (!index.scan(data, length)) {
+            std::cerr << "[MessageFactory] Truncated packet: " << SeqUnitHeader::parse(data, length).toString()
+                      << ", datagram=" << length << " bytes, routing the " << index.size() << " framed messages"
+                      << std::endl;
         }
+        std::vector<std::shared_ptr<Message>> messages;
+        if (index.empty()) return messages;
+        messages.reserve(index.size());
 
+        MessageArena *arena = arenas ? arenas->acquire() : nullptr;
+        std::shared_ptr<void> owner;
+        if (arena) owner = arena->open(packet);
+
+        for (const MessageIndexEntry &entry: index) {
+            const size_t size = static_cast<size_t>(entry.offset) + entry.length;
+            RawMessage raw = RawMessage::route(data, size, entry.offset, symbol_map);
+            std::shared_ptr<Message> msg;
+            if (Message *placed = arena ? arena->construct<RawMessage>(std::move(raw)) : nullptr) {
+                msg = std::shared_ptr<Message>(owner, placed);
+            } else {
+                msg = std::make_shared<RawMessage>(std::move(raw));
+                if (packet) msg->attachPacket(packet);
+            }
+            if (packet) msg->setReceiveTimestamp(packet->rx_timestamp_ns);
+            messages.push_back(std::move(msg));
+        }
         return messages;
     }
     //
@@ -0,0 +1,284 @@
+/**
+ * @file    PcapReader.cpp
+ * @brief   Memory-mapped pcap / pcapng capture reader implementation.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: PcapReader.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Record parsing for classic pcap and pcapng, and link-type specific
+ *   decoding down to the UDP payload.
+ */
+
+#include "PcapReader.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    constexpr uint32_t kPcapMagicMicro = 0xA1B2C3D4;
+    constexpr uint32_t kPcapMagicNano = 0xA1B23C4D;
+    constexpr size_t kPcapFileHeaderSize = 24;
+    constexpr size_t kPcapRecordHeaderSize = 16;
+
+    constexpr uint32_t kBlockSectionHeader = 0x0A0D0D0A;
+    constexpr uint32_t kBlockInterfaceDescription = 1;
+    constexpr uint32_t kBlockPacket = 2; // Obsolete, still written by old tools
+    constexpr uint32_t kBlockSimplePacket = 3;
+    constexpr uint32_t kBlockEnhancedPacket = 6;
+    constexpr uint32_t kByteOrderMagic = 0x1A2B3C4D;
+    constexpr uint16_t kOptionEnd = 0;
+    constexpr uint16_t kOptionTsResol = 9;
+
+    uint32_t load_host32(const uint8_t *p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    size_t pad4(size_t length) {
+        return (length + 3) & ~static_cast<size_t>(3);
+    }
+}
+
+namespace equix_md {
+
+PcapReader::PcapReader(const std::string &path) : path_(path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open capture " + path + ": " + std::string(strerror(errno)));
+    }
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(kPcapFileHeaderSize)) {
+        close(fd);
+        throw std::runtime_error("Capture " + path + " is empty or unreadable");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void *mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap capture " + path + ": " + std::string(strerror(errno)));
+    }
+    data_ = static_cast<const uint8_t *>(mapped);
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+
+    uint32_t magic = load_host32(data_);
+    if (magic == kPcapMagicMicro || magic == kPcapMagicNano) {
+        swapped_ = false;
+    } else if (__builtin_bswap32(magic) == kPcapMagicMicro || __builtin_bswap32(magic) == kPcapMagicNano) {
+        swapped_ = true;
+        magic = __builtin_bswap32(magic);
+    } else if (magic == kBlockSectionHeader) {
+        pcapng_ = true;
+    } else {
+        munmap(mapped, size_);
+        throw std::runtime_error("Capture " + path + " is neither pcap nor pcapng");
+    }
+
+    if (pcapng_) {
+        first_record_ = 0; // Section header blocks are parsed as they are met.
+    } else {
+        nanosecond_ = magic == kPcapMagicNano;
+        link_type_ = static_cast<uint16_t>(read32(data_ + 20));
+        first_record_ = kPcapFileHeaderSize;
+    }
+    offset_ = first_record_;
+}
+
+PcapReader::~PcapReader() {
+    if (data_ != nullptr) munmap(const_cast<uint8_t *>(data_), size_);
+}
+
+void PcapReader::rewind() {
+    offset_ = first_record_;
+    interfaces_.clear();
+}
+
+bool PcapReader::next(PcapFrame &frame) {
+    return pcapng_ ? next_pcapng(frame) : next_pcap(frame);
+}
+
+bool PcapReader::next_udp(UdpDatagramView &datagram, uint64_t &timestamp_ns) {
+    PcapFrame frame;
+    while (next(frame)) {
+        if (decode_udp(frame, datagram)) {
+            timestamp_ns = frame.timestamp_ns;
+            return true;
+        }
+        ++skipped_frames_;
+    }
+    return false;
+}
+
+bool PcapReader::next_pcap(PcapFrame &frame) {
+    if (offset_ + kPcapRecordHeaderSize > size_) return false;
+    const uint8_t *record = data_ + offset_;
+    uint32_t seconds = read32(record);
+    uint32_t fraction = read32(record + 4);
+    uint32_t captured = read32(record + 8);
+    uint32_t original = read32(record + 12);
+    if (offset_ + kPcapRecordHeaderSize + captured > size_) {
+        std::cerr << "[PcapReader] " << path_ << ": truncated record at offset " << offset_ << std::endl;
+        offset_ = size_;
+        return false;
+    }
+    frame.timestamp_ns = static_cast<uint64_t>(seconds) * 1000000000ull +
+                         (nanosecond_ ? fraction : static_cast<uint64_t>(fraction) * 1000ull);
+    frame.data = record + kPcapRecordHeaderSize;
+    frame.captured_length = captured;
+    frame.original_length = original;
+    frame.link_type = link_type_;
+    offset_ += kPcapRecordHeaderSize + captured;
+    return true;
+}
+
+bool PcapReader::next_pcapng(PcapFrame &frame) {
+    while (offset_ + 12 <= size_) {
+        const uint8_t *block = data_ + offset_;
+        uint32_t type = load_host32(block); // Section header type is byte-order independent
+        if (type == kBlockSectionHeader) {
+            // The section header carries the byte-order magic for everything up to the next section.
+            uint32_t byte_order = load_host32(block + 8);
+            swapped_ = byte_order != kByteOrderMagic;
+            if (swapped_ && __builtin_bswap32(byte_order) != kByteOrderMagic) {
+                std::cerr << "[PcapReader] " << path_ << ": bad section header at offset " << offset_ << std::endl;
+                offset_ = size_;
+                return false;
+            }
+        } else {
+            type = read32(block);
+        }
+        uint32_t block_length = read32(block + 4);
+        if (block_length < 12 || offset_ + block_length > size_) {
+            std::cerr << "[PcapReader] " << path_ << ": truncated block at offset " << offset_ << std::endl;
+            offset_ = size_;
+            return false;
+        }
+        offset_ += block_length;
+
+        const uint8_t *body = block + 8;
+        const uint32_t body_length = block_length - 12;
+        switch (type) {
+            case kBlockSectionHeader:
+                interfaces_.clear(); // Interface ids restart in every section
+                break;
+            case kBlockInterfaceDescription:
+                parse_interface_description(body, body_length);
+                break;
+            case kBlockEnhancedPacket:
+            case kBlockPacket: {
+                if (body_length < 20) break;
+                uint32_t interface_id = type == kBlockEnhancedPacket ? read32(body) : read16(body);
+                uint64_t ticks = (static_cast<uint64_t>(read32(body + 4)) << 32) | read32(body + 8);
+                uint32_t captured = read32(body + 12);
+                if (captured > body_length - 20) break;
+                frame.timestamp_ns = pcapng_timestamp_ns(interface_id, ticks);
+                frame.data = body + 20;
+                frame.captured_length = captured;
+                frame.original_length = read32(body + 16);
+                frame.link_type = interface_id < interfaces_.size() ? interfaces_[interface_id].link_type
+                                                                    : kLinkTypeEthernet;
+                return true;
+            }
+            case kBlockSimplePacket: {
+                if (body_length < 4) break;
+                uint32_t original = read32(body);
+                frame.timestamp_ns = 0;
+                frame.data = body + 4;
+                frame.original_length = original;
+                frame.captured_length = std::min<uint32_t>(original, body_length - 4);
+                frame.link_type = interfaces_.empty() ? kLinkTypeEthernet : interfaces_[0].link_type;
+                return true;
+            }
+            default:
+                break; // Statistics, name resolution, custom blocks...
+        }
+    }
+    return false;
+}
+
+void PcapReader::parse_interface_description(const uint8_t *body, uint32_t body_length) {
+    Interface interface;
+    if (body_length >= 8) {
+        interface.link_type = read16(body);
+        // Options: code(2) length(2) value padded to 4 bytes.
+        size_t pos = 8;
+        while (pos + 4 <= body_length) {
+            uint16_t code = read16(body + pos);
+            uint16_t length = read16(body + pos + 2);
+            if (code == kOptionEnd || pos + 4 + length > body_length) break;
+            if (code == kOptionTsResol && length >= 1) {
+                uint8_t resolution = body[pos + 4];
+                interface.ts_power_of_two = (resolution & 0x80) != 0;
+                interface.ts_exponent = resolution & 0x7F;
+            }
+            pos += 4 + pad4(length);
+        }
+    }
+    interfaces_.push_back(interface);
+}
+
+uint64_t PcapReader::pcapng_timestamp_ns(uint32_t interface_id, uint64_t ticks) const {
+    Interface interface = interface_id < interfaces_.size() ? interfaces_[interface_id] : Interface{};
+    if (interface.ts_power_of_two) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(ticks) * 1000000000u) >> interface.ts_exponent);
+    }
+    uint64_t scale = 1;
+    if (interface.ts_exponent <= 9) {
+        for (uint8_t i = interface.ts_exponent; i < 9; ++i) scale *= 10;
+        return ticks * scale;
+    }
+    for (uint8_t i = 9; i < interface.ts_exponent && i < 28; ++i) scale *= 10;
+    return ticks / scale;
+}
+
+bool PcapReader::decode_udp(const PcapFrame &frame, UdpDatagramView &datagram) {
+    const uint8_t *data = frame.data;
+    const size_t length = frame.captured_length;
+    switch (frame.link_type) {
+        case kLinkTypeEthernet:
+            return net::parse_ethernet_udp(data, length, datagram);
+        case kLinkTypeRaw:
+        case 12:
+        case kLinkTypeIPv4:
+            return net::parse_ipv4_udp(data, length, datagram);
+        case kLinkTypeLinuxSll:
+            // 16-byte cooked header, protocol in the last two bytes.
+            return length > 16 && net::load_be16(data + 14) == net::kEtherTypeIPv4 &&
+                   net::parse_ipv4_udp(data + 16, length - 16, datagram);
+        case kLinkTypeLinuxSll2:
+            // 20-byte cooked header, protocol first.
+            return length > 20 && net::load_be16(data) == net::kEtherTypeIPv4 &&
+                   net::parse_ipv4_udp(data + 20, length - 20, datagram);
+        case kLinkTypeNull: {
+            // Address family in the capturing host's byte order; AF_INET is 2 everywhere.
+            if (length <= 4) return false;
+            uint32_t family = load_host32(data);
+            if (family != 2 && __builtin_bswap32(family) != 2) return false;
+            return net::parse_ipv4_udp(data + 4, length - 4, datagram);
+        }
+        default:
+            return false;
+    }
+}
+
+uint16_t PcapReader::read16(const uint8_t *p) const {
+    uint16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return swapped_ ? __builtin_bswap16(value) : value;
+}
+
+uint32_t PcapReader::read32(const uint8_t *p) const {
+    uint32_t value = load_host32(p);
+    return swapped_ ? __builtin_bswap32(value) : value;
+}
+
+} // namespace equix_md
@@ -0,0 +1,179 @@
+/**
+ * @file    PcapSource.cpp
+ * @brief   Capture-file packet source implementation.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: PcapSource.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Replay thread: reads UDP datagrams from a PcapReader, copies them into
+ *   pool buffers, paces them if asked and hands them over in batches.
+ */
+
+#include "PcapSource.hpp"
+#include "PcapReader.hpp"
+#include "LatencyStats.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+using equix_md::PacketRef;
+using equix_md::PcapReader;
+
+namespace {
+
+    /// Sleep for most of the wait, then spin the last stretch for accurate release times.
+    void wait_until_ns(uint64_t deadline_ns, const std::atomic<bool> &running) {
+        constexpr uint64_t kSpinNs = 100000;
+        for (;;) {
+            uint64_t now = equix_md::monotonic_now_ns();
+            if (now >= deadline_ns || !running.load(std::memory_order_relaxed)) return;
+            uint64_t remaining = deadline_ns - now;
+            if (remaining > kSpinNs) std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - kSpinNs));
+        }
+    }
+}
+
+PcapSource::PcapSource(const Config &config, equix_md::PacketBufferPool &pool) : config_(config), pool_(pool) {
+    if (config_.batch_size == 0) config_.batch_size = 1;
+    if (config_.speed <= 0) config_.speed = 1.0;
+}
+
+PcapSource::~PcapSource() {
+    stop();
+}
+
+void PcapSource::start(UdpReceiver::BatchPacketCallback callback) {
+    if (running_) return;
+    // Open here so a bad path fails the caller, not the thread.
+    auto reader = std::make_shared<PcapReader>(config_.file);
+    std::cout << "[PcapSource] Replaying " << config_.file << " (" << (reader->is_pcapng() ? "pcapng" : "pcap")
+              << ", pacing " << pacing_name(config_.pacing);
+    if (config_.pacing == Pacing::Original) std::cout << " x" << config_.speed;
+    std::cout << ", loops " << config_.loops << ")" << std::endl;
+
+    running_ = true;
+    finished_ = false;
+    thread_ = std::thread([this, callback, reader]() {
+        UdpReceiver::pin_current_thread(config_.cpu_affinity_core);
+        run_reader(*reader, callback);
+    });
+}
+
+void PcapSource::run_reader(PcapReader &reader, const UdpReceiver::BatchPacketCallback &callback) {
+    std::vector<UdpReceiver::Packet> batch(config_.batch_size);
+    size_t pending = 0;
+    auto flush = [&]() {
+        if (pending == 0) return;
+        callback(batch.data(), pending);
+        for (size_t i = 0; i < pending; ++i) batch[i].buffer.reset();
+        pending = 0;
+    };
+
+    const uint64_t start_ns = equix_md::monotonic_now_ns();
+    started_ns_.store(start_ns, std::memory_order_relaxed);
+    uint64_t first_capture_ns = 0;
+    uint64_t loop_offset_ns = 0; // Keeps pacing continuous across loops
+    uint64_t last_capture_ns = 0;
+
+    for (uint32_t loop = 0; running_ && (config_.loops == 0 || loop < config_.loops); ++loop) {
+        if (loop > 0) {
+            reader.rewind();
+            loop_offset_ns += last_capture_ns - first_capture_ns;
+            first_capture_ns = 0;
+        }
+
+        equix_md::UdpDatagramView datagram;
+        uint64_t capture_ns = 0;
+        while (running_ && reader.next_udp(datagram, capture_ns)) {
+            if (!config_.ports.empty() &&
+                std::find(config_.ports.begin(), config_.ports.end(), datagram.dst_port) == config_.ports.end()) {
+                bump(filtered_, 1);
+                continue;
+            }
+            if (datagram.payload_size > equix_md::PacketBuffer::kCapacity) continue;
+
+            if (config_.pacing == Pacing::Original && capture_ns != 0) {
+                if (first_capture_ns == 0) first_capture_ns = capture_ns;
+                last_capture_ns = capture_ns;
+                uint64_t offset = loop_offset_ns + (capture_ns - first_capture_ns);
+                uint64_t due_ns = start_ns + static_cast<uint64_t>(static_cast<double>(offset) / config_.speed);
+                // Release what is already due before waiting for this datagram.
+                if (equix_md::monotonic_now_ns() < due_ns) {
+                    flush();
+                    wait_until_ns(due_ns, running_);
+                }
+            }
+
+            PacketRef buffer = pool_.acquire();
+            while (!buffer && running_) {
+                // Downstream still holds every buffer: hand over what we have and wait for releases.
+                flush();
+                std::this_thread::yield();
+                buffer = pool_.acquire();
+            }
+            if (!buffer) break;
+
+            std::memcpy(buffer->data, datagram.payload, datagram.payload_size);
+            buffer->size = datagram.payload_size;
+            buffer->rx_timestamp_ns = equix_md::realtime_now_ns();
+            UdpReceiver::Packet &packet = batch[pending++];
+            packet.data = reinterpret_cast<const char *>(buffer->data);
+            packet.size = buffer->size;
+            packet.buffer = std::move(buffer);
+            bump(packets_, 1);
+            bump(bytes_, datagram.payload_size);
+            if (pending == batch.size()) flush();
+        }
+        flush();
+        if (running_) bump(loops_, 1);
+    }
+
+    finished_ns_.store(equix_md::monotonic_now_ns(), std::memory_order_relaxed);
+    finished_.store(true, std::memory_order_release);
+    Stats done = stats();
+    double seconds = static_cast<double>(done.elapsed_ns) / 1e9;
+    std::cout << "[PcapSource] Finished " << config_.file << ": " << done.packets << " datagrams, " << done.bytes
+              << " bytes in " << seconds << " s (" << (seconds > 0 ? static_cast<double>(done.packets) / seconds : 0.0)
+              << " pkt/s)";
+    if (reader.skipped_frames() > 0) std::cout << ", " << reader.skipped_frames() << " non-UDP frames skipped";
+    std::cout << std::endl;
+}
+
+void PcapSource::stop() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+PcapSource::Stats PcapSource::stats() const {
+    Stats snapshot;
+    snapshot.packets = packets_.load(std::memory_order_relaxed);
+    snapshot.bytes = bytes_.load(std::memory_order_relaxed);
+    snapshot.filtered = filtered_.load(std::memory_order_relaxed);
+    snapshot.loops = loops_.load(std::memory_order_relaxed);
+    snapshot.finished = finished_.load(std::memory_order_acquire);
+    uint64_t started = started_ns_.load(std::memory_order_relaxed);
+    uint64_t end = snapshot.finished ? finished_ns_.load(std::memory_order_relaxed) : equix_md::monotonic_now_ns();
+    snapshot.elapsed_ns = started != 0 && end > started ? end - started : 0;
+    return snapshot;
+}
+
+std::optional<PcapSource::Pacing> PcapSource::pacing_from_string(const std::string &name) {
+    if (name == "fast") return Pacing::Fast;
+    if (name == "original") return Pacing::Original;
+    return std::nullopt;
+}
+
+const char *PcapSource::pacing_name(Pacing pacing) {
+    switch (pacing) {
+        case Pacing::Fast: return "fast";
+        case Pacing::Original: return "original";
+    }
+    return "unknown";
+}
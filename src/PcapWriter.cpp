@@ -0,0 +1,126 @@
+/**
+ * @file    PcapWriter.cpp
+ * @brief   Classic pcap writer implementation.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: PcapWriter.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Frame layout: 14-byte Ethernet II header (locally administered MACs),
+ *   20-byte IPv4 header without options, 8-byte UDP header, payload. File
+ *   and record headers are written in host byte order, as readers expect.
+ */
+
+#include "PcapWriter.hpp"
+#include "NetHeaders.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr uint32_t kPcapMagicNano = 0xA1B23C4D;
+    constexpr uint32_t kSnapLength = 65535;
+    constexpr uint32_t kLinkTypeEthernet = 1;
+    constexpr size_t kIpv4HeaderSize = 20;
+    constexpr size_t kFrameHeaderSize =
+            equix_md::net::kEthernetHeaderSize + kIpv4HeaderSize + equix_md::net::kUdpHeaderSize;
+
+    void store_be16(uint8_t *p, uint16_t value) {
+        p[0] = static_cast<uint8_t>(value >> 8);
+        p[1] = static_cast<uint8_t>(value);
+    }
+
+    uint16_t ipv4_checksum(const uint8_t *header) {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < kIpv4HeaderSize; i += 2) sum += equix_md::net::load_be16(header + i);
+        while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+        return static_cast<uint16_t>(~sum);
+    }
+}
+
+namespace equix_md {
+
+PcapWriter::PcapWriter(const std::string &path) : path_(path) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw std::runtime_error("Failed to create capture " + path + ": " + std::string(strerror(errno)));
+    }
+    struct {
+        uint32_t magic = kPcapMagicNano;
+        uint16_t version_major = 2;
+        uint16_t version_minor = 4;
+        int32_t thiszone = 0;
+        uint32_t sigfigs = 0;
+        uint32_t snaplen = kSnapLength;
+        uint32_t network = kLinkTypeEthernet;
+    } header;
+    static_assert(sizeof(header) == 24, "pcap file header");
+    write(&header, sizeof(header));
+}
+
+PcapWriter::~PcapWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructor: the error was already reported by a failed write or is unrecoverable
+    }
+}
+
+void PcapWriter::write_udp(const uint8_t *payload, size_t size, uint64_t timestamp_ns, const Endpoint &source,
+                           const Endpoint &destination) {
+    if (size > 0xFFFF - kIpv4HeaderSize - net::kUdpHeaderSize) {
+        throw std::runtime_error("Datagram of " + std::to_string(size) + " bytes does not fit an IPv4 packet");
+    }
+    uint8_t frame[kFrameHeaderSize] = {};
+
+    // Ethernet: locally administered unicast MACs, IPv4 EtherType
+    const uint8_t dst_mac[6] = {0x02, 0, 0, 0, 0, 0x02};
+    const uint8_t src_mac[6] = {0x02, 0, 0, 0, 0, 0x01};
+    std::memcpy(frame, dst_mac, 6);
+    std::memcpy(frame + 6, src_mac, 6);
+    store_be16(frame + 12, net::kEtherTypeIPv4);
+
+    uint8_t *ip = frame + net::kEthernetHeaderSize;
+    ip[0] = 0x45; // Version 4, 5 words
+    store_be16(ip + 2, static_cast<uint16_t>(kIpv4HeaderSize + net::kUdpHeaderSize + size));
+    store_be16(ip + 4, ip_id_++);
+    ip[8] = 64; // TTL
+    ip[9] = net::kIpProtoUdp;
+    std::memcpy(ip + 12, &source.ip, 4);
+    std::memcpy(ip + 16, &destination.ip, 4);
+    store_be16(ip + 10, ipv4_checksum(ip));
+
+    uint8_t *udp = ip + kIpv4HeaderSize;
+    store_be16(udp, source.port);
+    store_be16(udp + 2, destination.port);
+    store_be16(udp + 4, static_cast<uint16_t>(net::kUdpHeaderSize + size));
+
+    const uint32_t frame_size = static_cast<uint32_t>(kFrameHeaderSize + size);
+    const uint32_t record[4] = {static_cast<uint32_t>(timestamp_ns / 1000000000ULL),
+                                static_cast<uint32_t>(timestamp_ns % 1000000000ULL), frame_size, frame_size};
+    write(record, sizeof(record));
+    write(frame, sizeof(frame));
+    write(payload, size);
+    ++packets_;
+    bytes_ += frame_size;
+}
+
+void PcapWriter::close() {
+    if (file_ == nullptr) return;
+    std::FILE *file = file_;
+    file_ = nullptr;
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("Failed to close capture " + path_ + ": " + std::string(strerror(errno)));
+    }
+}
+
+void PcapWriter::write(const void *data, size_t size) {
+    if (file_ == nullptr) throw std::runtime_error("Capture " + path_ + " is closed");
+    if (size != 0 && std::fwrite(data, 1, size, file_) != size) {
+        throw std::runtime_error("Failed to write capture " + path_ + ": " + std::string(strerror(errno)));
+    }
+}
+
+} // namespace equix_md
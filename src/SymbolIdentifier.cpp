@@ -8,7 +8,8 @@
  * Created: 28/May/2025
  *
  * Description:
- *   Implements fast, non-thread-safe mapping from order IDs to symbols.
+ *   Implements fast mapping from order IDs to symbols, striped over kShards
+ *   maps with one mutex each.
  */
 
 #include "SymbolIdentifier.hpp"
@@ -20,25 +21,29 @@ namespace equix_md {
  */
 SymbolIdentifier::SymbolIdentifier(size_t estimated_mapping_count) {
     if (estimated_mapping_count > 0)
-        order_to_symbol_map_.reserve(estimated_mapping_count);
+        reserve(estimated_mapping_count);
 }
 
 /**
- * @brief Adds a mapping from order_id to symbol_name, if not already present.
+ * @brief Adds a mapping from order_id to symbol, if not already present.
  * @return True if inserted, false if already present.
  */
-bool SymbolIdentifier::add_mapping(uint64_t order_id, const std::string& symbol_name) {
-    auto [it, inserted] = order_to_symbol_map_.emplace(order_id, symbol_name);
+bool SymbolIdentifier::add_mapping(uint64_t order_id, Symbol symbol) {
+    Shard &shard = shard_for(order_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto [it, inserted] = shard.order_to_symbol_map.emplace(order_id, symbol);
     return inserted;
 }
 
 /**
  * @brief Looks up the symbol name associated with order_id.
- * @return Optional symbol string if found, std::nullopt otherwise.
+ * @return Optional symbol if found, std::nullopt otherwise.
  */
-std::optional<std::string> SymbolIdentifier::find_symbol(uint64_t order_id) const {
-    auto it = order_to_symbol_map_.find(order_id);
-    if (it != order_to_symbol_map_.end())
+std::optional<Symbol> SymbolIdentifier::find_symbol(uint64_t order_id) const {
+    const Shard &shard = shard_for(order_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.order_to_symbol_map.find(order_id);
+    if (it != shard.order_to_symbol_map.end())
         return it->second;
     return std::nullopt;
 }
@@ -48,21 +53,32 @@ std::optional<std::string> SymbolIdentifier::find_symbol(uint64_t order_id) cons
  * @return True if the mapping existed and was erased.
  */
 bool SymbolIdentifier::remove_mapping(uint64_t order_id) {
-    return order_to_symbol_map_.erase(order_id) > 0;
+    Shard &shard = shard_for(order_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.order_to_symbol_map.erase(order_id) > 0;
 }
 
 /**
- * @brief Returns the current number of stored mappings.
+ * @brief Returns the current number of stored mappings (summed stripe by stripe, not a single snapshot).
  */
 size_t SymbolIdentifier::mapping_count() const {
-    return order_to_symbol_map_.size();
+    size_t count = 0;
+    for (const Shard &shard: shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.order_to_symbol_map.size();
+    }
+    return count;
 }
 
 /**
- * @brief Reserves space for at least min_capacity mappings to optimize future insertions.
+ * @brief Reserves space for at least min_capacity mappings, spread evenly over the stripes.
  */
 void SymbolIdentifier::reserve(size_t min_capacity) {
-    order_to_symbol_map_.reserve(min_capacity);
+    const size_t per_shard = (min_capacity + kShards - 1) / kShards;
+    for (Shard &shard: shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.order_to_symbol_map.reserve(per_shard);
+    }
 }
 
 } // namespace equix_md
@@ -0,0 +1,183 @@
+/**
+ * @file    SyntheticFeed.cpp
+ * @brief   Synthetic PITCH feed generator implementation.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: SyntheticFeed.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Each step draws an operation from the configured mix, encodes it into
+ *   the packet of the unit owning its symbol and hands out that packet once
+ *   it reaches messages_per_packet (or cannot take the next message).
+ *   Executes, modifies, reductions and deletes pick a live order uniformly;
+ *   since adds follow the Zipf symbol distribution, so does the book.
+ */
+
+#include "SyntheticFeed.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace equix_md {
+
+namespace {
+    constexpr int64_t kTick = CboePitch::Price::SCALE / 100; // 0.01
+    constexpr uint32_t kRoundLot = 100;
+}
+
+SyntheticFeed::SyntheticFeed(const Config &config)
+    : config_(config), rng_(config.seed), timestamp_ns_(config.start_timestamp_ns) {
+    if (config_.symbols == 0 || config_.symbols > kMaxSymbols) {
+        throw std::invalid_argument("SyntheticFeed: symbols must be 1.." + std::to_string(kMaxSymbols));
+    }
+    if (config_.units == 0) throw std::invalid_argument("SyntheticFeed: at least one unit is required");
+    if (std::accumulate(config_.mix.begin(), config_.mix.end(), uint64_t{0}) == 0) {
+        throw std::invalid_argument("SyntheticFeed: operation mix is all zero");
+    }
+    if (config_.messages_per_packet == 0) config_.messages_per_packet = 1;
+
+    symbols_.reserve(config_.symbols);
+    reference_prices_.reserve(config_.symbols);
+    cdf_.reserve(config_.symbols);
+    double total = 0;
+    for (size_t rank = 0; rank < config_.symbols; ++rank) {
+        symbols_.push_back(symbol_name(rank));
+        // $1.00 .. $500.00 on a cent grid
+        reference_prices_.push_back(CboePitch::Price::fromRaw(static_cast<int64_t>(100 + rng_() % 49900) * kTick));
+        total += 1.0 / std::pow(static_cast<double>(rank + 1), config_.zipf_exponent);
+        cdf_.push_back(total);
+    }
+    for (double &weight: cdf_) weight /= total;
+
+    operation_dist_ = std::discrete_distribution<size_t>(config_.mix.begin(), config_.mix.end());
+    encoders_.reserve(config_.units);
+    for (unsigned unit = 1; unit <= config_.units; ++unit) // unsigned: a uint8_t counter wraps at 255 units
+        encoders_.emplace_back(static_cast<uint8_t>(unit), config_.first_sequence, config_.max_packet_size);
+}
+
+Symbol SyntheticFeed::symbol_name(size_t rank) {
+    char text[Symbol::kMaxLength];
+    size_t length = 0;
+    for (size_t n = rank + 1; n > 0 && length < Symbol::kWireLength; n = (n - 1) / 26)
+        text[length++] = static_cast<char>('A' + (n - 1) % 26);
+    std::reverse(text, text + length);
+    return Symbol(std::string_view(text, length));
+}
+
+SyntheticFeed::Datagram SyntheticFeed::next() {
+    has_ready_ = false;
+    while (!has_ready_) {
+        auto operation = static_cast<Operation>(operation_dist_(rng_));
+        if (live_.empty() && operation != kTrade) operation = kAdd;
+        if (operation == kAdd && live_.size() >= config_.max_live_orders) operation = kDelete;
+        timestamp_ns_ += config_.message_gap_ns;
+        const size_t unit_index = generate(operation, timestamp_ns_);
+        if (!has_ready_ && encoders_[unit_index].count() >= config_.messages_per_packet) emit(unit_index);
+    }
+    return ready_;
+}
+
+size_t SyntheticFeed::generate(Operation operation, uint64_t timestamp_ns) {
+    using namespace CboePitch;
+    ++messages_;
+    ++operations_[operation];
+    const std::string_view no_participant;
+
+    if (operation == kAdd || operation == kTrade) {
+        const size_t symbol = pick_symbol();
+        const size_t unit_index = unit_of(symbol) - 1;
+        const uint32_t quantity = pick_quantity();
+        const Price price = pick_price(static_cast<uint32_t>(symbol));
+        if (operation == kTrade) {
+            append<TradeLayout>(unit_index, timestamp_ns, symbols_[symbol], quantity, price, next_execution_id_++,
+                                uint64_t{0}, uint64_t{0}, no_participant, no_participant, 'N', 'P', ' ',
+                                uint64_t{0}, uint8_t{0});
+        } else {
+            const Order order{next_order_id_++, static_cast<uint32_t>(symbol), quantity, price,
+                              (rng_() & 1) ? 'B' : 'S'};
+            live_.push_back(order);
+            append<AddOrderLayout>(unit_index, timestamp_ns, order.id, order.side, order.quantity, symbols_[symbol],
+                                   order.price, no_participant);
+        }
+        return unit_index;
+    }
+
+    const size_t index = rng_() % live_.size();
+    Order &order = live_[index];
+    const size_t unit_index = unit_of(order.symbol) - 1;
+    bool filled = false;
+    switch (operation) {
+        case kExecute: {
+            const uint32_t executed = std::min(order.quantity, pick_quantity());
+            append<OrderExecutedLayout>(unit_index, timestamp_ns, order.id, executed, next_execution_id_++,
+                                        uint64_t{0}, no_participant);
+            order.quantity -= executed;
+            filled = order.quantity == 0;
+            break;
+        }
+        case kModify:
+            order.quantity = pick_quantity();
+            order.price = pick_price(order.symbol);
+            append<ModifyOrderLayout>(unit_index, timestamp_ns, order.id, order.quantity, order.price, uint8_t{0});
+            break;
+        case kReduce:
+            if (order.quantity > kRoundLot) {
+                const uint32_t cancelled = std::min(order.quantity - kRoundLot, pick_quantity());
+                append<ReduceSizeLayout>(unit_index, timestamp_ns, order.id, cancelled);
+                order.quantity -= cancelled;
+                break;
+            }
+            [[fallthrough]]; // Nothing left to reduce: cancel the order instead
+        default:
+            append<DeleteOrderLayout>(unit_index, timestamp_ns, order.id);
+            filled = true;
+            break;
+    }
+    if (filled) {
+        live_[index] = live_.back();
+        live_.pop_back();
+    }
+    return unit_index;
+}
+
+template<typename Layout, typename... Values>
+void SyntheticFeed::append(size_t unit_index, Values &&... values) {
+    CboePitch::SequencedUnitEncoder &encoder = encoders_[unit_index];
+    if (!encoder.fits(Layout::SIZE)) emit(unit_index);
+    encoder.template add<Layout>(std::forward<Values>(values)...);
+}
+
+void SyntheticFeed::emit(size_t unit_index) {
+    CboePitch::SequencedUnitEncoder &encoder = encoders_[unit_index];
+    std::copy(encoder.data(), encoder.data() + encoder.size(), out_.begin());
+    ready_.data = out_.data();
+    ready_.size = encoder.size();
+    ready_.unit = encoder.unit();
+    ready_.sequence = encoder.sequence();
+    ready_.messages = encoder.count();
+    ready_.timestamp_ns = timestamp_ns_;
+    has_ready_ = true;
+    encoder.reset();
+}
+
+size_t SyntheticFeed::pick_symbol() {
+    const double u = static_cast<double>(rng_() >> 11) * 0x1.0p-53; // [0, 1)
+    const size_t index = static_cast<size_t>(std::upper_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin());
+    return std::min(index, cdf_.size() - 1);
+}
+
+CboePitch::Price SyntheticFeed::pick_price(uint32_t symbol) {
+    const int64_t ticks = static_cast<int64_t>(rng_() % 41) - 20; // Within 20 cents of the reference
+    return reference_prices_[symbol] + CboePitch::Price::fromRaw(ticks * kTick);
+}
+
+uint32_t SyntheticFeed::pick_quantity() {
+    return kRoundLot * static_cast<uint32_t>(1 + rng_() % 20);
+}
+
+} // namespace equix_md
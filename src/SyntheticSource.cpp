@@ -0,0 +1,117 @@
+/**
+ * @file    SyntheticSource.cpp
+ * @brief   Synthetic feed packet source implementation.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: SyntheticSource.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Generator thread: takes datagrams from the SyntheticFeed, copies them
+ *   into pool buffers, paces them if asked and hands them over in batches.
+ */
+
+#include "SyntheticSource.hpp"
+#include "LatencyStats.hpp"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using equix_md::PacketRef;
+
+SyntheticSource::SyntheticSource(const Config &config, equix_md::PacketBufferPool &pool)
+    : config_(config), pool_(pool), feed_(config.feed) {
+    if (config_.batch_size == 0) config_.batch_size = 1;
+}
+
+SyntheticSource::~SyntheticSource() {
+    stop();
+}
+
+void SyntheticSource::start(UdpReceiver::BatchPacketCallback callback) {
+    if (running_) return;
+    std::cout << "[SyntheticSource] Generating " << config_.feed.symbols << " symbols over "
+              << static_cast<int>(config_.feed.units) << " unit(s), zipf s=" << config_.feed.zipf_exponent
+              << ", " << (config_.rate_pps ? std::to_string(config_.rate_pps) + " pkt/s" : std::string("fast"))
+              << ", packets " << config_.packets << std::endl;
+    running_ = true;
+    finished_ = false;
+    thread_ = std::thread([this, callback]() {
+        UdpReceiver::pin_current_thread(config_.cpu_affinity_core);
+        run(callback);
+    });
+}
+
+void SyntheticSource::run(const UdpReceiver::BatchPacketCallback &callback) {
+    std::vector<UdpReceiver::Packet> batch(config_.batch_size);
+    size_t pending = 0;
+    auto flush = [&]() {
+        if (pending == 0) return;
+        callback(batch.data(), pending);
+        for (size_t i = 0; i < pending; ++i) batch[i].buffer.reset();
+        pending = 0;
+    };
+
+    const uint64_t start_ns = equix_md::monotonic_now_ns();
+    started_ns_.store(start_ns, std::memory_order_relaxed);
+    for (uint64_t sent = 0; running_ && (config_.packets == 0 || sent < config_.packets); ++sent) {
+        if (config_.rate_pps != 0) {
+            const uint64_t due_ns = start_ns + sent * 1000000000ULL / config_.rate_pps;
+            if (equix_md::monotonic_now_ns() < due_ns) {
+                flush();
+                while (running_ && equix_md::monotonic_now_ns() < due_ns) std::this_thread::yield();
+            }
+        }
+
+        PacketRef buffer = pool_.acquire();
+        while (!buffer && running_) {
+            // Downstream still holds every buffer: hand over what we have and wait for releases.
+            flush();
+            std::this_thread::yield();
+            buffer = pool_.acquire();
+        }
+        if (!buffer) break;
+
+        const equix_md::SyntheticFeed::Datagram datagram = feed_.next();
+        std::memcpy(buffer->data, datagram.data, datagram.size);
+        buffer->size = datagram.size;
+        buffer->rx_timestamp_ns = equix_md::realtime_now_ns();
+        UdpReceiver::Packet &packet = batch[pending++];
+        packet.data = reinterpret_cast<const char *>(buffer->data);
+        packet.size = buffer->size;
+        packet.buffer = std::move(buffer);
+        bump(packets_, 1);
+        bump(bytes_, datagram.size);
+        bump(messages_, datagram.messages);
+        if (pending == batch.size()) flush();
+    }
+    flush();
+
+    finished_ns_.store(equix_md::monotonic_now_ns(), std::memory_order_relaxed);
+    finished_.store(true, std::memory_order_release);
+    Stats done = stats();
+    double seconds = static_cast<double>(done.elapsed_ns) / 1e9;
+    std::cout << "[SyntheticSource] Finished: " << done.packets << " datagrams, " << done.messages << " messages in "
+              << seconds << " s (" << (seconds > 0 ? static_cast<double>(done.packets) / seconds : 0.0)
+              << " pkt/s), " << feed_.live_orders() << " orders live" << std::endl;
+}
+
+void SyntheticSource::stop() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+SyntheticSource::Stats SyntheticSource::stats() const {
+    Stats snapshot;
+    snapshot.packets = packets_.load(std::memory_order_relaxed);
+    snapshot.bytes = bytes_.load(std::memory_order_relaxed);
+    snapshot.messages = messages_.load(std::memory_order_relaxed);
+    snapshot.finished = finished_.load(std::memory_order_acquire);
+    uint64_t started = started_ns_.load(std::memory_order_relaxed);
+    uint64_t end = snapshot.finished ? finished_ns_.load(std::memory_order_relaxed) : equix_md::monotonic_now_ns();
+    snapshot.elapsed_ns = started != 0 && end > started ? end - started : 0;
+    return snapshot;
+}
@@ -9,16 +9,21 @@
  *
  * Description:
  *   Implements the UdpReceiver class for receiving UDP packets asynchronously
- *   on a background thread, with support for CPU core affinity and real-time
- *   thread priority.
+ *   on a background thread, with support for batched receive (recvmmsg),
+ *   configurable idle strategies, CPU core affinity and real-time thread
+ *   priority.
  */
 
 #include "UdpReceiver.hpp"
+#include "NetHeaders.hpp"
+#include "IoUring.hpp"
+#include "SpinLock.hpp"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
@@ -27,13 +32,80 @@
 
 #ifdef __linux__
 #include <sched.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#else
+#include <poll.h>
+#endif
+
+namespace {
+#ifdef __linux__
+    /**
+     * Classic BPF program for a raw Ethernet socket: accept incoming, unfragmented
+     * IPv4/UDP frames whose destination port is `port`, drop everything else.
+     */
+    std::vector<sock_filter> udp_port_filter(uint16_t port) {
+        return {
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_PKTTYPE)),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, PACKET_OUTGOING, 9, 0),   // looped-back copy of our own send
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),                     // EtherType
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETHERTYPE_IP, 0, 7),
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 23),                     // IPv4 protocol
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, 5),
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 20),                     // Flags + fragment offset
+            BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x3FFF, 3, 0),
+            BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 14),                    // X = IPv4 header length
+            BPF_STMT(BPF_LD | BPF_H | BPF_IND, 16),                     // UDP destination port
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, port, 1, 0),
+            BPF_STMT(BPF_RET | BPF_K, 0),
+            BPF_STMT(BPF_RET | BPF_K, 0x40000),
+        };
+    }
 #endif
+}
 
 /**
- * @brief Constructs and binds the UDP socket to the specified IP and port.
+ * @brief Opens the configured backend: a bound UDP socket (receive buffer sized,
+ *        multicast group joined if configured) or an AF_PACKET TPACKET_V3 ring.
  */
-UdpReceiver::UdpReceiver(const Config &config)
-    : config_(config) {
+UdpReceiver::UdpReceiver(const Config &config, equix_md::PacketBufferPool &pool)
+    : config_(config), pool_(pool) {
+    if (config_.backend == Backend::PacketMmap) {
+        open_packet_ring();
+    } else {
+        open_udp_socket();
+        if (config_.backend == Backend::IoUring && !setup_uring()) {
+            config_.backend = Backend::Socket;
+        }
+    }
+
+    // Size the batch arrays once; the receive loop only swaps pool buffers in and out.
+    if (config_.batch_size == 0) config_.batch_size = 1;
+    batch_packets_.resize(config_.batch_size);
+#ifdef __linux__
+    batch_headers_.resize(config_.batch_size);
+    batch_iovecs_.resize(config_.batch_size);
+    batch_control_.resize(config_.batch_size * kControlBytes);
+    for (size_t i = 0; i < config_.batch_size; ++i) {
+        batch_headers_[i] = {};
+        batch_headers_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+        batch_headers_[i].msg_hdr.msg_iovlen = 1;
+        batch_headers_[i].msg_hdr.msg_control = batch_control_.data() + i * kControlBytes;
+    }
+#endif
+
+    setup_idle_strategy();
+}
+
+UdpReceiver::~UdpReceiver() {
+    stop();
+}
+
+void UdpReceiver::open_udp_socket() {
     socket_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
     if (socket_fd_ < 0) {
         throw std::runtime_error("Failed to create UDP socket: " + std::string(strerror(errno)));
@@ -43,25 +115,353 @@ UdpReceiver::UdpReceiver(const Config &config)
     int opt = 1;
     setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
 
+    // Size the kernel receive queue before any traffic arrives.
+    setup_receive_buffer();
+
+    // Multicast sockets bind to the group address so only that group's datagrams are delivered.
+    const bool is_multicast = !config_.multicast_group.empty();
     sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_port = htons(config_.bind_port);
-    addr.sin_addr.s_addr = inet_addr(config_.bind_ip.c_str());
+    addr.sin_addr.s_addr = inet_addr(is_multicast ? config_.multicast_group.c_str() : config_.bind_ip.c_str());
 
     if (bind(socket_fd_, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
         close(socket_fd_);
         throw std::runtime_error("Failed to bind UDP socket: " + std::string(strerror(errno)));
     }
 
+    if (is_multicast) {
+        try {
+            join_multicast_group(socket_fd_);
+        } catch (...) {
+            close(socket_fd_);
+            throw;
+        }
+    }
+
     // Set socket to non-blocking mode (for safe shutdown)
     fcntl(socket_fd_, F_SETFL, fcntl(socket_fd_, F_GETFL, 0) | O_NONBLOCK);
+
+    if (config_.kernel_timestamps) {
+#if defined(__linux__) && defined(SO_TIMESTAMPNS)
+        // Kernel stamps each datagram on arrival (CLOCK_REALTIME, ns) and returns it as a control message.
+        int on = 1;
+        if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) < 0) {
+            std::cerr << "[UdpReceiver] Failed to enable SO_TIMESTAMPNS on port " << config_.bind_port << ": "
+                      << strerror(errno) << "; using user-space receive timestamps." << std::endl;
+        }
+#else
+        std::cerr << "[UdpReceiver] Kernel receive timestamps not supported on this platform; "
+                  << "using user-space receive timestamps.\n";
+#endif
+    }
+
+#if defined(__linux__) && defined(SO_RXQ_OVFL)
+    // Each datagram then carries the socket's cumulative drop count (receive queue full, filter, ...).
+    int on = 1;
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on)) < 0) {
+        std::cerr << "[UdpReceiver] Failed to enable SO_RXQ_OVFL on port " << config_.bind_port << ": "
+                  << strerror(errno) << "; kernel drops will not be counted." << std::endl;
+    }
+#endif
 }
 
-UdpReceiver::~UdpReceiver() {
-    stop();
+void UdpReceiver::open_packet_ring() {
+#ifdef __linux__
+    unsigned int ifindex = if_nametoindex(config_.capture_interface.c_str());
+    if (ifindex == 0) {
+        throw std::runtime_error("Unknown capture interface '" + config_.capture_interface + "' for port " +
+                                 std::to_string(config_.bind_port));
+    }
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (config_.ring_block_bytes == 0 || config_.ring_block_bytes % page_size != 0 ||
+        config_.ring_block_bytes % kRingFrameSize != 0 || config_.ring_block_count == 0) {
+        throw std::runtime_error("ring_block_bytes must be a non-zero multiple of the page size and ring_block_count "
+                                 "must be non-zero (port " + std::to_string(config_.bind_port) + ")");
+    }
+
+    // Datagrams must be addressed to the group (or to bind_ip unless it is the wildcard).
+    ring_dst_ip_ = inet_addr(config_.multicast_group.empty() ? config_.bind_ip.c_str()
+                                                             : config_.multicast_group.c_str());
+
+    auto fail = [this](const std::string &what) {
+        std::string reason = strerror(errno);
+        close_descriptors();
+        throw std::runtime_error(what + " (port " + std::to_string(config_.bind_port) + "): " + reason);
+    };
+
+    // Protocol 0: nothing is queued until bind(), so no frame slips in before the filter is attached.
+    socket_fd_ = socket(AF_PACKET, SOCK_RAW, 0);
+    if (socket_fd_ < 0) fail("Failed to create AF_PACKET socket (needs CAP_NET_RAW)");
+
+    int version = TPACKET_V3;
+    if (setsockopt(socket_fd_, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+        fail("Failed to select TPACKET_V3");
+
+    // Kernel-side filter; frames are still checked in user space, so a rejected filter only costs ring space.
+    std::vector<sock_filter> program = udp_port_filter(config_.bind_port);
+    sock_fprog fprog{};
+    fprog.len = static_cast<unsigned short>(program.size());
+    fprog.filter = program.data();
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0) {
+        std::cerr << "[UdpReceiver] Failed to attach BPF port filter on " << config_.capture_interface << ": "
+                  << strerror(errno) << "; filtering in user space only." << std::endl;
+    }
+
+    tpacket_req3 request{};
+    request.tp_block_size = config_.ring_block_bytes;
+    request.tp_block_nr = config_.ring_block_count;
+    request.tp_frame_size = kRingFrameSize;
+    request.tp_frame_nr = (config_.ring_block_bytes / kRingFrameSize) * config_.ring_block_count;
+    request.tp_retire_blk_tov = config_.ring_block_timeout_ms;
+    if (setsockopt(socket_fd_, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) < 0)
+        fail("Failed to create TPACKET_V3 RX ring");
+
+    ring_bytes_ = static_cast<size_t>(config_.ring_block_bytes) * config_.ring_block_count;
+    void *ring = mmap(nullptr, ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, socket_fd_, 0);
+    if (ring == MAP_FAILED) {
+        ring_bytes_ = 0;
+        fail("Failed to mmap TPACKET_V3 RX ring");
+    }
+    ring_ = static_cast<uint8_t *>(ring);
+
+    sockaddr_ll link{};
+    link.sll_family = AF_PACKET;
+    link.sll_protocol = htons(ETH_P_IP);
+    link.sll_ifindex = static_cast<int>(ifindex);
+    if (bind(socket_fd_, reinterpret_cast<sockaddr *>(&link), sizeof(link)) < 0)
+        fail("Failed to bind AF_PACKET socket to " + config_.capture_interface);
+
+    if (!config_.multicast_group.empty()) {
+        // The ring sees frames regardless of sockets, but the host still has to join the group so the
+        // NIC and the switch deliver it. An unbound UDP socket holds the membership and queues nothing.
+        membership_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        if (membership_fd_ < 0) fail("Failed to create multicast membership socket");
+        try {
+            join_multicast_group(membership_fd_);
+        } catch (...) {
+            close_descriptors();
+            throw;
+        }
+    }
+
+    std::cout << "[UdpReceiver] Port " << config_.bind_port << " reading TPACKET_V3 ring on "
+              << config_.capture_interface << " (" << config_.ring_block_count << " x "
+              << config_.ring_block_bytes << " bytes)" << std::endl;
+#else
+    throw std::runtime_error("packet_mmap backend requires Linux (port " + std::to_string(config_.bind_port) + ")");
+#endif
+}
+
+bool UdpReceiver::setup_uring() {
+#ifdef __linux__
+    // Provided-buffer ring sizes are powers of two, at most 32768.
+    unsigned entries = 1;
+    while (entries < config_.uring_buffer_count && entries < 32768) entries <<= 1;
+
+    auto fall_back = [this](const std::string &what, int err) {
+        std::cerr << "[UdpReceiver] " << what << " on port " << config_.bind_port << " (" << strerror(err)
+                  << "); falling back to the socket backend." << std::endl;
+        uring_.reset();
+        if (uring_buffers_ != nullptr) munmap(uring_buffers_, uring_buffers_bytes_);
+        uring_buffers_ = nullptr;
+        uring_buffers_bytes_ = 0;
+        uring_slots_.clear();
+        uring_pending_bids_.clear();
+        uring_armed_ = false;
+        return false;
+    };
+
+    uring_ = std::make_unique<equix_md::IoUring>();
+    // One SQE is ever in flight (the multishot receive); the CQ must absorb a full buffer ring of completions.
+    int rc = uring_->init(8, std::max(entries * 2, 16u));
+    if (rc < 0) return fall_back("io_uring unavailable", -rc);
+
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    uring_buffers_bytes_ = (entries * sizeof(io_uring_buf) + page_size - 1) / page_size * page_size;
+    void *ring = mmap(nullptr, uring_buffers_bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED) {
+        uring_buffers_bytes_ = 0;
+        return fall_back("Failed to allocate io_uring buffer ring", errno);
+    }
+    uring_buffers_ = static_cast<io_uring_buf_ring *>(ring);
+    rc = uring_->register_buffer_ring(uring_buffers_, entries, 0);
+    if (rc < 0) return fall_back("io_uring provided-buffer rings not supported", -rc);
+
+    uring_tail_ = 0;
+    uring_slots_.resize(entries);
+    uring_pending_bids_.clear();
+    for (unsigned bid = entries; bid-- > 0;) uring_pending_bids_.push_back(static_cast<uint16_t>(bid));
+    provide_uring_buffers();
+
+    uring_msg_ = {};
+    uring_msg_.msg_controllen = config_.kernel_timestamps ? kUringControlBytes : 0;
+    if (!arm_uring_recv()) return fall_back("Failed to submit io_uring multishot recvmsg", errno);
+
+    // Kernels without multishot recvmsg (< 6.0) reject the SQE at submission and post the error at once.
+    const io_uring_cqe *cqe = uring_->peek_cqe();
+    if (cqe != nullptr && cqe->res < 0 && !(cqe->flags & IORING_CQE_F_MORE)) {
+        return fall_back("io_uring multishot recvmsg not supported", -cqe->res);
+    }
+
+    std::cout << "[UdpReceiver] Port " << config_.bind_port << " receiving via io_uring multishot recvmsg ("
+              << entries << " provided buffers)" << std::endl;
+    return true;
+#else
+    std::cerr << "[UdpReceiver] io_uring requires Linux; port " << config_.bind_port
+              << " uses the socket backend." << std::endl;
+    return false;
+#endif
+}
+
+void UdpReceiver::provide_uring_buffers() {
+#ifdef __linux__
+    const uint16_t mask = static_cast<uint16_t>(uring_slots_.size() - 1);
+    while (!uring_pending_bids_.empty()) {
+        equix_md::PacketRef buffer = pool_.acquire();
+        if (!buffer) {
+            if (!uring_exhausted_logged_) {
+                uring_exhausted_logged_ = true;
+                std::cerr << "[UdpReceiver] Packet buffer pool exhausted (port " << config_.bind_port
+                          << "); io_uring receive stalls until buffers are released." << std::endl;
+            }
+            break;
+        }
+        uint16_t bid = uring_pending_bids_.back();
+        uring_pending_bids_.pop_back();
+        // Index from the ring base: in C++ the header's flexible-array wrapper shifts `bufs` by 8 bytes.
+        io_uring_buf &entry = reinterpret_cast<io_uring_buf *>(uring_buffers_)[uring_tail_ & mask];
+        entry.addr = reinterpret_cast<uint64_t>(buffer->data);
+        entry.len = static_cast<uint32_t>(equix_md::PacketBuffer::kCapacity);
+        entry.bid = bid;
+        uring_slots_[bid] = std::move(buffer);
+        ++uring_tail_;
+    }
+    __atomic_store_n(&uring_buffers_->tail, uring_tail_, __ATOMIC_RELEASE);
+#endif
+}
+
+bool UdpReceiver::arm_uring_recv() {
+#ifdef __linux__
+    io_uring_sqe *sqe = uring_->get_sqe();
+    if (sqe == nullptr) return false;
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = socket_fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(&uring_msg_);
+    sqe->len = 1;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    int rc = uring_->submit();
+    if (rc < 0) {
+        errno = -rc;
+        return false;
+    }
+    uring_armed_ = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+int UdpReceiver::receive_uring_batch() {
+#ifdef __linux__
+    if (!uring_pending_bids_.empty()) provide_uring_buffers();
+    // The multishot receive ends when the kernel ran out of provided buffers (or on error); re-arm it.
+    if (!uring_armed_ && uring_pending_bids_.size() < uring_slots_.size() && !arm_uring_recv()) return -1;
+
+    const size_t payload_offset = sizeof(io_uring_recvmsg_out) + uring_msg_.msg_namelen + uring_msg_.msg_controllen;
+    uint64_t user_timestamp_ns = 0;
+    size_t n = 0;
+    uring_->for_each_cqe(static_cast<unsigned>(config_.batch_size), [&](const io_uring_cqe &cqe) {
+        if (!(cqe.flags & IORING_CQE_F_MORE)) uring_armed_ = false;
+        if (!(cqe.flags & IORING_CQE_F_BUFFER)) {
+            if (cqe.res < 0 && cqe.res != -ENOBUFS) {
+                std::cerr << "[UdpReceiver] io_uring recvmsg error on port " << config_.bind_port << ": "
+                          << strerror(-cqe.res) << std::endl;
+            }
+            return;
+        }
+
+        uint16_t bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        equix_md::PacketRef buffer = std::move(uring_slots_[bid]);
+        uring_pending_bids_.push_back(bid);
+        if (cqe.res < static_cast<int>(payload_offset)) return;
+
+        const auto *out = reinterpret_cast<const io_uring_recvmsg_out *>(buffer->data);
+        if (out->flags & MSG_TRUNC) return;
+        size_t payload_size = out->payloadlen;
+        if (payload_offset + payload_size > static_cast<size_t>(cqe.res)) return;
+
+        msghdr control{};
+        control.msg_control = buffer->data + sizeof(io_uring_recvmsg_out) + uring_msg_.msg_namelen;
+        control.msg_controllen = out->controllen;
+        buffer->size = static_cast<size_t>(cqe.res);
+        ControlData control_data = parse_control(control);
+        buffer->rx_timestamp_ns = control_data.timestamp_ns;
+        if (buffer->rx_timestamp_ns == 0) {
+            if (user_timestamp_ns == 0) user_timestamp_ns = equix_md::realtime_now_ns();
+            buffer->rx_timestamp_ns = user_timestamp_ns;
+        }
+
+        Packet &packet = batch_packets_[n++];
+        packet.data = reinterpret_cast<const char *>(buffer->data + payload_offset);
+        packet.size = payload_size;
+        packet.buffer = std::move(buffer);
+        packet.kernel_drops = account_kernel_drops(control_data.drop_count);
+    });
+    // Re-arm now rather than on the next call: an epoll waiter would otherwise see no further completions.
+    if (!uring_armed_) {
+        provide_uring_buffers();
+        if (uring_pending_bids_.size() < uring_slots_.size()) arm_uring_recv();
+    }
+    return static_cast<int>(n);
+#else
+    return -1;
+#endif
+}
+
+void UdpReceiver::close_descriptors() {
+#ifdef __linux__
+    // Closing the io_uring instance cancels the multishot receive before its buffers go back to the pool.
+    uring_.reset();
+    if (uring_buffers_ != nullptr) {
+        munmap(uring_buffers_, uring_buffers_bytes_);
+        uring_buffers_ = nullptr;
+        uring_buffers_bytes_ = 0;
+    }
+    uring_slots_.clear();
+    uring_pending_bids_.clear();
+    uring_armed_ = false;
+    if (ring_ != nullptr) {
+        munmap(ring_, ring_bytes_);
+        ring_ = nullptr;
+        ring_bytes_ = 0;
+    }
+#endif
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+    if (membership_fd_ >= 0) {
+        close(membership_fd_);
+        membership_fd_ = -1;
+    }
+    if (socket_fd_ >= 0) {
+        close(socket_fd_);
+        socket_fd_ = -1;
+    }
 }
 
 void UdpReceiver::start(PacketCallback callback) {
+    start(BatchPacketCallback([callback](const Packet *packets, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            callback(std::vector<char>(packets[i].data, packets[i].data + packets[i].size));
+        }
+    }));
+}
+
+void UdpReceiver::start(BatchPacketCallback callback) {
     if (running_) return;
 
     running_ = true;
@@ -70,72 +470,452 @@ void UdpReceiver::start(PacketCallback callback) {
         setup_thread_affinity();
         setup_realtime_priority();
 
-        char buffer[2048];
-
+        uint32_t empty_polls = 0;
         while (running_) {
-            sockaddr_in src_addr{};
-            socklen_t addrlen = sizeof(src_addr);
-
-            ssize_t len = recvfrom(socket_fd_, buffer, sizeof(buffer), 0,
-                                   (struct sockaddr *) &src_addr, &addrlen);
-
-            if (len > 0) {
-                callback(std::vector<char>(buffer, buffer + len));
-            } else if (len < 0) {
-                if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                    continue;
-                }
-                if (running_) {
-                    std::cerr << "[UdpReceiver] recvfrom error: " << strerror(errno) << std::endl;
-                }
+            int received = poll(callback);
+
+            if (received > 0) {
+                empty_polls = 0;
+            } else if (received == 0) {
+                counters_.on_idle();
+                idle_wait(empty_polls);
+                if (empty_polls != UINT32_MAX) ++empty_polls;
+            } else if (running_) {
+                std::cerr << "[UdpReceiver] receive error: " << strerror(errno) << std::endl;
             }
         }
     });
 }
 
+int UdpReceiver::poll(const BatchPacketCallback &callback) {
+    // After a read that returned data more may be queued, so the time until this read is time the
+    // socket went unserviced (callback work, or other receivers on a shared thread).
+    if (last_data_read_ns_ != 0) counters_.on_read_gap(equix_md::monotonic_now_ns() - last_data_read_ns_);
+    int received = receive_batch();
+    if (received <= 0) {
+        last_data_read_ns_ = 0;
+        return received;
+    }
+    last_data_read_ns_ = equix_md::monotonic_now_ns();
+
+    uint64_t bytes = 0;
+    for (int i = 0; i < received; ++i) bytes += batch_packets_[i].size;
+    counters_.on_batch(static_cast<size_t>(received), bytes);
+
+    callback(batch_packets_.data(), static_cast<size_t>(received));
+    // Hand the delivered buffers over to whoever kept a reference.
+    for (int i = 0; i < received; ++i) batch_packets_[i].buffer.reset();
+    return received;
+}
+
+int UdpReceiver::wait_fd() const {
+#ifdef __linux__
+    if (uring_) return uring_->fd();
+#endif
+    return socket_fd_;
+}
+
+size_t UdpReceiver::refill_batch_slots() {
+    size_t ready = 0;
+    for (; ready < config_.batch_size; ++ready) {
+        Packet &slot = batch_packets_[ready];
+        if (!slot.buffer) {
+            slot.buffer = pool_.acquire();
+            if (!slot.buffer) break;
+        }
+#ifdef __linux__
+        batch_iovecs_[ready].iov_base = slot.buffer->data;
+        batch_iovecs_[ready].iov_len = kMaxDatagramSize;
+        // The kernel shrinks msg_controllen to what it wrote; restore the full space every call.
+        batch_headers_[ready].msg_hdr.msg_controllen = kControlBytes;
+#endif
+    }
+    pool_starved_ = ready == 0;
+    if (pool_starved_) counters_.on_pool_stall();
+    if (pool_starved_ && !pool_exhausted_logged_) {
+        pool_exhausted_logged_ = true;
+        std::cerr << "[UdpReceiver] Packet buffer pool exhausted (port " << config_.bind_port
+                  << "); receive stalls until buffers are released." << std::endl;
+    }
+    return ready;
+}
+
+int UdpReceiver::receive_batch() {
+    if (config_.backend == Backend::PacketMmap) return receive_ring_batch();
+    if (config_.backend == Backend::IoUring) return receive_uring_batch();
+
+    size_t ready = refill_batch_slots();
+    if (ready == 0) return 0;
+
+#ifdef __linux__
+    int n;
+    if (ready > 1) {
+        n = recvmmsg(socket_fd_, batch_headers_.data(), static_cast<unsigned int>(ready), MSG_DONTWAIT, nullptr);
+        if (n < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+    } else {
+        ssize_t len = recvmsg(socket_fd_, &batch_headers_[0].msg_hdr, MSG_DONTWAIT);
+        if (len < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        if (len == 0) return 0;
+        batch_headers_[0].msg_len = static_cast<unsigned int>(len);
+        n = 1;
+    }
+
+    uint64_t user_timestamp_ns = 0; // Read lazily, only if a datagram carries no kernel stamp
+    for (int i = 0; i < n; ++i) {
+        Packet &packet = batch_packets_[i];
+        ControlData control_data = parse_control(batch_headers_[i].msg_hdr);
+        packet.kernel_drops = account_kernel_drops(control_data.drop_count);
+        packet.buffer->size = batch_headers_[i].msg_len;
+        packet.buffer->rx_timestamp_ns = control_data.timestamp_ns;
+        if (packet.buffer->rx_timestamp_ns == 0) {
+            if (user_timestamp_ns == 0) user_timestamp_ns = equix_md::realtime_now_ns();
+            packet.buffer->rx_timestamp_ns = user_timestamp_ns;
+        }
+        packet.data = reinterpret_cast<const char *>(packet.buffer->data);
+        packet.size = packet.buffer->size;
+    }
+    return n;
+#else
+    Packet &packet = batch_packets_[0];
+    ssize_t len = recvfrom(socket_fd_, packet.buffer->data, kMaxDatagramSize, 0, nullptr, nullptr);
+    if (len < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    if (len == 0) return 0;
+    packet.buffer->size = static_cast<size_t>(len);
+    packet.buffer->rx_timestamp_ns = equix_md::realtime_now_ns();
+    packet.kernel_drops = 0;
+    packet.data = reinterpret_cast<const char *>(packet.buffer->data);
+    packet.size = packet.buffer->size;
+    return 1;
+#endif
+}
+
+int UdpReceiver::receive_ring_batch() {
+#ifdef __linux__
+    size_t ready = refill_batch_slots();
+    if (ready == 0) return 0;
+
+    size_t n = 0;
+    while (n < ready) {
+        auto *block = reinterpret_cast<tpacket_block_desc *>(ring_ + static_cast<size_t>(ring_block_) *
+                                                             config_.ring_block_bytes);
+        if (!ring_block_open_) {
+            // The kernel hands a block over by setting TP_STATUS_USER once it is retired (full or timed out).
+            if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) break;
+            ring_block_open_ = true;
+            ring_frames_left_ = block->hdr.bh1.num_pkts;
+            ring_next_frame_ = reinterpret_cast<const uint8_t *>(block) + block->hdr.bh1.offset_to_first_pkt;
+        }
+
+        if (ring_frames_left_ > 0) {
+            const auto *frame = reinterpret_cast<const tpacket3_hdr *>(ring_next_frame_);
+            ring_next_frame_ += frame->tp_next_offset;
+            --ring_frames_left_;
+            if (accept_ring_frame(frame, batch_packets_[n])) {
+                // Ring drops are only known per statistics read; blame the next datagram delivered.
+                batch_packets_[n].kernel_drops = ring_pending_drops_;
+                ring_pending_drops_ = 0;
+                ++n;
+            }
+        }
+
+        if (ring_frames_left_ == 0) {
+            // Everything needed was copied out; give the block straight back and move on.
+            __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+            collect_ring_drops();
+            ring_block_open_ = false;
+            ring_block_ = (ring_block_ + 1) % config_.ring_block_count;
+        }
+    }
+    return static_cast<int>(n);
+#else
+    return -1;
+#endif
+}
+
+#ifdef __linux__
+bool UdpReceiver::accept_ring_frame(const tpacket3_hdr *frame, Packet &slot) const {
+    const auto *base = reinterpret_cast<const uint8_t *>(frame);
+    const auto *link = reinterpret_cast<const sockaddr_ll *>(base + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+    // Loopback shows every frame twice (outgoing and incoming); keep the incoming copy only.
+    if (link->sll_pkttype == PACKET_OUTGOING) return false;
+    if (frame->tp_snaplen < frame->tp_len) return false;
+
+    equix_md::UdpDatagramView datagram;
+    if (!equix_md::net::parse_ethernet_udp(base + frame->tp_mac, frame->tp_snaplen, datagram)) return false;
+    if (datagram.dst_port != config_.bind_port) return false;
+    if (datagram.dst_ip != ring_dst_ip_ && ring_dst_ip_ != htonl(INADDR_ANY)) return false;
+    if (datagram.payload_size > kMaxDatagramSize) return false;
+
+    // Payloads outlive the ring block (messages keep a PacketRef), so they move into a pool buffer.
+    std::memcpy(slot.buffer->data, datagram.payload, datagram.payload_size);
+    slot.buffer->size = datagram.payload_size;
+    slot.buffer->rx_timestamp_ns = static_cast<uint64_t>(frame->tp_sec) * 1000000000ull + frame->tp_nsec;
+    slot.data = reinterpret_cast<const char *>(slot.buffer->data);
+    slot.size = slot.buffer->size;
+    return true;
+}
+#endif
+
+#ifdef __linux__
+UdpReceiver::ControlData UdpReceiver::parse_control(const msghdr &header) {
+    ControlData data;
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(const_cast<msghdr *>(&header), cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) continue;
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec ts{};
+            std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            data.timestamp_ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#ifdef SO_RXQ_OVFL
+        } else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+            std::memcpy(&data.drop_count, CMSG_DATA(cmsg), sizeof(data.drop_count));
+#endif
+        }
+    }
+    return data;
+}
+
+uint32_t UdpReceiver::account_kernel_drops(uint32_t drop_count) {
+    // The kernel attaches the count only once it is non-zero; it is cumulative and wraps at 2^32.
+    if (drop_count == 0 || drop_count == last_drop_count_) return 0;
+    uint32_t dropped = drop_count - last_drop_count_;
+    last_drop_count_ = drop_count;
+    counters_.on_kernel_drops(dropped);
+    return dropped;
+}
+
+void UdpReceiver::collect_ring_drops() {
+    tpacket_stats_v3 ring_stats{};
+    socklen_t length = sizeof(ring_stats);
+    // Reading PACKET_STATISTICS resets the kernel's counters, so each call returns drops since the last one.
+    if (getsockopt(socket_fd_, SOL_PACKET, PACKET_STATISTICS, &ring_stats, &length) == 0 && ring_stats.tp_drops != 0) {
+        ring_pending_drops_ += ring_stats.tp_drops;
+        counters_.on_kernel_drops(ring_stats.tp_drops);
+    }
+}
+#endif
+
 void UdpReceiver::stop() {
     running_ = false;
     if (receiver_thread_.joinable()) {
         receiver_thread_.join();
     }
 
-    if (socket_fd_ >= 0) {
-        close(socket_fd_);
-        socket_fd_ = -1;
+    close_descriptors();
+}
+
+UdpReceiver::Stats UdpReceiver::stats() const {
+    return counters_.snapshot();
+}
+
+std::optional<UdpReceiver::IdleStrategy> UdpReceiver::idle_strategy_from_string(const std::string &name) {
+    if (name == "busy_spin") return IdleStrategy::BusySpin;
+    if (name == "spin_yield") return IdleStrategy::SpinYield;
+    if (name == "busy_poll") return IdleStrategy::BusyPoll;
+    if (name == "epoll") return IdleStrategy::Epoll;
+    return std::nullopt;
+}
+
+std::optional<UdpReceiver::Backend> UdpReceiver::backend_from_string(const std::string &name) {
+    if (name == "socket") return Backend::Socket;
+    if (name == "packet_mmap") return Backend::PacketMmap;
+    if (name == "io_uring") return Backend::IoUring;
+    return std::nullopt;
+}
+
+const char *UdpReceiver::backend_name(Backend backend) {
+    switch (backend) {
+        case Backend::Socket: return "socket";
+        case Backend::PacketMmap: return "packet_mmap";
+        case Backend::IoUring: return "io_uring";
+    }
+    return "unknown";
+}
+
+const char *UdpReceiver::idle_strategy_name(IdleStrategy strategy) {
+    switch (strategy) {
+        case IdleStrategy::BusySpin: return "busy_spin";
+        case IdleStrategy::SpinYield: return "spin_yield";
+        case IdleStrategy::BusyPoll: return "busy_poll";
+        case IdleStrategy::Epoll: return "epoll";
+    }
+    return "unknown";
+}
+
+void UdpReceiver::setup_receive_buffer() {
+    if (config_.recv_buffer_bytes > 0) {
+        int requested = config_.recv_buffer_bytes;
+        bool forced = false;
+#ifdef SO_RCVBUFFORCE
+        // SO_RCVBUFFORCE ignores net.core.rmem_max but needs CAP_NET_ADMIN.
+        forced = setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUFFORCE, &requested, sizeof(requested)) == 0;
+#endif
+        if (!forced && setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUF, &requested, sizeof(requested)) < 0) {
+            std::cerr << "[UdpReceiver] Failed to set SO_RCVBUF on port " << config_.bind_port << ": "
+                      << strerror(errno) << std::endl;
+        }
+    }
+
+    int granted = 0;
+    socklen_t len = sizeof(granted);
+    getsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUF, &granted, &len);
+    granted_recv_buffer_bytes_ = granted;
+    std::cout << "[UdpReceiver] Port " << config_.bind_port << " receive buffer: requested="
+              << config_.recv_buffer_bytes << " granted=" << granted << " bytes" << std::endl;
+    // Linux reports twice the usable size (bookkeeping overhead is included).
+    if (config_.recv_buffer_bytes > 0 && granted < config_.recv_buffer_bytes) {
+        std::cerr << "[UdpReceiver] WARNING: receive buffer on port " << config_.bind_port
+                  << " capped below the requested size; raise net.core.rmem_max or run with CAP_NET_ADMIN."
+                  << std::endl;
+    }
+}
+
+void UdpReceiver::join_multicast_group(int fd) {
+    const std::string &iface = config_.interface_ip.empty() ? std::string("0.0.0.0") : config_.interface_ip;
+    int rc;
+    if (!config_.source_ip.empty()) {
+        // Source-specific multicast (SSM): only accept the group from this sender.
+        ip_mreq_source mreq{};
+        mreq.imr_multiaddr.s_addr = inet_addr(config_.multicast_group.c_str());
+        mreq.imr_interface.s_addr = inet_addr(iface.c_str());
+        mreq.imr_sourceaddr.s_addr = inet_addr(config_.source_ip.c_str());
+        rc = setsockopt(fd, IPPROTO_IP, IP_ADD_SOURCE_MEMBERSHIP, &mreq, sizeof(mreq));
+    } else {
+        ip_mreq mreq{};
+        mreq.imr_multiaddr.s_addr = inet_addr(config_.multicast_group.c_str());
+        mreq.imr_interface.s_addr = inet_addr(iface.c_str());
+        rc = setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+    }
+    if (rc < 0) {
+        int err = errno;
+        throw std::runtime_error("Failed to join multicast group " + config_.multicast_group + " on " + iface +
+                                 ": " + std::string(strerror(err)));
+    }
+#ifdef IP_MULTICAST_ALL
+    // Do not deliver groups joined by other sockets on this host that share the port.
+    int all = 0;
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_ALL, &all, sizeof(all));
+#endif
+    std::cout << "[UdpReceiver] Joined multicast " << config_.multicast_group << ":" << config_.bind_port
+              << " on " << iface;
+    if (!config_.source_ip.empty()) std::cout << " source " << config_.source_ip;
+    std::cout << std::endl;
+}
+
+void UdpReceiver::setup_idle_strategy() {
+    switch (config_.idle_strategy) {
+        case IdleStrategy::BusyPoll: {
+#if defined(__linux__) && defined(SO_BUSY_POLL)
+            int usec = config_.busy_poll_usec;
+            if (setsockopt(socket_fd_, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec)) < 0) {
+                std::cerr << "[UdpReceiver] Failed to set SO_BUSY_POLL (" << strerror(errno)
+                          << "); falling back to plain busy-spin." << std::endl;
+            }
+#else
+            std::cerr << "[UdpReceiver] SO_BUSY_POLL not supported on this platform; using busy-spin.\n";
+#endif
+            break;
+        }
+        case IdleStrategy::Epoll: {
+#ifdef __linux__
+            epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+            if (epoll_fd_ < 0) {
+                std::string reason = strerror(errno);
+                close_descriptors();
+                throw std::runtime_error("Failed to create epoll instance: " + reason);
+            }
+            // io_uring: wait on the ring, which turns readable when a completion is posted.
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = wait_fd();
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wait_fd(), &event) < 0) {
+                std::string reason = strerror(errno);
+                close_descriptors();
+                throw std::runtime_error("Failed to register receive socket with epoll: " + reason);
+            }
+#endif
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void UdpReceiver::idle_wait(uint32_t empty_polls) {
+    if (pool_starved_) {
+        // Nothing was read for lack of a buffer, not for lack of data: epoll would return at once
+        std::this_thread::sleep_for(kPoolStallBackoff);
+        return;
+    }
+    switch (config_.idle_strategy) {
+        case IdleStrategy::BusySpin:
+        case IdleStrategy::BusyPoll:
+            equix_md::cpu_relax();
+            break;
+        case IdleStrategy::SpinYield:
+            if (empty_polls < config_.idle_spin_count) {
+                equix_md::cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+            break;
+        case IdleStrategy::Epoll: {
+#ifdef __linux__
+            epoll_event event{};
+            epoll_wait(epoll_fd_, &event, 1, config_.epoll_timeout_ms);
+#else
+            pollfd pfd{socket_fd_, POLLIN, 0};
+            ::poll(&pfd, 1, config_.epoll_timeout_ms);
+#endif
+            break;
+        }
     }
 }
 
 void UdpReceiver::setup_thread_affinity() {
+    pin_current_thread(config_.cpu_affinity_core);
+}
+
+void UdpReceiver::setup_realtime_priority() {
+    set_current_thread_realtime(config_.thread_realtime_priority);
+}
+
+void UdpReceiver::pin_current_thread(int core) {
 #ifdef __linux__
-    if (config_.cpu_affinity_core < 0) return;
+    if (core < 0) return;
 
     cpu_set_t cpuset;
     CPU_ZERO(&cpuset);
-    CPU_SET(config_.cpu_affinity_core, &cpuset);
+    CPU_SET(core, &cpuset);
     int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
     if (rc != 0) {
-        std::cerr << "[UdpReceiver] Failed to set CPU affinity: " << strerror(errno) << std::endl;
+        std::cerr << "[UdpReceiver] Failed to set CPU affinity to core " << core << ": " << strerror(rc) << std::endl;
     }
 #else
-    if (config_.cpu_affinity_core >= 0) {
+    if (core >= 0) {
         std::cerr << "[UdpReceiver] CPU affinity not supported on this platform.\n";
     }
 #endif
 }
 
-void UdpReceiver::setup_realtime_priority() {
+void UdpReceiver::set_current_thread_realtime(int priority) {
 #ifdef __linux__
-    if (config_.thread_realtime_priority <= 0) return;
+    if (priority <= 0) return;
 
     sched_param param{};
-    param.sched_priority = config_.thread_realtime_priority;
+    param.sched_priority = priority;
     int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
     if (rc != 0) {
-        std::cerr << "[UdpReceiver] Failed to set real-time priority: " << strerror(errno) << std::endl;
+        std::cerr << "[UdpReceiver] Failed to set real-time priority: " << strerror(rc) << std::endl;
     }
 #else
-    if (config_.thread_realtime_priority > 0) {
+    if (priority > 0) {
         std::cerr << "[UdpReceiver] Real-time priority not supported on this platform.\n";
     }
 #endif
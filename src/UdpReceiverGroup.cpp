@@ -0,0 +1,185 @@
+/**
+ * @file    UdpReceiverGroup.cpp
+ * @brief   Single-thread multiplexer for many UdpReceivers.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: UdpReceiverGroup.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Implements the receiver group thread: one epoll set over every member's
+ *   wait descriptor, or a round-robin busy-poll loop, pinned and prioritised
+ *   like a standalone receiver thread.
+ */
+
+#include "UdpReceiverGroup.hpp"
+#include "SpinLock.hpp"
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+UdpReceiverGroup::UdpReceiverGroup(const Config &config) : config_(config) {
+    if (config_.max_batches_per_wakeup == 0) config_.max_batches_per_wakeup = 1;
+}
+
+UdpReceiverGroup::~UdpReceiverGroup() {
+    stop();
+}
+
+void UdpReceiverGroup::add(UdpReceiver &receiver, UdpReceiver::BatchPacketCallback callback) {
+    if (running_) throw std::logic_error("UdpReceiverGroup::add called after start()");
+    members_.push_back(Member{&receiver, std::move(callback)});
+}
+
+void UdpReceiverGroup::start() {
+    if (running_ || members_.empty()) return;
+
+    const bool use_epoll = config_.idle_strategy == UdpReceiver::IdleStrategy::Epoll;
+#ifdef __linux__
+    if (use_epoll) {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ < 0) {
+            throw std::runtime_error("Failed to create epoll instance for receiver group '" + config_.name + "': " +
+                                     std::string(strerror(errno)));
+        }
+        for (size_t i = 0; i < members_.size(); ++i) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = i;
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, members_[i].receiver->wait_fd(), &event) < 0) {
+                std::string reason = strerror(errno);
+                close(epoll_fd_);
+                epoll_fd_ = -1;
+                throw std::runtime_error("Failed to add port " + std::to_string(members_[i].receiver->config().bind_port) +
+                                         " to receiver group '" + config_.name + "': " + reason);
+            }
+        }
+    }
+#endif
+
+    running_ = true;
+    thread_ = std::thread([this, use_epoll]() {
+        UdpReceiver::pin_current_thread(config_.cpu_affinity_core);
+        UdpReceiver::set_current_thread_realtime(config_.thread_realtime_priority);
+        if (use_epoll) {
+            run_epoll();
+        } else {
+            run_polling();
+        }
+    });
+
+    std::cout << "[UdpReceiverGroup] '" << config_.name << "' serving " << members_.size() << " receiver(s) with "
+              << UdpReceiver::idle_strategy_name(config_.idle_strategy) << std::endl;
+}
+
+void UdpReceiverGroup::run_epoll() {
+#ifdef __linux__
+    std::vector<epoll_event> events(members_.size());
+    while (running_) {
+        bump(idle_waits_);
+        int ready = epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), config_.epoll_timeout_ms);
+        if (ready <= 0) {
+            if (ready < 0 && errno != EINTR) {
+                std::cerr << "[UdpReceiverGroup] epoll_wait error: " << strerror(errno) << std::endl;
+            }
+            continue;
+        }
+        bump(wakeups_);
+        // Drain each ready member up to a bound, so one hot unit cannot starve the others.
+        bool starved = false;
+        for (int e = 0; e < ready; ++e) {
+            Member &member = members_[events[e].data.u64];
+            for (uint32_t batch = 0; batch < config_.max_batches_per_wakeup; ++batch) {
+                int received = member.receiver->poll(member.callback);
+                if (received <= 0) {
+                    starved = starved || member.receiver->pool_starved();
+                    if (received < 0 && running_) {
+                        std::cerr << "[UdpReceiverGroup] receive error on port " << member.receiver->config().bind_port
+                                  << ": " << strerror(errno) << std::endl;
+                    }
+                    break;
+                }
+            }
+        }
+        // Readable members left unread for lack of buffers would wake epoll_wait again at once
+        if (starved) std::this_thread::sleep_for(UdpReceiver::kPoolStallBackoff);
+    }
+#else
+    // Portable fallback: poll() over the member descriptors.
+    std::vector<pollfd> fds(members_.size());
+    for (size_t i = 0; i < members_.size(); ++i) fds[i] = pollfd{members_[i].receiver->wait_fd(), POLLIN, 0};
+    while (running_) {
+        bump(idle_waits_);
+        if (::poll(fds.data(), fds.size(), config_.epoll_timeout_ms) <= 0) continue;
+        bump(wakeups_);
+        bool starved = false;
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if ((fds[i].revents & POLLIN) && members_[i].receiver->poll(members_[i].callback) == 0)
+                starved = starved || members_[i].receiver->pool_starved();
+        }
+        if (starved) std::this_thread::sleep_for(UdpReceiver::kPoolStallBackoff);
+    }
+#endif
+}
+
+void UdpReceiverGroup::run_polling() {
+    uint32_t empty_rounds = 0;
+    while (running_) {
+        bool any = false;
+        bool starved = false;
+        for (Member &member: members_) {
+            int received = member.receiver->poll(member.callback);
+            if (received > 0) {
+                any = true;
+            } else if (member.receiver->pool_starved()) {
+                starved = true;
+            } else if (received < 0 && running_) {
+                std::cerr << "[UdpReceiverGroup] receive error on port " << member.receiver->config().bind_port
+                          << ": " << strerror(errno) << std::endl;
+            }
+        }
+
+        if (any) {
+            bump(wakeups_);
+            empty_rounds = 0;
+            continue;
+        }
+        bump(idle_waits_);
+        if (starved) {
+            std::this_thread::sleep_for(UdpReceiver::kPoolStallBackoff);
+        } else if (config_.idle_strategy == UdpReceiver::IdleStrategy::SpinYield && empty_rounds >= config_.idle_spin_count) {
+            std::this_thread::yield();
+        } else {
+            equix_md::cpu_relax();
+        }
+        if (empty_rounds != UINT32_MAX) ++empty_rounds;
+    }
+}
+
+void UdpReceiverGroup::stop() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+}
+
+UdpReceiverGroup::Stats UdpReceiverGroup::stats() const {
+    Stats snapshot;
+    snapshot.wakeups = wakeups_.load(std::memory_order_relaxed);
+    snapshot.idle_waits = idle_waits_.load(std::memory_order_relaxed);
+    return snapshot;
+}
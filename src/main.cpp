@@ -21,19 +21,33 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <iomanip>
+#include <cctype>
+#include <algorithm>
+#include <optional>
 #include <yaml-cpp/yaml.h>
 
 #include "UdpReceiver.hpp"
+#include "UdpReceiverGroup.hpp"
+#include "PcapSource.hpp"
+#include "SyntheticSource.hpp"
+#include "GapRecoveryClient.hpp"
 #include "DisruptorRouter.hpp"
 #include "SymbolIdentifier.hpp"
 #include "SymbolQueueRouter.hpp"
 #include "KafkaProducer.hpp"
 #include "KafkaPush.hpp"
 #include "DisruptorDispatcher.hpp"
+#include "PacketBufferPool.hpp"
+#include "LineArbiter.hpp"
+#include "SequenceTracker.hpp"
+#include "ReorderBuffer.hpp"
+#include "LatencyStats.hpp"
 //Pitch library
 #include "pitch/message_factory.h"
 #include "pitch/seq_unit_header.h"
 #include "pitch/message.h"
+#include "pitch/message_visit.h"
 
 // Atomic flag set by signal handler to trigger application shutdown.
 // All threads check this to exit cleanly.
@@ -42,8 +56,15 @@ std::atomic<bool> shutdown_requested{false};
 // Global counter for processed messages; used for monitoring/statistics.
 std::atomic<uint64_t> total_messages_processed{0};
 
+// Per-stage latency measured from the kernel receive timestamp of each message's datagram.
+equix_md::LatencyStats latency_parsed("wire->parsed");       // receive thread, after parse + enqueue
+equix_md::LatencyStats latency_dispatched("wire->disruptor"); // disruptor handler entry
+equix_md::LatencyStats latency_kafka("wire->kafka");         // after KafkaPush returns
+
 // Configuration constants
 constexpr int NUM_KAFKA_PARTITIONS = 8; // Adjust based on your Kafka topic setup
+// Routing key / topic for messages that carry no symbol
+const equix_md::Symbol kUnknownSymbol("UNKNOWN");
 
 /**
  * @brief Convert payload to hex string for debugging/logging
@@ -128,6 +149,315 @@ inline int hash_message_type_to_partition_advanced(uint8_t message_type, int num
     return static_cast<int>(hash_value % static_cast<size_t>(num_partitions));
 }
 
+/**
+ * @brief Print one line of receive statistics per UDP receiver.
+ */
+void print_receiver_stats(const std::vector<std::unique_ptr<UdpReceiver> > &receivers) {
+    for (const auto &receiver: receivers) {
+        const auto &cfg = receiver->config();
+        auto stats = receiver->stats();
+        std::cout << "[STATS] udp " << cfg.bind_ip << ":" << cfg.bind_port
+                << " backend=" << UdpReceiver::backend_name(cfg.backend)
+                << " idle=" << UdpReceiver::idle_strategy_name(cfg.idle_strategy)
+                << " packets=" << stats.packets
+                << " bytes=" << stats.bytes
+                << " batches=" << stats.batches
+                << " idle_waits=" << stats.idle_waits
+                << " kernel_drops=" << stats.kernel_drops
+                << " pool_stalls=" << stats.pool_stalls
+                << " max_read_gap_us=" << stats.max_read_gap_ns / 1000
+                << " batch_sizes=";
+        // Compact histogram: "<bucket floor>:<batches>" for every non-empty bucket.
+        const char *separator = "";
+        for (size_t bucket = 0; bucket < stats.batch_sizes.size(); ++bucket) {
+            if (stats.batch_sizes[bucket] == 0) continue;
+            std::cout << separator << equix_md::ReceiveCounters::batch_bucket_floor(bucket) << ":"
+                    << stats.batch_sizes[bucket];
+            separator = ",";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "[STATS] messages_processed=" << total_messages_processed.load() << std::endl;
+}
+
+/**
+ * @brief Print occupancy of the packet buffer and message arena pools.
+ */
+void print_pool_stats(const equix_md::PacketBufferPool &packets, const CboePitch::MessageArenaPool &arenas) {
+    std::cout << "[STATS] pools packet_buffers_free=" << packets.available() << "/" << packets.capacity()
+            << " arenas_in_use=" << arenas.inUse() << "/" << arenas.capacity()
+            << " arena_exhausted=" << arenas.exhausted() << std::endl;
+}
+
+/**
+ * @brief Print one line of statistics per shared receive thread.
+ */
+void print_group_stats(const std::vector<std::unique_ptr<UdpReceiverGroup> > &groups) {
+    for (const auto &group: groups) {
+        auto stats = group->stats();
+        std::cout << "[STATS] receiver_thread " << group->config().name
+                << " receivers=" << group->size()
+                << " idle=" << UdpReceiver::idle_strategy_name(group->config().idle_strategy)
+                << " wakeups=" << stats.wakeups
+                << " idle_waits=" << stats.idle_waits << "\n";
+    }
+}
+
+/**
+ * @brief Read one `receiver_threads` entry (a shared receive thread serving several receivers).
+ */
+UdpReceiverGroup::Config parse_receiver_thread(const YAML::Node &node) {
+    UdpReceiverGroup::Config group_config;
+    if (node["name"]) group_config.name = node["name"].as<std::string>();
+    if (node["core_affinity"]) group_config.cpu_affinity_core = node["core_affinity"].as<int>();
+    if (node["realtime_priority"]) group_config.thread_realtime_priority = node["realtime_priority"].as<int>();
+    if (node["idle_strategy"]) {
+        auto name = node["idle_strategy"].as<std::string>();
+        auto strategy = UdpReceiver::idle_strategy_from_string(name);
+        if (strategy) {
+            group_config.idle_strategy = *strategy;
+        } else {
+            std::cerr << "[WARN] Unknown idle_strategy '" << name << "' for receiver thread '"
+                    << group_config.name << "' – using "
+                    << UdpReceiver::idle_strategy_name(group_config.idle_strategy) << ".\n";
+        }
+    }
+    if (node["idle_spin_count"]) group_config.idle_spin_count = node["idle_spin_count"].as<uint32_t>();
+    if (node["epoll_timeout_ms"]) group_config.epoll_timeout_ms = node["epoll_timeout_ms"].as<int>();
+    if (node["max_batches_per_wakeup"])
+        group_config.max_batches_per_wakeup = node["max_batches_per_wakeup"].as<uint32_t>();
+    return group_config;
+}
+
+/**
+ * @brief Read the `pcap_source` section (replay a capture file instead of, or next to, the network).
+ */
+PcapSource::Config parse_pcap_source(const YAML::Node &node) {
+    PcapSource::Config source_config;
+    if (node["file"]) source_config.file = node["file"].as<std::string>();
+    if (node["pacing"]) {
+        auto name = node["pacing"].as<std::string>();
+        auto pacing = PcapSource::pacing_from_string(name);
+        if (pacing) {
+            source_config.pacing = *pacing;
+        } else {
+            std::cerr << "[WARN] Unknown pcap_source pacing '" << name << "' – using "
+                    << PcapSource::pacing_name(source_config.pacing) << ".\n";
+        }
+    }
+    if (node["speed"]) source_config.speed = node["speed"].as<double>();
+    if (node["loops"]) source_config.loops = node["loops"].as<uint32_t>();
+    if (node["ports"] && node["ports"].IsSequence()) {
+        for (const auto &port: node["ports"]) source_config.ports.push_back(port.as<uint16_t>());
+    }
+    if (node["batch_size"]) source_config.batch_size = node["batch_size"].as<size_t>();
+    if (node["core_affinity"]) source_config.cpu_affinity_core = node["core_affinity"].as<int>();
+    return source_config;
+}
+
+/**
+ * @brief Read the `synthetic_source` section (generated feed with a large Zipf symbol universe).
+ */
+SyntheticSource::Config parse_synthetic_source(const YAML::Node &node) {
+    SyntheticSource::Config source_config;
+    auto &feed = source_config.feed;
+    if (node["symbols"]) feed.symbols = node["symbols"].as<size_t>();
+    if (node["zipf_exponent"]) feed.zipf_exponent = node["zipf_exponent"].as<double>();
+    if (node["units"]) {
+        const unsigned units = node["units"].as<unsigned>();
+        if (units == 0 || units > 255) throw std::invalid_argument("units must be 1..255 (one byte on the wire)");
+        feed.units = static_cast<uint8_t>(units);
+    }
+    if (node["messages_per_packet"]) feed.messages_per_packet = node["messages_per_packet"].as<size_t>();
+    if (node["max_live_orders"]) feed.max_live_orders = node["max_live_orders"].as<size_t>();
+    if (node["seed"]) feed.seed = node["seed"].as<uint64_t>();
+    if (node["mix"]) {
+        const YAML::Node &mix = node["mix"];
+        const char *const names[] = {"add", "execute", "modify", "reduce", "delete", "trade"};
+        for (size_t i = 0; i < feed.mix.size(); ++i)
+            if (mix[names[i]]) feed.mix[i] = mix[names[i]].as<uint32_t>();
+    }
+    if (node["packets"]) source_config.packets = node["packets"].as<uint64_t>();
+    if (node["rate_pps"]) source_config.rate_pps = node["rate_pps"].as<uint64_t>();
+    if (node["batch_size"]) source_config.batch_size = node["batch_size"].as<size_t>();
+    if (node["core_affinity"]) source_config.cpu_affinity_core = node["core_affinity"].as<int>();
+    return source_config;
+}
+
+/**
+ * @brief Read the `gap_recovery` section (Gap Request Proxy session for missed sequences).
+ */
+GapRecoveryClient::Config parse_gap_recovery(const YAML::Node &node) {
+    GapRecoveryClient::Config recovery_config;
+    if (node["host"]) recovery_config.host = node["host"].as<std::string>();
+    if (node["port"]) recovery_config.port = node["port"].as<uint16_t>();
+    if (node["session_sub_id"]) recovery_config.session_sub_id = node["session_sub_id"].as<std::string>();
+    if (node["username"]) recovery_config.username = node["username"].as<std::string>();
+    if (node["password"]) recovery_config.password = node["password"].as<std::string>();
+    if (node["max_requests_per_second"])
+        recovery_config.max_requests_per_second = node["max_requests_per_second"].as<uint32_t>();
+    if (node["max_batch_messages"]) recovery_config.max_batch_messages = node["max_batch_messages"].as<uint32_t>();
+    if (node["max_outstanding"]) recovery_config.max_outstanding = node["max_outstanding"].as<size_t>();
+    if (node["request_timeout_ms"]) recovery_config.request_timeout_ms = node["request_timeout_ms"].as<uint32_t>();
+    if (node["retry_delay_ms"]) recovery_config.retry_delay_ms = node["retry_delay_ms"].as<uint32_t>();
+    if (node["connect_timeout_ms"]) recovery_config.connect_timeout_ms = node["connect_timeout_ms"].as<uint32_t>();
+    if (node["batch_size"]) recovery_config.batch_size = node["batch_size"].as<size_t>();
+    if (node["core_affinity"]) recovery_config.cpu_affinity_core = node["core_affinity"].as<int>();
+    if (node["replay_port"]) recovery_config.replay_port = node["replay_port"].as<uint16_t>();
+    if (node["replay_ip"]) recovery_config.replay_bind_ip = node["replay_ip"].as<std::string>();
+    if (node["replay_multicast_group"])
+        recovery_config.replay_multicast_group = node["replay_multicast_group"].as<std::string>();
+    if (node["replay_interface"]) recovery_config.replay_interface_ip = node["replay_interface"].as<std::string>();
+    if (node["replay_source"]) recovery_config.replay_source_ip = node["replay_source"].as<std::string>();
+    return recovery_config;
+}
+
+/**
+ * @brief Print the gap recovery session counters.
+ */
+void print_gap_recovery_stats(const GapRecoveryClient &client) {
+    auto stats = client.stats();
+    std::cout << "[STATS] gap_recovery " << (stats.logged_in ? "logged_in" : "disconnected")
+            << " logins=" << stats.logins
+            << " gaps=" << stats.gaps
+            << " requests=" << stats.requests
+            << " accepted=" << stats.accepted
+            << " rejected=" << stats.rejected
+            << " retried=" << stats.retried
+            << " timed_out=" << stats.timed_out
+            << " recovered_packets=" << stats.recovered_packets
+            << " recovered_messages=" << stats.recovered_messages
+            << " discarded_messages=" << stats.discarded_messages
+            << " unrecovered_messages=" << stats.unrecovered_messages << "\n";
+}
+
+/**
+ * @brief Print the synthetic feed progress.
+ */
+void print_synthetic_source_stats(const SyntheticSource &source) {
+    auto stats = source.stats();
+    std::cout << "[STATS] synthetic symbols=" << source.config().feed.symbols
+            << " packets=" << stats.packets
+            << " messages=" << stats.messages
+            << " bytes=" << stats.bytes
+            << (stats.finished ? " finished" : "") << "\n";
+}
+
+/**
+ * @brief Print the capture replay progress.
+ */
+void print_pcap_source_stats(const PcapSource &source) {
+    auto stats = source.stats();
+    std::cout << "[STATS] pcap " << source.config().file
+            << " pacing=" << PcapSource::pacing_name(source.config().pacing)
+            << " packets=" << stats.packets
+            << " bytes=" << stats.bytes
+            << " filtered=" << stats.filtered
+            << " loops=" << stats.loops
+            << (stats.finished ? " finished" : "") << "\n";
+}
+
+/**
+ * @brief Print one line per pipeline latency stage (wire = kernel receive timestamp).
+ */
+void print_latency_stats() {
+    for (const auto *stage: {&latency_parsed, &latency_dispatched, &latency_kafka}) {
+        auto snapshot = stage->snapshot();
+        std::cout << "[STATS] latency " << stage->name()
+                << " count=" << snapshot.count << std::fixed << std::setprecision(1)
+                << " mean_us=" << snapshot.mean_ns / 1000.0
+                << " p50_us<=" << snapshot.p50_ns / 1000.0
+                << " p99_us<=" << snapshot.p99_ns / 1000.0
+                << " max_us=" << snapshot.max_ns / 1000.0 << std::defaultfloat << "\n";
+    }
+    std::cout << std::setprecision(6) << std::flush;
+}
+
+/**
+ * @brief Print per-line A/B arbitration statistics (win rate and the line's own loss).
+ */
+void print_arbiter_stats(const equix_md::LineArbiter &arbiter) {
+    uint64_t total_wins = 0;
+    for (size_t line = 0; line < arbiter.line_count(); ++line) total_wins += arbiter.line_stats(line).wins;
+    for (size_t line = 0; line < arbiter.line_count(); ++line) {
+        auto stats = arbiter.line_stats(line);
+        double win_rate = total_wins ? 100.0 * static_cast<double>(stats.wins) / static_cast<double>(total_wins) : 0.0;
+        std::cout << "[STATS] line " << static_cast<char>('A' + line)
+                << " packets=" << stats.packets
+                << " wins=" << stats.wins << " (" << std::fixed << std::setprecision(1) << win_rate << "%)"
+                << std::defaultfloat
+                << " duplicates=" << stats.duplicates
+                << " stale=" << stats.stale
+                << " gaps=" << stats.gaps
+                << " (kernel=" << stats.kernel_gaps << " upstream=" << stats.upstream_gaps << ")"
+                << " lost_messages=" << stats.lost_messages << "\n";
+    }
+    std::cout << std::setprecision(6);
+}
+
+/**
+ * @brief Print sequence continuity for every unit seen so far.
+ */
+void print_sequence_stats(const equix_md::SequenceTracker &tracker) {
+    for (size_t unit = 0; unit < equix_md::SequenceTracker::kMaxUnits; ++unit) {
+        auto stats = tracker.unit_stats(static_cast<uint8_t>(unit));
+        if (stats.next_sequence == 0 && stats.heartbeats == 0) continue;
+        std::cout << "[STATS] unit " << unit
+                << " next_sequence=" << stats.next_sequence
+                << " packets=" << stats.packets
+                << " messages=" << stats.messages
+                << " heartbeats=" << stats.heartbeats
+                << " gaps=" << stats.gaps
+                << " lost_messages=" << stats.lost_messages
+                << " duplicates=" << stats.duplicates
+                << " resets=" << stats.resets << "\n";
+    }
+    if (tracker.gap_events_dropped() > 0)
+        std::cout << "[STATS] sequence gap_events_dropped=" << tracker.gap_events_dropped() << "\n";
+}
+
+/**
+ * @brief Print the reorder window counters of every unit that had to hold packets.
+ */
+void print_reorder_stats(const equix_md::ReorderBuffer &buffer) {
+    for (size_t unit = 0; unit < equix_md::ReorderBuffer::kMaxUnits; ++unit) {
+        auto stats = buffer.unit_stats(static_cast<uint8_t>(unit));
+        if (stats.held == 0 && stats.late == 0 && stats.overflows == 0) continue;
+        std::cout << "[STATS] reorder unit " << unit
+                << " holding=" << stats.holding
+                << " held=" << stats.held
+                << " reordered=" << stats.reordered
+                << " expired_holes=" << stats.expired_holes
+                << " reported_holes=" << stats.reported_holes
+                << " overflows=" << stats.overflows
+                << " skipped_messages=" << stats.skipped_messages
+                << " late=" << stats.late
+                << " duplicates=" << stats.duplicates << "\n";
+    }
+}
+
+/**
+ * @brief Log the gap events published since the last call.
+ */
+void log_sequence_gaps(equix_md::SequenceTracker &tracker) {
+    equix_md::SequenceGap gap;
+    while (tracker.poll_gap(gap)) {
+        std::cerr << "[Sequence] Gap on unit " << static_cast<int>(gap.unit) << ": sequences "
+                << gap.first_sequence << ".." << gap.first_sequence + gap.count - 1
+                << " (" << gap.count << " messages)\n";
+    }
+}
+
+/**
+ * @brief Map a YAML line name ("A".."D", case-insensitive) to an arbiter line index.
+ * @return Line index, or -1 if the name is not a valid line.
+ */
+int parse_line_name(const std::string &name) {
+    if (name.size() != 1) return -1;
+    int index = std::toupper(static_cast<unsigned char>(name[0])) - 'A';
+    return (index >= 0 && index < static_cast<int>(equix_md::LineArbiter::kMaxLines)) ? index : -1;
+}
+
 /**
  * @brief Signal handler for SIGINT/SIGTERM.
  * Sets shutdown flag and prints notification.
@@ -151,6 +481,19 @@ using MsgPtr = std::shared_ptr<CboePitch::Message>;
 // Constants for symbol queue configuration.
 constexpr size_t kSymbolQueueCapacity = 4096;
 constexpr size_t kInitialSymbolTableSize = 300000;
+// Pooled datagram buffers shared by all receivers (~2 KB each). Must cover every packet still
+// referenced by a queued or in-flight message.
+constexpr size_t kPacketPoolSize = 16384;
+
+// Per-packet message slabs (~10 KB each). Packets parsed while all are busy fall back to one heap
+// allocation per message (counted as arena_exhausted).
+constexpr size_t kMessageArenaCount = 4096;
+
+// Declared before the router so it is destroyed after every queued message releases its buffer.
+equix_md::PacketBufferPool packet_pool(kPacketPoolSize);
+
+// Arena leases hold packet buffers: declared after the packet pool and before the router.
+CboePitch::MessageArenaPool message_arena_pool(kMessageArenaCount);
 
 // Router manages queues for each symbol (for per-symbol concurrency).
 SymbolQueueRouter symbol_queue_router(kSymbolQueueCapacity, kInitialSymbolTableSize);
@@ -191,17 +534,27 @@ int main() {
             return;
         }
         ++total_messages_processed;
+        latency_dispatched.record_since(msgPtr->getReceiveTimestamp());
 
-        // 1. Symbol extraction (real implementation should not use placeholder!)
-        std::string symbol = msgPtr->getSymbol();
-        if (symbol.empty())symbol = "UNKNOWN";
+        // 1. Symbol and type, dispatched once on the message's type tag (no virtual calls)
+        equix_md::Symbol symbol;
+        uint8_t message_type = 0;
+        CboePitch::visitMessage(*msgPtr, [&symbol, &message_type](const auto &message) {
+            symbol = CboePitch::symbolOf(message);
+            message_type = CboePitch::messageTypeOf(message);
+        });
+        if (symbol.empty()) symbol = kUnknownSymbol;
 
         // 2. Partition (let Kafka decide or hash your way)
-        int partition = hash_message_type_to_partition_advanced(msgPtr->getMessageType(), NUM_KAFKA_PARTITIONS); //
+        int partition = hash_message_type_to_partition_advanced(message_type, NUM_KAFKA_PARTITIONS); //
         // std::cout << "Partition: " << partition << std::endl;
         // 3. Push to Kafka
         // std::string json_body = R"({"dummy": "data", "id": )" + std::to_string(msgPtr->getOrderId()) + "}";
         KafkaPush(symbol, partition, msgPtr->getPayload().data(), msgPtr->getPayload().size());
+        // KafkaPush copied the bytes; drop this message's hold on the packet buffer so it can be
+        // recycled without waiting for the ring slot to be overwritten.
+        msgPtr->releasePayload();
+        latency_kafka.record_since(msgPtr->getReceiveTimestamp());
     };
     disruptor_pipeline::DisruptorRouter<MsgPtr> disruptor_router(
         kDisruptorRingSize, disruptor_event_handler);
@@ -216,9 +569,71 @@ int main() {
 
     // ---- UDP Receiver Initialization ----
     // Loads configuration, instantiates UDP receivers, or falls back to default if config is missing/invalid.
+    // Redundant feed lines: receivers tagged with `line` are arbitrated (first copy wins).
+    std::unique_ptr<equix_md::LineArbiter> line_arbiter;
+    std::vector<int> receiver_lines; // Arbiter line per receiver, -1 = not arbitrated
     std::vector<std::unique_ptr<UdpReceiver> > udp_receivers;
+    // Shared receive threads: receivers naming a `thread` are served by that group instead of their own thread.
+    std::vector<UdpReceiverGroup::Config> receiver_thread_configs;
+    std::vector<std::string> receiver_threads; // Group name per receiver, empty = dedicated thread
+    // Capture replay: datagrams from a pcap/pcapng file enter the same callback as received ones.
+    std::unique_ptr<PcapSource> pcap_source;
+    int pcap_source_line = -1;
+    // Synthetic feed: generated datagrams enter the same callback (never arbitrated).
+    std::unique_ptr<SyntheticSource> synthetic_source;
+    // decode_mode: lazy routes raw slices (type, order id and symbol only) and leaves the full decode
+    // to the consumer; full builds every message object on the receive thread.
+    bool lazy_decode = false;
+    // Gap recovery: the client is created once the SequenceTracker exists.
+    std::optional<GapRecoveryClient::Config> gap_recovery_config;
+    // Reorder window between arbitration and parsing (reorder_buffer section); created with the tracker.
+    std::optional<equix_md::ReorderBuffer::Config> reorder_config;
+    std::unique_ptr<equix_md::ReorderBuffer> reorder_buffer;
     try {
         YAML::Node config_node = YAML::LoadFile("config/config.yaml");
+        if (config_node["decode_mode"]) {
+            auto mode = config_node["decode_mode"].as<std::string>();
+            if (mode == "lazy" || mode == "full") {
+                lazy_decode = mode == "lazy";
+            } else {
+                std::cerr << "[WARN] Unknown decode_mode '" << mode << "' – using full.\n";
+            }
+        }
+        if (config_node["receiver_threads"] && config_node["receiver_threads"].IsSequence()) {
+            for (const auto &thread_node: config_node["receiver_threads"])
+                receiver_thread_configs.push_back(parse_receiver_thread(thread_node));
+        }
+        if (config_node["pcap_source"] && config_node["pcap_source"]["file"]) {
+            const YAML::Node &source_node = config_node["pcap_source"];
+            pcap_source = std::make_unique<PcapSource>(parse_pcap_source(source_node), packet_pool);
+            if (source_node["line"]) {
+                auto line_name = source_node["line"].as<std::string>();
+                pcap_source_line = parse_line_name(line_name);
+                if (pcap_source_line < 0) {
+                    std::cerr << "[WARN] Invalid line '" << line_name << "' for pcap_source"
+                            << " – replay will not be arbitrated.\n";
+                }
+            }
+        }
+        if (config_node["synthetic_source"] && config_node["synthetic_source"]["symbols"]) {
+            try {
+                synthetic_source = std::make_unique<SyntheticSource>(
+                    parse_synthetic_source(config_node["synthetic_source"]), packet_pool);
+            } catch (const std::invalid_argument &exception) {
+                std::cerr << "[ERROR] synthetic_source disabled: " << exception.what() << "\n";
+            }
+        }
+        if (config_node["reorder_buffer"]) {
+            const YAML::Node &reorder_node = config_node["reorder_buffer"];
+            reorder_config.emplace();
+            if (reorder_node["window"]) reorder_config->window = reorder_node["window"].as<uint32_t>();
+            if (reorder_node["max_hold_us"]) reorder_config->max_hold_us = reorder_node["max_hold_us"].as<uint32_t>();
+            if (reorder_node["recovery_hold_us"])
+                reorder_config->recovery_hold_us = reorder_node["recovery_hold_us"].as<uint32_t>();
+        }
+        if (config_node["gap_recovery"] && config_node["gap_recovery"]["port"]) {
+            gap_recovery_config = parse_gap_recovery(config_node["gap_recovery"]);
+        }
         if (config_node["udp_receivers"] && config_node["udp_receivers"].IsSequence() && config_node["udp_receivers"].
             size() > 0) {
             // Multiple UDP receivers may be configured for different IPs/ports.
@@ -228,57 +643,274 @@ int main() {
                 if (receiver_node["port"]) receiver_config.bind_port = receiver_node["port"].as<uint16_t>();
                 if (receiver_node["core_affinity"])
                     receiver_config.cpu_affinity_core = receiver_node["core_affinity"].as<int>();
-                udp_receivers.emplace_back(std::make_unique<UdpReceiver>(receiver_config));
+                if (receiver_node["batch_size"])
+                    receiver_config.batch_size = receiver_node["batch_size"].as<size_t>();
+                if (receiver_node["idle_strategy"]) {
+                    auto name = receiver_node["idle_strategy"].as<std::string>();
+                    auto strategy = UdpReceiver::idle_strategy_from_string(name);
+                    if (strategy) {
+                        receiver_config.idle_strategy = *strategy;
+                    } else {
+                        std::cerr << "[WARN] Unknown idle_strategy '" << name << "' for port "
+                                << receiver_config.bind_port << " – using "
+                                << UdpReceiver::idle_strategy_name(receiver_config.idle_strategy) << ".\n";
+                    }
+                }
+                if (receiver_node["idle_spin_count"])
+                    receiver_config.idle_spin_count = receiver_node["idle_spin_count"].as<uint32_t>();
+                if (receiver_node["busy_poll_usec"])
+                    receiver_config.busy_poll_usec = receiver_node["busy_poll_usec"].as<int>();
+                if (receiver_node["epoll_timeout_ms"])
+                    receiver_config.epoll_timeout_ms = receiver_node["epoll_timeout_ms"].as<int>();
+                if (receiver_node["multicast_group"])
+                    receiver_config.multicast_group = receiver_node["multicast_group"].as<std::string>();
+                if (receiver_node["interface"])
+                    receiver_config.interface_ip = receiver_node["interface"].as<std::string>();
+                if (receiver_node["source"])
+                    receiver_config.source_ip = receiver_node["source"].as<std::string>();
+                if (receiver_node["recv_buffer_bytes"])
+                    receiver_config.recv_buffer_bytes = receiver_node["recv_buffer_bytes"].as<int>();
+                if (receiver_node["kernel_timestamps"])
+                    receiver_config.kernel_timestamps = receiver_node["kernel_timestamps"].as<bool>();
+                if (receiver_node["backend"]) {
+                    auto name = receiver_node["backend"].as<std::string>();
+                    auto backend = UdpReceiver::backend_from_string(name);
+                    if (backend) {
+                        receiver_config.backend = *backend;
+                    } else {
+                        std::cerr << "[WARN] Unknown backend '" << name << "' for port "
+                                << receiver_config.bind_port << " – using "
+                                << UdpReceiver::backend_name(receiver_config.backend) << ".\n";
+                    }
+                }
+                if (receiver_node["capture_interface"])
+                    receiver_config.capture_interface = receiver_node["capture_interface"].as<std::string>();
+                if (receiver_node["ring_block_bytes"])
+                    receiver_config.ring_block_bytes = receiver_node["ring_block_bytes"].as<uint32_t>();
+                if (receiver_node["ring_block_count"])
+                    receiver_config.ring_block_count = receiver_node["ring_block_count"].as<uint32_t>();
+                if (receiver_node["ring_block_timeout_ms"])
+                    receiver_config.ring_block_timeout_ms = receiver_node["ring_block_timeout_ms"].as<uint32_t>();
+                if (receiver_node["uring_buffer_count"])
+                    receiver_config.uring_buffer_count = receiver_node["uring_buffer_count"].as<uint32_t>();
+                int line = -1;
+                if (receiver_node["line"]) {
+                    auto line_name = receiver_node["line"].as<std::string>();
+                    line = parse_line_name(line_name);
+                    if (line < 0) {
+                        std::cerr << "[WARN] Invalid line '" << line_name << "' for port "
+                                << receiver_config.bind_port << " – receiver will not be arbitrated.\n";
+                    }
+                }
+                udp_receivers.emplace_back(std::make_unique<UdpReceiver>(receiver_config, packet_pool));
+                receiver_lines.push_back(line);
+                receiver_threads.push_back(receiver_node["thread"] ? receiver_node["thread"].as<std::string>() : "");
             }
         } else {
             // Fallback to default config if no receivers defined.
             std::cerr << "[WARN] 'udp_receivers' config missing or empty – using default config.\n";
-            udp_receivers.emplace_back(std::make_unique<UdpReceiver>(UdpReceiver::Config{}));
+            udp_receivers.emplace_back(std::make_unique<UdpReceiver>(UdpReceiver::Config{}, packet_pool));
+            receiver_lines.push_back(-1);
+            receiver_threads.push_back("");
         }
     } catch (const YAML::Exception &exception) {
         std::cerr << "[ERROR] Failed to load config file (" << exception.what() << ") – using default config.\n";
-        udp_receivers.emplace_back(std::make_unique<UdpReceiver>(UdpReceiver::Config{}));
+        udp_receivers.clear();
+        receiver_lines.assign(1, -1);
+        receiver_thread_configs.clear();
+        receiver_threads.assign(1, "");
+        pcap_source.reset();
+        pcap_source_line = -1;
+        synthetic_source.reset();
+        reorder_config.reset();
+        gap_recovery_config.reset();
+        udp_receivers.emplace_back(std::make_unique<UdpReceiver>(UdpReceiver::Config{}, packet_pool));
     }
 
-    // ---- UDP Packet Processing ----
-    // Lambda called for every UDP packet received. Parses message and enqueues by symbol.
-    auto on_udp_packet = [&symbol_map](const std::vector<char> &packet) {
-        try {
-            // 1. Parse SeqUnitHeader (optional, for logging/debug)
-            auto header = CboePitch::SeqUnitHeader::parse(reinterpret_cast<const uint8_t *>(packet.data()),
-                                                          packet.size());
-            //std::cout << "[SeqUnitHeader] " << header.toString() << std::endl;
+    int max_line = pcap_source_line;
+    for (int line: receiver_lines) max_line = std::max(max_line, line);
+    if (max_line >= 0) {
+        line_arbiter = std::make_unique<equix_md::LineArbiter>(static_cast<size_t>(max_line) + 1);
+        std::cout << "[MAIN] A/B line arbitration enabled across " << max_line + 1 << " line(s)\n";
+    }
+    if (lazy_decode) std::cout << "[MAIN] Lazy decoding: receive threads route raw messages\n";
 
-            // 2. Parse messages with SymbolIdentifier
-            auto messages = CboePitch::MessageFactory::parseMessages(
-                reinterpret_cast<const uint8_t *>(packet.data()), packet.size(), symbol_map);
+    // Per-unit sequence continuity of the packets that survive arbitration; gaps are logged by the main
+    // loop, or requested from the Gap Request Proxy when gap_recovery is configured.
+    equix_md::SequenceTracker sequence_tracker;
+    std::unique_ptr<GapRecoveryClient> gap_recovery;
+    if (gap_recovery_config) {
+        try {
+            gap_recovery = std::make_unique<GapRecoveryClient>(*gap_recovery_config, sequence_tracker, packet_pool);
+        } catch (const std::exception &exception) {
+            std::cerr << "[ERROR] gap_recovery disabled: " << exception.what() << "\n";
+        }
+    }
+    // Replayed messages are spliced in order through the reorder window, which holds a unit's later
+    // packets while its hole is recovered: gap recovery brings one with default settings if needed.
+    if (gap_recovery && !reorder_config) reorder_config.emplace();
+    if (gap_recovery && reorder_config->recovery_hold_us == 0) { // Default: as long as a request may take
+        reorder_config->recovery_hold_us = static_cast<uint32_t>(
+            std::min<uint64_t>(static_cast<uint64_t>(gap_recovery->config().request_timeout_ms) * 1000, UINT32_MAX));
+    }
+    if (gap_recovery && reorder_config->window != 0 &&
+        reorder_config->window < equix_md::ReorderBuffer::kRecoveryWindow) {
+        std::cerr << "[WARN] reorder_buffer window " << reorder_config->window << " is below "
+                << equix_md::ReorderBuffer::kRecoveryWindow << ": a busy unit may overflow it before a replay"
+                << " returns, and the replay is then dropped as late.\n";
+    }
+    if (reorder_config) {
+        reorder_buffer = std::make_unique<equix_md::ReorderBuffer>(*reorder_config,
+                                                                   gap_recovery ? &sequence_tracker : nullptr);
+        std::cout << "[MAIN] Reorder window: " << reorder_buffer->window() << " messages, "
+                << reorder_buffer->max_hold_ns() / 1000 << " us per unit";
+        if (reorder_buffer->recovery_hold_ns()) {
+            std::cout << ", holes reported for recovery are held " << reorder_buffer->recovery_hold_ns() / 1000
+                    << " us more";
+        }
+        std::cout << "\n";
+    }
 
-            // 3. For each message, push to symbol queue
+    // ---- UDP Packet Processing ----
+    // Parses a packet's messages and enqueues them by symbol (received and recovered packets alike).
+    // Runs on every receive thread, the main loop and the gap recovery thread; symbol_map locks itself.
+    auto dispatch_packet = [&symbol_map, &lazy_decode](const UdpReceiver::Packet &packet) {
+        const auto *packet_data = reinterpret_cast<const uint8_t *>(packet.data);
+        const size_t packet_size = packet.size;
+        try {
+            // Parse (or, in lazy mode, only route) messages with SymbolIdentifier
+            // Messages reference their slice of the pooled packet instead of copying it.
+            auto messages = lazy_decode
+                                ? CboePitch::MessageFactory::routeMessages(packet_data, packet_size, symbol_map,
+                                                                           packet.buffer, &message_arena_pool)
+                                : CboePitch::MessageFactory::parseMessages(packet_data, packet_size, symbol_map,
+                                                                           packet.buffer, &message_arena_pool);
+
+            // For each message, push to symbol queue
             for (const auto &msgPtr: messages) {
                 if (!msgPtr) continue;
 
                 // If desired, print or log the message:
                 // std::cout << msgPtr->toString() << std::endl;
 
-                // Extract symbol from message
-                std::string symbol = msgPtr->getSymbol();
+                // Extract symbol from message (statically dispatched, see message_visit.h)
+                equix_md::Symbol symbol = CboePitch::routingSymbol(*msgPtr);
                 // If no symbol detected, add default
                 if (symbol.empty()) {
-                    symbol = "UNKNOWN";
+                    symbol = kUnknownSymbol;
                 }
                 // Push to per-symbol queue
                 symbol_queue_router.push(symbol, msgPtr);
             }
+            latency_parsed.record_since(packet.buffer ? packet.buffer->rx_timestamp_ns : 0);
         } catch (const std::exception &ex) {
             std::cerr << "[UDP] Parse error: " << ex.what() << std::endl;
         }
     };
 
+    // Lambda called for every UDP packet received: tracks the unit's sequence, then dispatches.
+    auto on_udp_packet = [&dispatch_packet, &sequence_tracker](const UdpReceiver::Packet &packet) {
+        try {
+            auto header = CboePitch::SeqUnitHeader::parse(reinterpret_cast<const uint8_t *>(packet.data), packet.size);
+            sequence_tracker.on_packet(header.getUnit(), header.getSequence(), header.getCount(),
+                                       packet.buffer ? packet.buffer->rx_timestamp_ns : 0);
+            //std::cout << "[SeqUnitHeader] " << header.toString() << std::endl;
+        } catch (const std::exception &ex) {
+            std::cerr << "[UDP] Parse error: " << ex.what() << std::endl;
+            return;
+        }
+        dispatch_packet(packet);
+    };
+
+    // Batch callback: a receiver hands over every datagram of one recvmmsg() call at once.
+    // Packets from an arbitrated line are dropped here if the other line already delivered them;
+    // with a reorder window, the survivors reach on_udp_packet in sequence order per unit.
+    auto make_batch_callback = [&on_udp_packet, &line_arbiter, &reorder_buffer](int line) {
+        return UdpReceiver::BatchPacketCallback(
+            [&on_udp_packet, &line_arbiter, &reorder_buffer, line](const UdpReceiver::Packet *packets, size_t count) {
+                const uint64_t now_ns = reorder_buffer ? equix_md::monotonic_now_ns() : 0;
+                for (size_t i = 0; i < count; ++i) {
+                    const UdpReceiver::Packet &packet = packets[i];
+                    if ((line < 0 && !reorder_buffer) || packet.size < 8) {
+                        on_udp_packet(packet);
+                        continue;
+                    }
+                    auto header = CboePitch::SeqUnitHeader::parse(
+                        reinterpret_cast<const uint8_t *>(packet.data), packet.size);
+                    if (line >= 0) {
+                        auto verdict = line_arbiter->on_packet(static_cast<size_t>(line), header.getUnit(),
+                                                               header.getSequence(), header.getCount(),
+                                                               packet.kernel_drops);
+                        if (verdict == equix_md::LineArbiter::Verdict::Duplicate ||
+                            verdict == equix_md::LineArbiter::Verdict::Stale) {
+                            continue;
+                        }
+                    }
+                    if (reorder_buffer) {
+                        reorder_buffer->on_packet(packet, header.getUnit(), header.getSequence(), header.getCount(),
+                                                  now_ns, on_udp_packet);
+                    } else {
+                        on_udp_packet(packet);
+                    }
+                }
+            });
+    };
+
     // ---- Start UDP Receivers ----
-    // All receivers run in background threads; incoming packets trigger above callback.
-    for (auto &udp_receiver: udp_receivers)
-        udp_receiver->start(on_udp_packet);
+    // Receivers run on their own background thread, or on the shared receive thread named by `thread`;
+    // incoming packet batches trigger above callback.
+    std::vector<std::unique_ptr<UdpReceiverGroup> > receiver_groups;
+    auto find_group = [&](const std::string &name) -> UdpReceiverGroup & {
+        for (auto &group: receiver_groups)
+            if (group->config().name == name) return *group;
+        UdpReceiverGroup::Config group_config;
+        group_config.name = name;
+        auto configured = std::find_if(receiver_thread_configs.begin(), receiver_thread_configs.end(),
+                                       [&name](const UdpReceiverGroup::Config &c) { return c.name == name; });
+        if (configured != receiver_thread_configs.end()) {
+            group_config = *configured;
+        } else {
+            std::cerr << "[WARN] Receiver thread '" << name << "' not defined in receiver_threads – using defaults.\n";
+        }
+        receiver_groups.emplace_back(std::make_unique<UdpReceiverGroup>(group_config));
+        return *receiver_groups.back();
+    };
+    for (size_t i = 0; i < udp_receivers.size(); ++i) {
+        if (receiver_threads[i].empty()) {
+            udp_receivers[i]->start(make_batch_callback(receiver_lines[i]));
+        } else {
+            find_group(receiver_threads[i]).add(*udp_receivers[i], make_batch_callback(receiver_lines[i]));
+        }
+    }
+    for (auto &group: receiver_groups) group->start();
     std::cout << "[MAIN] All UDP receivers started\n";
+    if (pcap_source) {
+        try {
+            pcap_source->start(make_batch_callback(pcap_source_line));
+        } catch (const std::exception &exception) {
+            std::cerr << "[ERROR] pcap_source disabled: " << exception.what() << "\n";
+            pcap_source.reset();
+        }
+    }
+    if (synthetic_source) synthetic_source->start(make_batch_callback(-1));
+    // Recovered one-message packets skip the arbiter and go through the reorder window: messages a late
+    // line delivered meanwhile are dropped there, the rest are released ahead of the unit's held packets.
+    if (gap_recovery) {
+        gap_recovery->start([&on_udp_packet, &reorder_buffer](const UdpReceiver::Packet *packets, size_t count) {
+            const uint64_t now_ns = equix_md::monotonic_now_ns();
+            size_t accepted = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const UdpReceiver::Packet &packet = packets[i];
+                auto header = CboePitch::SeqUnitHeader::parse(
+                    reinterpret_cast<const uint8_t *>(packet.data), packet.size);
+                if (reorder_buffer->on_packet(packet, header.getUnit(), header.getSequence(), header.getCount(),
+                                              now_ns, on_udp_packet)) {
+                    ++accepted;
+                }
+            }
+            return accepted;
+        });
+    }
 
     // ---- Worker Thread Setup ----
     // Determine how many worker threads to launch (typically 1 per CPU core).
@@ -295,6 +927,9 @@ int main() {
     size_t total_queues = symbol_queues.size();
     if (total_queues == 0) {
         std::cerr << "No symbol queues detected. Exiting.\n";
+        if (pcap_source) pcap_source->stop();
+        if (synthetic_source) synthetic_source->stop();
+        for (auto &group: receiver_groups) group->stop();
         for (auto &udp_receiver: udp_receivers) udp_receiver->stop();
 
         publish_shutdown_to_disruptor();
@@ -321,12 +956,45 @@ int main() {
 
     // ---- Main Wait Loop ----
     // Sleep until shutdown requested; worker/receiver threads will be signaled to stop.
+    // Receive statistics are printed every kStatsInterval.
+    // With a reorder window the loop also releases holes on units that went quiet, so it wakes
+    // at the hold time (1..100 ms) instead of every 100 ms.
+    constexpr auto kStatsInterval = std::chrono::seconds(5);
+    auto next_stats = std::chrono::steady_clock::now() + kStatsInterval;
+    auto loop_interval = std::chrono::microseconds(100000);
+    if (reorder_buffer) {
+        loop_interval = std::chrono::microseconds(
+            std::clamp<uint64_t>(reorder_buffer->max_hold_ns() / 1000, 1000, 100000));
+    }
     while (!shutdown_requested.load()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::this_thread::sleep_for(loop_interval);
+        if (reorder_buffer) reorder_buffer->expire(equix_md::monotonic_now_ns(), on_udp_packet);
+        if (!gap_recovery) log_sequence_gaps(sequence_tracker);
+        if (std::chrono::steady_clock::now() >= next_stats) {
+            print_receiver_stats(udp_receivers);
+            print_group_stats(receiver_groups);
+            if (pcap_source) print_pcap_source_stats(*pcap_source);
+            if (synthetic_source) print_synthetic_source_stats(*synthetic_source);
+            if (line_arbiter) print_arbiter_stats(*line_arbiter);
+            if (reorder_buffer) print_reorder_stats(*reorder_buffer);
+            print_sequence_stats(sequence_tracker);
+            if (gap_recovery) print_gap_recovery_stats(*gap_recovery);
+            print_latency_stats();
+            print_pool_stats(packet_pool, message_arena_pool);
+            next_stats += kStatsInterval;
+        }
     }
 
     // ---- Shutdown Sequence ----
-    // Stop all UDP receivers to cease packet intake.
+    // Stop all UDP receivers to cease packet intake (shared threads first: they poll the receivers).
+    if (pcap_source)
+        pcap_source->stop();
+    if (synthetic_source)
+        synthetic_source->stop();
+    if (gap_recovery)
+        gap_recovery->stop();
+    for (auto &group: receiver_groups)
+        group->stop();
     for (auto &udp_receiver: udp_receivers)
         udp_receiver->stop();
 
@@ -0,0 +1,1041 @@
+/**
+ * @file    cboe_bench.cpp
+ * @brief   Micro-benchmarks for the feed handler hot paths.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: cboe_bench.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Stand-alone benchmark driver, built next to cboe_feed_handler.
+ *   Usage: cboe_bench <benchmark> [options]
+ *
+ *   receive  UDP receive throughput per UdpReceiver backend over loopback.
+ *            A sender thread blasts fixed-size datagrams with sendmmsg; the
+ *            receiver counts them in its batch callback. Reports delivered
+ *            packets/s and loss for each backend.
+ *            Options: --packets N  --size BYTES  --batch N
+ *
+ *   parse    PITCH decode rate over the UDP payloads of the example captures.
+ *            Compares MessageFactory::parseMessages (flat dispatch table)
+ *            with the previous std::unordered_map + std::function dispatch
+ *            on the same messages and parsers, parseMessages with a per-packet
+ *            message arena, the first phase of lazy decoding (routeMessages:
+ *            type, order id and symbol only, with the arena), and the
+ *            allocation-free flyweight views (for_each_message) reading the
+ *            same fields.
+ *            Options: --iterations N
+ *
+ *   layout   Checks the generated layout code against the example captures:
+ *            every known message is decoded, re-encoded and compared with
+ *            the original field bytes, and each field is compared with the
+ *            old byte-loop readers. Then times generated decode, debug text
+ *            and JSON. Prints one text/JSON sample per message type; exits
+ *            non-zero on any mismatch.
+ *            Options: --iterations N
+ *
+ *   route    Symbol routing hot path: decode the wire symbol field and push
+ *            into the per-symbol queues of SymbolQueueRouter, with packed
+ *            Symbol keys vs. the previous std::string keys. Symbols are drawn
+ *            with a skewed (Zipf-like) popularity. Also times the key path
+ *            alone (decode + find_queue) without the enqueue.
+ *            Options: --symbols N  --messages N  --iterations N
+ *                     --queue-capacity N (lower it for large symbol counts:
+ *                     every queue preallocates its capacity)
+ *
+ *   dispatch Per-message accessors of the pipeline on a mixed synthetic feed
+ *            (adds, executes, modifies, reductions, deletes, trades): virtual
+ *            getSymbol/getMessageType/getOrderId through shared_ptr<Message>
+ *            vs. visitMessage, which switches on the type tag and calls the
+ *            final classes directly. Timed with and without the symbol lookup.
+ *            Options: --messages N  --symbols N  --iterations N
+ *
+ *   sequence SequenceTracker cost per packet header: a round-robin stream
+ *            over several units with a gap and a duplicate injected every
+ *            N packets, plus a heartbeat per unit every 100 packets. Checks
+ *            that exactly the injected gaps and duplicates are reported.
+ *            Options: --packets N  --units N  --fault-every N
+ *
+ *   reorder  ReorderBuffer cost per packet on an in-order stream, then on a
+ *            stream where every N-th packet of a unit swaps places with the
+ *            next one and every M-th is lost (the clock advances 1 us per
+ *            packet). Checks that every unit comes out in sequence order,
+ *            that every packet is released once and that every loss is
+ *            skipped as a hole.
+ *            Options: --packets N  --units N  --swap-every N  --loss-every N
+ *                     --window N  --max-hold-us N
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "UdpReceiver.hpp"
+#include "PacketBufferPool.hpp"
+#include "PcapReader.hpp"
+#include "Symbol.hpp"
+#include "SymbolIdentifier.hpp"
+#include "SequenceTracker.hpp"
+#include "ReorderBuffer.hpp"
+#include "SymbolQueueRouter.hpp"
+#include "SyntheticFeed.hpp"
+#include "pitch/message_dispatcher.h"
+#include "pitch/message_factory.h"
+#include "pitch/message_index.h"
+#include "pitch/message_layout.h"
+#include "pitch/message_views.h"
+#include "pitch/message_visit.h"
+#include "pitch/seq_unit_header.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief "--name value" options after the benchmark name.
+ */
+class Options {
+public:
+    Options(int argc, char **argv, int first) {
+        for (int i = first; i + 1 < argc; i += 2) {
+            std::string key = argv[i];
+            if (key.rfind("--", 0) != 0) throw std::invalid_argument("Unexpected argument: " + key);
+            values_[key.substr(2)] = argv[i + 1];
+        }
+    }
+
+    uint64_t get(const std::string &name, uint64_t fallback) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? fallback : std::stoull(it->second);
+    }
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+// ---- receive ----
+
+struct ReceiveResult {
+    uint64_t received = 0;
+    double seconds = 0;
+    UdpReceiver::Backend backend = UdpReceiver::Backend::Socket; ///< Backend actually used (after fallback)
+};
+
+/**
+ * @brief Send `packets` datagrams of `size` bytes to 127.0.0.1:port as fast as sendmmsg allows.
+ */
+void blast_udp(uint16_t port, uint64_t packets, size_t size) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) throw std::runtime_error("sender socket: " + std::string(strerror(errno)));
+    int sndbuf = 4 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+    sockaddr_in dest{};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(port);
+    dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&dest), sizeof(dest)) < 0) {
+        close(fd);
+        throw std::runtime_error("sender connect: " + std::string(strerror(errno)));
+    }
+
+    constexpr size_t kBurst = 64;
+    std::vector<char> payload(size, 'x');
+    std::vector<iovec> iov(kBurst);
+    std::vector<mmsghdr> msgs(kBurst);
+    for (size_t i = 0; i < kBurst; ++i) {
+        iov[i] = {payload.data(), size};
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    uint64_t sent = 0;
+    while (sent < packets) {
+        unsigned burst = static_cast<unsigned>(std::min<uint64_t>(kBurst, packets - sent));
+        int n = sendmmsg(fd, msgs.data(), burst, 0);
+        if (n > 0) {
+            sent += static_cast<uint64_t>(n);
+        } else if (errno != EAGAIN && errno != ENOBUFS && errno != EINTR) {
+            std::cerr << "[bench] sendmmsg: " << strerror(errno) << std::endl;
+            break;
+        }
+    }
+    close(fd);
+}
+
+ReceiveResult run_receive(const UdpReceiver::Config &config, uint64_t packets, size_t size) {
+    equix_md::PacketBufferPool pool(16384);
+    UdpReceiver receiver(config, pool);
+
+    std::atomic<uint64_t> received{0};
+    std::atomic<int64_t> first_ns{0};
+    std::atomic<int64_t> last_ns{0};
+    receiver.start(UdpReceiver::BatchPacketCallback([&](const UdpReceiver::Packet *, size_t count) {
+        int64_t now = Clock::now().time_since_epoch().count();
+        if (received.load(std::memory_order_relaxed) == 0) first_ns.store(now, std::memory_order_relaxed);
+        last_ns.store(now, std::memory_order_relaxed);
+        received.fetch_add(count, std::memory_order_relaxed);
+    }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    blast_udp(config.bind_port, packets, size);
+
+    // Drain: stop once nothing has arrived for 200 ms.
+    uint64_t seen = received.load();
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        uint64_t now = received.load();
+        if (now == seen) break;
+        seen = now;
+    }
+    receiver.stop();
+
+    ReceiveResult result;
+    result.backend = receiver.config().backend;
+    result.received = received.load();
+    result.seconds = std::chrono::duration<double>(Clock::duration(last_ns.load() - first_ns.load())).count();
+    return result;
+}
+
+int bench_receive(const Options &options) {
+    const uint64_t packets = options.get("packets", 2000000);
+    const size_t size = options.get("size", 64);
+    const size_t batch = options.get("batch", 32);
+
+    struct Case {
+        const char *name;
+        UdpReceiver::Backend backend;
+        size_t batch_size;
+    };
+    const Case cases[] = {
+        {"socket recvfrom", UdpReceiver::Backend::Socket, 1},
+        {"socket recvmmsg", UdpReceiver::Backend::Socket, batch},
+        {"io_uring multishot", UdpReceiver::Backend::IoUring, batch},
+        {"packet_mmap (lo)", UdpReceiver::Backend::PacketMmap, batch},
+    };
+
+    std::cout << "receive: " << packets << " x " << size << "-byte datagrams over loopback, batch " << batch << "\n";
+    uint16_t port = 40100;
+    for (const auto &c: cases) {
+        UdpReceiver::Config config;
+        config.bind_ip = "127.0.0.1";
+        config.bind_port = port++;
+        config.backend = c.backend;
+        config.batch_size = c.batch_size;
+        config.idle_strategy = UdpReceiver::IdleStrategy::BusySpin;
+        config.recv_buffer_bytes = 64 << 20;
+        config.capture_interface = "lo";
+        try {
+            ReceiveResult result = run_receive(config, packets, size);
+            double mpps = result.seconds > 0 ? static_cast<double>(result.received) / result.seconds / 1e6 : 0.0;
+            double loss = 100.0 * static_cast<double>(packets - std::min(packets, result.received)) /
+                          static_cast<double>(packets);
+            std::cout << "  " << std::left << std::setw(20) << c.name << std::right << std::fixed
+                      << std::setprecision(3) << " received=" << result.received << " loss=" << std::setprecision(2)
+                      << loss << "%" << " rate=" << std::setprecision(3) << mpps << " Mpps";
+            if (result.backend != c.backend)
+                std::cout << " (fell back to " << UdpReceiver::backend_name(result.backend) << ")";
+            std::cout << "\n";
+        } catch (const std::exception &ex) {
+            std::cout << "  " << std::left << std::setw(20) << c.name << " skipped: " << ex.what() << "\n";
+        }
+    }
+    return 0;
+}
+
+// ---- parse ----
+
+const char *const kExampleCaptures[] = {"example/100packet.pcap", "example/2messsage.pcap"};
+
+/**
+ * @brief UDP payloads of the example captures, copied out of the mapped files.
+ */
+std::vector<std::vector<uint8_t> > load_example_datagrams() {
+    std::vector<std::vector<uint8_t> > datagrams;
+    for (const char *path: kExampleCaptures) {
+        equix_md::PcapReader reader(path);
+        equix_md::UdpDatagramView datagram;
+        uint64_t timestamp_ns = 0;
+        while (reader.next_udp(datagram, timestamp_ns))
+            datagrams.emplace_back(datagram.payload, datagram.payload + datagram.payload_size);
+    }
+    return datagrams;
+}
+
+/**
+ * @brief The dispatch parseMessages used before the flat table: hash lookup plus std::function call.
+ */
+class LegacyDispatch {
+public:
+    LegacyDispatch() {
+        for (size_t type = 0; type < CboePitch::kMessageDispatchTable.size(); ++type) {
+            const auto &info = CboePitch::kMessageDispatchTable[type];
+            if (info.parser != nullptr) table_[static_cast<uint8_t>(type)] = Entry{info.length, info.parser};
+        }
+    }
+
+    std::vector<std::shared_ptr<CboePitch::Message> > parse_messages(const uint8_t *data, size_t length,
+                                                                    equix_md::SymbolIdentifier &symbol_map) const {
+        auto header = CboePitch::SeqUnitHeader::parse(data, length);
+        std::vector<std::shared_ptr<CboePitch::Message> > messages;
+        messages.reserve(header.getCount());
+        size_t offset = 8;
+        size_t remaining = std::min<size_t>(header.getLength(), length) - offset;
+        for (uint8_t i = 0; i < header.getCount() && remaining > 0; ++i) {
+            auto it = table_.find(data[offset + 1]);
+            if (it == table_.end() || it->second.length > remaining) break;
+            messages.push_back(it->second.parser(data, offset + remaining, offset, symbol_map));
+            offset += it->second.length;
+            remaining -= it->second.length;
+        }
+        return messages;
+    }
+
+    /// Lookup only: the message lengths the dispatch yields for a packet, without parsing.
+    size_t walk(const uint8_t *data, size_t length) const {
+        size_t offset = 8, total = 0;
+        const size_t end = std::min<size_t>(CboePitch::SeqUnitHeader::parse(data, length).getLength(), length);
+        while (offset + 1 < end) {
+            auto it = table_.find(data[offset + 1]);
+            if (it == table_.end()) break;
+            total += it->second.length;
+            offset += it->second.length;
+        }
+        return total;
+    }
+
+private:
+    struct Entry {
+        size_t length;
+        std::function<std::shared_ptr<CboePitch::Message>(const uint8_t *, size_t, size_t,
+                                                           equix_md::SymbolIdentifier &)> parser;
+    };
+
+    std::unordered_map<uint8_t, Entry> table_;
+};
+
+/// Lookup only through the flat table.
+size_t walk_table(const uint8_t *data, size_t length) {
+    size_t offset = 8, total = 0;
+    const size_t end = std::min<size_t>(CboePitch::SeqUnitHeader::parse(data, length).getLength(), length);
+    while (offset + 1 < end) {
+        const auto &info = CboePitch::MessageDispatch::lookup(data[offset + 1]);
+        if (info.parser == nullptr) break;
+        total += info.length;
+        offset += info.length;
+    }
+    return total;
+}
+
+int bench_parse(const Options &options) {
+    const uint64_t iterations = options.get("iterations", 2000);
+    const auto datagrams = load_example_datagrams();
+    if (datagrams.empty()) throw std::runtime_error("no datagrams in the example captures (run from the repo root)");
+
+    // Deletes of orders added before the capture started log a warning on every pass; mute them.
+    std::streambuf *saved_cerr = std::cerr.rdbuf(nullptr);
+    const LegacyDispatch legacy;
+    CboePitch::MessageArenaPool arenas(64);
+    double legacy_seconds = 0, table_seconds = 0, arena_seconds = 0, route_seconds = 0;
+    uint64_t legacy_messages = 0, table_messages = 0, arena_messages = 0, route_messages = 0;
+    for (uint64_t pass = 0; pass < iterations; ++pass) {
+        // A fresh symbol map per pass so every pass sees the same add/delete sequence.
+        {
+            equix_md::SymbolIdentifier symbol_map(1024);
+            auto start = Clock::now();
+            for (const auto &datagram: datagrams)
+                legacy_messages += legacy.parse_messages(datagram.data(), datagram.size(), symbol_map).size();
+            legacy_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        {
+            equix_md::SymbolIdentifier symbol_map(1024);
+            auto start = Clock::now();
+            for (const auto &datagram: datagrams)
+                table_messages += CboePitch::MessageFactory::parseMessages(datagram.data(), datagram.size(),
+                                                                          symbol_map).size();
+            table_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        {
+            equix_md::SymbolIdentifier symbol_map(1024);
+            auto start = Clock::now();
+            for (const auto &datagram: datagrams)
+                arena_messages += CboePitch::MessageFactory::parseMessages(datagram.data(), datagram.size(),
+                                                                          symbol_map, equix_md::PacketRef(),
+                                                                          &arenas).size();
+            arena_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        {
+            equix_md::SymbolIdentifier symbol_map(1024);
+            auto start = Clock::now();
+            for (const auto &datagram: datagrams)
+                route_messages += CboePitch::MessageFactory::routeMessages(datagram.data(), datagram.size(),
+                                                                          symbol_map, equix_md::PacketRef(),
+                                                                          &arenas).size();
+            route_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        }
+    }
+    std::cerr.rdbuf(saved_cerr);
+
+    // Dispatch alone (type byte -> length/parser), to separate it from the cost of building messages.
+    size_t legacy_bytes = 0, table_bytes = 0;
+    auto start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (const auto &datagram: datagrams) legacy_bytes += legacy.walk(datagram.data(), datagram.size());
+    const double legacy_walk_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (const auto &datagram: datagrams) table_bytes += walk_table(datagram.data(), datagram.size());
+    const double table_walk_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (legacy_bytes != table_bytes) throw std::runtime_error("dispatch tables disagree");
+
+    // Framing pre-scan alone (length bytes -> (offset, type) index), the first phase of parseMessages.
+    uint64_t indexed = 0;
+    CboePitch::MessageIndex index;
+    start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (const auto &datagram: datagrams) {
+            index.scan(datagram.data(), datagram.size());
+            indexed += index.size();
+        }
+    const double index_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (indexed != table_messages) throw std::runtime_error("index and parseMessages disagree on message count");
+    if (route_messages != table_messages) throw std::runtime_error("routeMessages and parseMessages disagree on message count");
+
+    // Flyweight views: decode the fields a book builder reads, straight from the datagram.
+    uint64_t view_messages = 0, checksum = 0;
+    const auto visitor = CboePitch::Overloaded{
+        [&](CboePitch::AddOrderView v) { checksum += v.getOrderId() + v.getQuantity() + v.getPrice().raw(); },
+        [&](CboePitch::OrderExecutedView v) { checksum += v.getOrderId() + v.getExecutedQuantity(); },
+        [&](CboePitch::ReduceSizeView v) { checksum += v.getOrderId() + v.getCancelledQuantity(); },
+        [&](CboePitch::ModifyOrderView v) { checksum += v.getOrderId() + v.getQuantity() + v.getPrice().raw(); },
+        [&](CboePitch::DeleteOrderView v) { checksum += v.getOrderId(); },
+        [&](CboePitch::TradeView v) { checksum += v.getQuantity() + v.getPrice().raw() + v.getSymbol().size(); },
+        [&](CboePitch::UnknownMessageView) { --view_messages; },
+        [&](auto v) { checksum += v.getMessageType(); }};
+    start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (const auto &datagram: datagrams)
+            view_messages += CboePitch::for_each_message(datagram.data(), datagram.size(), visitor);
+    const double view_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (view_messages != table_messages) throw std::runtime_error("views and parseMessages disagree on message count");
+
+    std::cout << "parse: " << datagrams.size() << " datagrams x " << iterations << " passes\n" << std::fixed
+              << std::setprecision(2);
+    std::cout << "  " << std::left << std::setw(24) << "unordered_map dispatch" << std::right
+              << " messages=" << legacy_messages << " rate=" << legacy_messages / legacy_seconds / 1e6 << " M msg/s\n";
+    std::cout << "  " << std::left << std::setw(24) << "flat table dispatch" << std::right
+              << " messages=" << table_messages << " rate=" << table_messages / table_seconds / 1e6 << " M msg/s"
+              << " (" << legacy_seconds / table_seconds << "x)\n";
+    std::cout << "  " << std::left << std::setw(24) << "flat table + arena" << std::right
+              << " messages=" << arena_messages << " rate=" << arena_messages / arena_seconds / 1e6 << " M msg/s"
+              << " (" << table_seconds / arena_seconds << "x vs flat table, exhausted=" << arenas.exhausted() << ")\n";
+    std::cout << "  " << std::left << std::setw(24) << "lazy route + arena" << std::right
+              << " messages=" << route_messages << " rate=" << route_messages / route_seconds / 1e6 << " M msg/s"
+              << " (" << arena_seconds / route_seconds << "x vs full parse + arena)\n";
+    std::cout << "  " << std::left << std::setw(24) << "lookup only, hash map" << std::right
+              << " rate=" << legacy_messages / legacy_walk_seconds / 1e6 << " M msg/s\n";
+    std::cout << "  " << std::left << std::setw(24) << "lookup only, flat table" << std::right
+              << " rate=" << table_messages / table_walk_seconds / 1e6 << " M msg/s"
+              << " (" << legacy_walk_seconds / table_walk_seconds << "x)\n";
+    std::cout << "  " << std::left << std::setw(24) << "pre-scan index only" << std::right
+              << " rate=" << indexed / index_seconds / 1e6 << " M msg/s\n";
+    std::cout << "  " << std::left << std::setw(24) << "flyweight views" << std::right
+              << " messages=" << view_messages << " rate=" << view_messages / view_seconds / 1e6 << " M msg/s"
+              << " (" << table_seconds / view_seconds << "x vs flat table) checksum=" << checksum << "\n";
+    return 0;
+}
+
+// ---- layout ----
+
+/**
+ * @brief Reference read of one field with the byte loops the message classes used before layouts.
+ */
+bool field_matches_reference(const CboePitch::FieldDesc &field, const uint8_t *message, const std::string &text) {
+    using CboePitch::Message;
+    const uint8_t *p = message + field.offset;
+    switch (field.kind) {
+        case CboePitch::FieldKind::UInt:
+        case CboePitch::FieldKind::Price: {
+            const uint64_t raw = Message::readUintLE(p, field.width);
+            if (field.kind == CboePitch::FieldKind::UInt) return text == std::to_string(raw);
+            return text == CboePitch::Price::fromRaw(static_cast<int64_t>(raw)).toString();
+        }
+        case CboePitch::FieldKind::Char:
+            return text == std::string(1, static_cast<char>(*p));
+        case CboePitch::FieldKind::Alpha:
+        case CboePitch::FieldKind::Symbol:
+            return text == Message::trimRight(Message::readAscii(p, field.width));
+    }
+    return false;
+}
+
+/// Fold any decoded field value into a checksum so the decode is not optimised away.
+template<typename T>
+uint64_t checksum_of(T value) {
+    if constexpr (std::is_same_v<T, CboePitch::Price>) return static_cast<uint64_t>(value.raw());
+    else if constexpr (std::is_same_v<T, equix_md::Symbol>) return value.packed();
+    else if constexpr (std::is_same_v<T, std::string_view>) return value.size();
+    else return static_cast<uint64_t>(value);
+}
+
+/**
+ * @brief Round-trip and reference checks for one message; returns the number of mismatching fields.
+ */
+template<typename Layout>
+size_t check_layout_message(const uint8_t *message) {
+    size_t mismatches = 0;
+    uint8_t encoded[Layout::SIZE];
+    CboePitch::encodeValues<Layout>(encoded, CboePitch::decode<Layout>(message));
+    CboePitch::forEachField<Layout>(message, [&](const CboePitch::FieldDesc &field, auto value) {
+        std::string text;
+        CboePitch::format::appendText(text, value);
+        const bool same_bytes = std::memcmp(encoded + field.offset, message + field.offset, field.width) == 0;
+        if (!same_bytes || !field_matches_reference(field, message, text)) {
+            std::cerr << "[bench] " << Layout::NAME << "." << field.name << " mismatch (decoded " << text << ")\n";
+            ++mismatches;
+        }
+    });
+    return mismatches;
+}
+
+int bench_layout(const Options &options) {
+    const uint64_t iterations = options.get("iterations", 2000);
+    const auto datagrams = load_example_datagrams();
+    if (datagrams.empty()) throw std::runtime_error("no datagrams in the example captures (run from the repo root)");
+
+    // Correctness pass over every known message
+    CboePitch::MessageIndex index;
+    uint64_t checked = 0, mismatches = 0;
+    std::set<uint8_t> sampled;
+    for (const auto &datagram: datagrams) {
+        index.scan(datagram.data(), datagram.size());
+        for (const auto &entry: index) {
+            const uint8_t *message = datagram.data() + entry.offset;
+            CboePitch::withLayout(entry.type, [&](auto layout) {
+                mismatches += check_layout_message<decltype(layout)>(message);
+            });
+            ++checked;
+            if (sampled.insert(entry.type).second) {
+                std::string text, json;
+                CboePitch::appendMessageText(text, message);
+                CboePitch::appendMessageJson(json, message);
+                std::cout << "  " << text << "\n  " << json << "\n";
+            }
+        }
+    }
+    if (mismatches != 0) throw std::runtime_error(std::to_string(mismatches) + " field mismatches");
+
+    // Generated decode: every field of every message into its value tuple
+    uint64_t decoded = 0, checksum = 0;
+    auto start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (const auto &datagram: datagrams) {
+            index.scan(datagram.data(), datagram.size());
+            for (const auto &entry: index) {
+                const uint8_t *message = datagram.data() + entry.offset;
+                CboePitch::withLayout(entry.type, [&](auto layout) {
+                    CboePitch::forEachField<decltype(layout)>(message, [&](const CboePitch::FieldDesc &, auto value) {
+                        checksum += checksum_of(value);
+                    });
+                });
+                ++decoded;
+            }
+        }
+    const double decode_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::string out;
+    uint64_t text_bytes = 0, json_bytes = 0;
+    start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (const auto &datagram: datagrams) {
+            index.scan(datagram.data(), datagram.size());
+            for (const auto &entry: index) {
+                out.clear();
+                CboePitch::appendMessageText(out, datagram.data() + entry.offset);
+                text_bytes += out.size();
+            }
+        }
+    const double text_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (const auto &datagram: datagrams) {
+            index.scan(datagram.data(), datagram.size());
+            for (const auto &entry: index) {
+                out.clear();
+                CboePitch::appendMessageJson(out, datagram.data() + entry.offset);
+                json_bytes += out.size();
+            }
+        }
+    const double json_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "layout: " << checked << " messages round-tripped and checked, 0 mismatches\n"
+              << "layout: " << datagrams.size() << " datagrams x " << iterations << " passes\n" << std::fixed
+              << std::setprecision(2);
+    std::cout << "  " << std::left << std::setw(24) << "decode all fields" << std::right
+              << " rate=" << decoded / decode_seconds / 1e6 << " M msg/s checksum=" << checksum << "\n";
+    std::cout << "  " << std::left << std::setw(24) << "debug text" << std::right
+              << " rate=" << decoded / text_seconds / 1e6 << " M msg/s (" << text_bytes / text_seconds / 1e6
+              << " MB/s)\n";
+    std::cout << "  " << std::left << std::setw(24) << "JSON" << std::right
+              << " rate=" << decoded / json_seconds / 1e6 << " M msg/s (" << json_bytes / json_seconds / 1e6
+              << " MB/s)\n";
+    return 0;
+}
+
+// ---- route ----
+
+/**
+ * @brief The router before packed symbols: std::string keys, and push() took the router
+ *        lock twice more to compare queue counts.
+ */
+class LegacyRouter {
+public:
+    using Queue = SymbolQueueRouter::Queue;
+
+    explicit LegacyRouter(size_t queue_capacity) : queue_capacity_(queue_capacity) {}
+
+    bool push(const std::string &symbol, SymbolQueueRouter::MessagePtr msg) {
+        size_t before_count = queue_count();
+        auto queue_ptr = get_or_create_queue(symbol);
+        bool enqueued = queue_ptr->try_enqueue(std::move(msg));
+        size_t after_count = queue_count();
+        (void) before_count;
+        (void) after_count;
+        return enqueued;
+    }
+
+    std::shared_ptr<Queue> find_queue(const std::string &symbol) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = queues_.find(symbol);
+        return it != queues_.end() ? it->second : nullptr;
+    }
+
+    size_t queue_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_vector_.size();
+    }
+
+    std::vector<std::shared_ptr<Queue> > &get_queue_vector() { return queue_vector_; }
+
+private:
+    std::shared_ptr<Queue> get_or_create_queue(const std::string &symbol) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = queues_.find(symbol);
+            if (it != queues_.end()) return it->second;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &queue_ptr = queues_[symbol];
+        if (!queue_ptr) {
+            queue_ptr = std::make_shared<Queue>(queue_capacity_);
+            queue_vector_.push_back(queue_ptr);
+        }
+        return queue_ptr;
+    }
+
+    mutable std::mutex mutex_;
+    tsl::robin_map<std::string, std::shared_ptr<Queue> > queues_;
+    std::vector<std::shared_ptr<Queue> > queue_vector_;
+    size_t queue_capacity_;
+};
+
+/**
+ * @brief Empty every queue so the next pass starts from the same state.
+ */
+template<typename Router>
+void drain_queues(Router &router) {
+    SymbolQueueRouter::MessagePtr items[256];
+    for (auto &queue: router.get_queue_vector())
+        while (queue->try_dequeue_bulk(items, 256) != 0) {
+        }
+}
+
+int bench_route(const Options &options) {
+    const size_t symbol_count = options.get("symbols", 5000);
+    const size_t message_count = options.get("messages", 1000000);
+    const uint64_t iterations = options.get("iterations", 5);
+    const size_t queue_capacity = options.get("queue-capacity", 4096);
+    if (symbol_count == 0 || message_count == 0) throw std::invalid_argument("--symbols and --messages must be > 0");
+
+    // Distinct 1-6 letter symbols as space-padded 6-byte wire fields.
+    std::mt19937_64 rng(42);
+    std::set<std::string> seen;
+    std::vector<std::array<uint8_t, equix_md::Symbol::kWireLength> > fields;
+    while (fields.size() < symbol_count) {
+        std::string text(1 + rng() % equix_md::Symbol::kWireLength, ' ');
+        for (char &c: text) c = static_cast<char>('A' + rng() % 26);
+        if (!seen.insert(text).second) continue;
+        std::array<uint8_t, equix_md::Symbol::kWireLength> field;
+        field.fill(' ');
+        std::memcpy(field.data(), text.data(), text.size());
+        fields.push_back(field);
+    }
+    // Zipf(1)-like popularity: a few symbols carry most of the flow.
+    std::vector<double> weights(symbol_count);
+    for (size_t i = 0; i < symbol_count; ++i) weights[i] = 1.0 / static_cast<double>(i + 1);
+    std::discrete_distribution<uint32_t> pick(weights.begin(), weights.end());
+    std::vector<uint32_t> sequence(message_count);
+    for (auto &index: sequence) index = pick(rng);
+
+    LegacyRouter legacy(queue_capacity);
+    SymbolQueueRouter packed(queue_capacity, symbol_count);
+    double legacy_seconds = 0, packed_seconds = 0;
+    for (uint64_t pass = 0; pass < iterations; ++pass) {
+        auto start = Clock::now();
+        for (uint32_t index: sequence) {
+            // As the string path did it: copy the field, trim, copy again out of getSymbol().
+            std::string symbol(reinterpret_cast<const char *>(fields[index].data()), fields[index].size());
+            symbol = CboePitch::Message::trimRight(symbol);
+            const std::string key = symbol;
+            legacy.push(key, nullptr);
+        }
+        legacy_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        drain_queues(legacy);
+
+        start = Clock::now();
+        for (uint32_t index: sequence)
+            packed.push(equix_md::Symbol::from_wire(fields[index].data()), nullptr);
+        packed_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        drain_queues(packed);
+    }
+    if (legacy.queue_count() != packed.queue_count()) throw std::runtime_error("routers disagree on symbol count");
+
+    // Key path only: decode the symbol and find its queue (every symbol exists by now).
+    size_t legacy_found = 0, packed_found = 0;
+    auto start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (uint32_t index: sequence) {
+            std::string symbol(reinterpret_cast<const char *>(fields[index].data()), fields[index].size());
+            symbol = CboePitch::Message::trimRight(symbol);
+            const std::string key = symbol;
+            legacy_found += legacy.find_queue(key) != nullptr;
+        }
+    const double legacy_lookup_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (uint64_t pass = 0; pass < iterations; ++pass)
+        for (uint32_t index: sequence)
+            packed_found += packed.find_queue(equix_md::Symbol::from_wire(fields[index].data())) != nullptr;
+    const double packed_lookup_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (legacy_found != packed_found) throw std::runtime_error("routers disagree on lookups");
+
+    const double routed = static_cast<double>(message_count * iterations);
+    std::cout << "route: " << symbol_count << " symbols (" << packed.queue_count() << " seen), " << message_count
+              << " messages x " << iterations << " passes\n" << std::fixed << std::setprecision(2);
+    std::cout << "  " << std::left << std::setw(24) << "std::string keys" << std::right
+              << " rate=" << routed / legacy_seconds / 1e6 << " M msg/s\n";
+    std::cout << "  " << std::left << std::setw(24) << "packed Symbol keys" << std::right
+              << " rate=" << routed / packed_seconds / 1e6 << " M msg/s"
+              << " (" << legacy_seconds / packed_seconds << "x)\n";
+    std::cout << "  " << std::left << std::setw(24) << "lookup only, string" << std::right
+              << " rate=" << routed / legacy_lookup_seconds / 1e6 << " M msg/s\n";
+    std::cout << "  " << std::left << std::setw(24) << "lookup only, Symbol" << std::right
+              << " rate=" << routed / packed_lookup_seconds / 1e6 << " M msg/s"
+              << " (" << legacy_lookup_seconds / packed_lookup_seconds << "x)\n";
+    return 0;
+}
+
+// ---- dispatch ----
+
+int bench_dispatch(const Options &options) {
+    const uint64_t target = options.get("messages", 200000);
+    const uint64_t iterations = options.get("iterations", 50);
+    equix_md::SyntheticFeed::Config config;
+    config.symbols = options.get("symbols", static_cast<uint64_t>(config.symbols));
+
+    // Copy the datagrams out first: messages keep views into them.
+    std::vector<std::vector<uint8_t> > datagrams;
+    equix_md::SyntheticFeed feed(config);
+    while (feed.messages() < target) {
+        const auto datagram = feed.next();
+        datagrams.emplace_back(datagram.data, datagram.data + datagram.size);
+    }
+    equix_md::SymbolIdentifier symbol_map(feed.operations(equix_md::SyntheticFeed::kAdd));
+    std::vector<std::shared_ptr<CboePitch::Message> > messages;
+    messages.reserve(feed.messages());
+    for (const auto &datagram: datagrams) {
+        auto parsed = CboePitch::MessageFactory::parseMessages(datagram.data(), datagram.size(), symbol_map);
+        messages.insert(messages.end(), parsed.begin(), parsed.end());
+    }
+    // Parsing the deletes emptied the book; restore every order so each lookup finds its symbol.
+    for (const auto &message: messages)
+        CboePitch::visitMessage(*message, CboePitch::Overloaded{
+                                    [&](const CboePitch::AddOrder &add) {
+                                        symbol_map.add_mapping(add.getOrderId(), add.getSymbol());
+                                    },
+                                    [](const auto &) {}});
+
+    uint64_t virtual_sum = 0, static_sum = 0, virtual_key_sum = 0, static_key_sum = 0;
+    double virtual_seconds = 0, static_seconds = 0, virtual_key_seconds = 0, static_key_seconds = 0;
+    for (uint64_t pass = 0; pass < iterations; ++pass) {
+        auto start = Clock::now();
+        for (const auto &message: messages)
+            virtual_sum += message->getSymbol().packed() + message->getMessageType() + message->getOrderId() +
+                    message->getPayload().size();
+        virtual_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (const auto &message: messages)
+            static_sum += CboePitch::visitMessage(*message, [](const auto &m) -> uint64_t {
+                return CboePitch::symbolOf(m).packed() + CboePitch::messageTypeOf(m) + CboePitch::orderIdOf(m) +
+                       m.getPayload().size();
+            });
+        static_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        // Dispatch alone: type and order id, no hash lookup.
+        start = Clock::now();
+        for (const auto &message: messages) virtual_key_sum += message->getMessageType() + message->getOrderId();
+        virtual_key_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (const auto &message: messages)
+            static_key_sum += CboePitch::visitMessage(*message, [](const auto &m) -> uint64_t {
+                return CboePitch::messageTypeOf(m) + CboePitch::orderIdOf(m);
+            });
+        static_key_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    if (virtual_sum != static_sum || virtual_key_sum != static_key_sum)
+        throw std::runtime_error("virtual and static dispatch disagree");
+
+    const double total = static_cast<double>(messages.size()) * iterations;
+    std::cout << "dispatch: " << messages.size() << " messages (" << config.symbols << " symbols) x " << iterations
+              << " passes\n" << std::fixed << std::setprecision(2);
+    std::cout << "  " << std::left << std::setw(24) << "virtual, with lookup" << std::right
+              << " rate=" << total / virtual_seconds / 1e6 << " M msg/s\n";
+    std::cout << "  " << std::left << std::setw(24) << "visitor, with lookup" << std::right
+              << " rate=" << total / static_seconds / 1e6 << " M msg/s"
+              << " (" << virtual_seconds / static_seconds << "x)\n";
+    std::cout << "  " << std::left << std::setw(24) << "virtual, type + order id" << std::right
+              << " rate=" << total / virtual_key_seconds / 1e6 << " M msg/s\n";
+    std::cout << "  " << std::left << std::setw(24) << "visitor, type + order id" << std::right
+              << " rate=" << total / static_key_seconds / 1e6 << " M msg/s"
+              << " (" << virtual_key_seconds / static_key_seconds << "x) checksum=" << static_sum << "\n";
+    return 0;
+}
+
+// ---- sequence ----
+
+int bench_sequence(const Options &options) {
+    const uint64_t packets = options.get("packets", 10000000);
+    const uint64_t units = std::min<uint64_t>(std::max<uint64_t>(options.get("units", 4), 1), 255);
+    const uint64_t fault_every = std::max<uint64_t>(options.get("fault-every", 1000), 2);
+
+    struct Header {
+        uint8_t unit;
+        uint8_t count;
+        uint32_t sequence;
+    };
+    std::vector<Header> headers;
+    headers.reserve(packets);
+    std::vector<uint32_t> next(units + 1, 1);
+    uint64_t gaps = 0, duplicates = 0, heartbeats = 0;
+    std::mt19937 rng(7);
+    for (uint64_t i = 0; headers.size() < packets; ++i) {
+        const auto unit = static_cast<uint8_t>(1 + i % units);
+        const auto count = static_cast<uint8_t>(1 + rng() % 16);
+        if (i % 100 == 99) {
+            headers.push_back({unit, 0, next[unit]}); // Unit heartbeat: next expected sequence
+            ++heartbeats;
+            continue;
+        }
+        if (i % fault_every == fault_every / 2 && next[unit] > 1) {
+            headers.push_back({unit, 1, next[unit] - 1}); // Repeat of the last message
+            ++duplicates;
+            continue;
+        }
+        if (i % fault_every == 0 && next[unit] > 1) {
+            next[unit] += 1 + rng() % 8; // Lose a few messages (not before the unit's first packet)
+            ++gaps;
+        }
+        headers.push_back({unit, count, next[unit]});
+        next[unit] += count;
+    }
+
+    equix_md::SequenceTracker tracker;
+    auto start = Clock::now();
+    uint64_t in_order = 0;
+    for (const Header &header: headers)
+        in_order += tracker.on_packet(header.unit, header.sequence, header.count) ==
+                equix_md::SequenceTracker::Verdict::InOrder;
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    equix_md::SequenceTracker::UnitStats total;
+    for (uint64_t unit = 1; unit <= units; ++unit) {
+        auto stats = tracker.unit_stats(static_cast<uint8_t>(unit));
+        total.gaps += stats.gaps;
+        total.duplicates += stats.duplicates;
+        total.heartbeats += stats.heartbeats;
+        total.lost_messages += stats.lost_messages;
+    }
+    equix_md::SequenceGap gap;
+    uint64_t events = 0;
+    while (tracker.poll_gap(gap)) ++events;
+    if (total.gaps != gaps || events + tracker.gap_events_dropped() != gaps || total.duplicates != duplicates ||
+        total.heartbeats != heartbeats)
+        throw std::runtime_error("tracker reported different faults than were injected");
+
+    std::cout << "sequence: " << headers.size() << " packets over " << units << " units\n" << std::fixed
+              << std::setprecision(2)
+              << "  in_order=" << in_order << " gaps=" << total.gaps << " (lost " << total.lost_messages
+              << " messages) duplicates=" << total.duplicates << " heartbeats=" << total.heartbeats << "\n"
+              << "  rate=" << headers.size() / seconds / 1e6 << " M packets/s ("
+              << seconds * 1e9 / static_cast<double>(headers.size()) << " ns/packet)\n";
+    return 0;
+}
+
+// ---- reorder ----
+
+int bench_reorder(const Options &options) {
+    const uint64_t packets = options.get("packets", 2000000);
+    const uint64_t units = std::min<uint64_t>(std::max<uint64_t>(options.get("units", 4), 1), 255);
+    const uint64_t swap_every = std::max<uint64_t>(options.get("swap-every", 50), 3);
+    const uint64_t loss_every = std::max<uint64_t>(options.get("loss-every", 1000), 3);
+    equix_md::ReorderBuffer::Config config;
+    config.window = static_cast<uint32_t>(options.get("window", 256));
+    config.max_hold_us = static_cast<uint32_t>(options.get("max-hold-us", 20));
+
+    struct Header {
+        uint8_t unit;
+        uint8_t count;
+        uint32_t sequence;
+    };
+    // In-order stream, then a faulty copy: per unit, swap a packet with the next one or drop it
+    std::vector<Header> in_order;
+    in_order.reserve(packets);
+    std::vector<uint32_t> next(units + 1, 1);
+    std::mt19937 rng(11);
+    for (uint64_t i = 0; i < packets; ++i) {
+        const auto unit = static_cast<uint8_t>(1 + i % units);
+        const auto count = static_cast<uint8_t>(1 + rng() % 8);
+        in_order.push_back({unit, count, next[unit]});
+        next[unit] += count;
+    }
+    std::vector<Header> shuffled = in_order;
+    std::vector<Header> faulty;
+    faulty.reserve(packets);
+    uint64_t swaps = 0, losses = 0;
+    std::vector<uint64_t> unit_index(units + 1, 0);
+    for (uint64_t i = 0; i < shuffled.size(); ++i) {
+        const uint64_t n = unit_index[shuffled[i].unit]++;
+        if (n % loss_every == loss_every / 2) {
+            ++losses;
+            continue;
+        }
+        faulty.push_back(shuffled[i]);
+        if (n % swap_every == swap_every / 2 && i + units < shuffled.size()) {
+            std::swap(faulty.back(), shuffled[i + units]); // The unit's next packet goes first
+            ++swaps;
+        }
+    }
+
+    auto run = [&](const std::vector<Header> &headers, uint64_t &released, bool check) {
+        equix_md::ReorderBuffer buffer(config);
+        std::vector<uint32_t> expected(units + 1, 1);
+        uint64_t out_of_order = 0;
+        released = 0;
+        auto release = [&](const equix_md::ReorderBuffer::Packet &packet) {
+            const auto unit = static_cast<uint8_t>(packet.size); // Header values carried in the test packet
+            const uint32_t sequence = packet.kernel_drops;
+            if (check && sequence < expected[unit]) ++out_of_order;
+            expected[unit] = sequence + 1;
+            ++released;
+        };
+        equix_md::ReorderBuffer::Packet packet{nullptr, 0, {}, 0};
+        uint64_t now_ns = 0;
+        auto start = Clock::now();
+        for (const Header &header: headers) {
+            packet.size = header.unit;
+            packet.kernel_drops = header.sequence;
+            buffer.on_packet(packet, header.unit, header.sequence, header.count, now_ns += 1000, release);
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        buffer.expire(UINT64_MAX / 2, release);
+        if (out_of_order != 0) throw std::runtime_error("reorder buffer released packets out of order");
+        equix_md::ReorderBuffer::UnitStats total;
+        for (uint64_t unit = 1; unit <= units; ++unit) {
+            auto stats = buffer.unit_stats(static_cast<uint8_t>(unit));
+            total.held += stats.held;
+            total.reordered += stats.reordered;
+            total.expired_holes += stats.expired_holes;
+            total.overflows += stats.overflows;
+            total.skipped_messages += stats.skipped_messages;
+            total.late += stats.late;
+        }
+        std::cout << "  " << std::left << std::setw(10) << (check ? "faulty" : "in order") << std::right
+                  << " rate=" << headers.size() / seconds / 1e6 << " M packets/s ("
+                  << seconds * 1e9 / static_cast<double>(headers.size()) << " ns/packet) held=" << total.held
+                  << " reordered=" << total.reordered << " expired_holes=" << total.expired_holes
+                  << " overflows=" << total.overflows << " skipped_messages=" << total.skipped_messages
+                  << " late=" << total.late << "\n";
+        return total;
+    };
+
+    std::cout << "reorder: " << packets << " packets over " << units << " units, window=" << config.window
+              << " max_hold_us=" << config.max_hold_us << ", " << swaps << " swaps, " << losses << " losses\n"
+              << std::fixed << std::setprecision(2);
+    uint64_t released = 0;
+    auto clean = run(in_order, released, false);
+    if (clean.held != 0 || released != in_order.size())
+        throw std::runtime_error("reorder buffer held packets of an in-order stream");
+    auto total = run(faulty, released, true);
+    if (released != faulty.size()) throw std::runtime_error("reorder buffer lost or repeated packets");
+    if (total.expired_holes + total.overflows != losses || total.late != 0)
+        throw std::runtime_error("reorder buffer skipped different holes than were injected");
+    return 0;
+}
+
+void usage() {
+    std::cerr << "Usage: cboe_bench <benchmark> [--option value ...]\n"
+              << "  receive   UDP receive throughput per backend (--packets N --size BYTES --batch N)\n"
+              << "  parse     PITCH decode rate, flat table vs. hash-map dispatch vs. lazy route vs. views (--iterations N)\n"
+              << "  layout    generated layout code vs. example captures, text/JSON rate (--iterations N)\n"
+              << "  route     symbol routing, packed Symbol vs. std::string keys (--symbols N --messages N --iterations N --queue-capacity N)\n"
+              << "  sequence  SequenceTracker cost per packet and fault detection (--packets N --units N --fault-every N)\n"
+              << "  reorder   ReorderBuffer cost per packet, in order and with swaps and losses (--packets N --units N --swap-every N --loss-every N --window N --max-hold-us N)\n"
+              << "  dispatch  virtual accessors vs. static visitor on a mixed feed (--messages N --symbols N --iterations N)\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    const std::map<std::string, std::function<int(const Options &)> > benchmarks = {
+        {"receive", bench_receive},
+        {"parse", bench_parse},
+        {"layout", bench_layout},
+        {"route", bench_route},
+        {"dispatch", bench_dispatch},
+        {"sequence", bench_sequence},
+        {"reorder", bench_reorder},
+    };
+    auto it = benchmarks.find(argv[1]);
+    if (it == benchmarks.end()) {
+        usage();
+        return 1;
+    }
+    try {
+        return it->second(Options(argc, argv, 2));
+    } catch (const std::exception &ex) {
+        std::cerr << "[bench] " << ex.what() << std::endl;
+        return 1;
+    }
+}
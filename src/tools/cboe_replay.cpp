@@ -0,0 +1,319 @@
+/**
+ * @file    cboe_replay.cpp
+ * @brief   High-rate PITCH capture replayer.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: cboe_replay.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Sends the UDP payloads of a pcap/pcapng capture to a host with sendmmsg,
+ *   built next to cboe_feed_handler for load testing.
+ *   Usage: cboe_replay --file CAPTURE [options]
+ *
+ *   Modes (--mode):
+ *     original  Capture inter-packet gaps, divided by --speed (default 1).
+ *     fast      Back to back, as fast as the socket accepts.
+ *     pps       Fixed rate of --pps datagrams per second.
+ *     burst     --burst datagrams back to back every --burst-gap-us
+ *               microseconds (market-open microbursts).
+ *
+ *   Destinations: every datagram goes to --host. The port is picked from
+ *   --units (SeqUnitHeader unit -> port, e.g. "1:30501,2:30502"), then
+ *   --port, then the capture's own destination port.
+ *
+ *   Options: --host IP  --port N  --units MAP  --speed X  --pps N  --burst N
+ *            --burst-gap-us N  --loops N  --batch N  --sndbuf BYTES
+ *            --interface IP (multicast egress)  --ttl N
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PcapReader.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief "--name value" options.
+ */
+class Options {
+public:
+    Options(int argc, char **argv, int first) {
+        for (int i = first; i + 1 < argc; i += 2) {
+            std::string key = argv[i];
+            if (key.rfind("--", 0) != 0) throw std::invalid_argument("Unexpected argument: " + key);
+            values_[key.substr(2)] = argv[i + 1];
+        }
+        if ((argc - first) % 2 != 0) throw std::invalid_argument("Missing value for " + std::string(argv[argc - 1]));
+    }
+
+    std::string get(const std::string &name, const std::string &fallback) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? fallback : it->second;
+    }
+
+    uint64_t get(const std::string &name, uint64_t fallback) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? fallback : std::stoull(it->second);
+    }
+
+    double get(const std::string &name, double fallback) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? fallback : std::stod(it->second);
+    }
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+enum class Mode { Original, Fast, Pps, Burst };
+
+Mode parse_mode(const std::string &name) {
+    if (name == "original") return Mode::Original;
+    if (name == "fast") return Mode::Fast;
+    if (name == "pps") return Mode::Pps;
+    if (name == "burst") return Mode::Burst;
+    throw std::invalid_argument("Unknown mode '" + name + "' (original | fast | pps | burst)");
+}
+
+/**
+ * @brief Parse "unit:port,unit:port" into a 256-entry table (0 = not mapped).
+ */
+std::vector<uint16_t> parse_unit_ports(const std::string &spec) {
+    std::vector<uint16_t> ports(256, 0);
+    std::stringstream stream(spec);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) continue;
+        auto colon = item.find(':');
+        if (colon == std::string::npos) throw std::invalid_argument("Bad unit mapping '" + item + "' (want unit:port)");
+        unsigned long unit = std::stoul(item.substr(0, colon));
+        unsigned long port = std::stoul(item.substr(colon + 1));
+        if (unit > 255 || port == 0 || port > 65535) throw std::invalid_argument("Bad unit mapping '" + item + "'");
+        ports[unit] = static_cast<uint16_t>(port);
+    }
+    return ports;
+}
+
+/**
+ * @brief One datagram to send; payload points into the mapped capture.
+ */
+struct Datagram {
+    uint64_t capture_ns;
+    const uint8_t *payload;
+    size_t size;
+    uint16_t port; ///< Destination port after unit remapping
+};
+
+void wait_until(Clock::time_point deadline) {
+    constexpr auto kSpin = std::chrono::microseconds(100);
+    for (;;) {
+        auto now = Clock::now();
+        if (now >= deadline) return;
+        if (deadline - now > kSpin) std::this_thread::sleep_for(deadline - now - kSpin);
+    }
+}
+
+void usage() {
+    std::cerr << "Usage: cboe_replay --file CAPTURE [--option value ...]\n"
+              << "  --mode original|fast|pps|burst  pacing (default original)\n"
+              << "  --speed X         original mode: replay X times faster (default 1)\n"
+              << "  --pps N           pps mode: datagrams per second\n"
+              << "  --burst N         burst mode: datagrams per burst (default 1000)\n"
+              << "  --burst-gap-us N  burst mode: microseconds between burst starts (default 10000)\n"
+              << "  --host IP         destination address, unicast or multicast (default 127.0.0.1)\n"
+              << "  --port N          destination port for every unit (default: capture's port)\n"
+              << "  --units MAP       per-unit ports, e.g. 1:30501,2:30502 (overrides --port)\n"
+              << "  --loops N         passes over the capture (default 1)\n"
+              << "  --batch N         datagrams per sendmmsg (default 64)\n"
+              << "  --sndbuf BYTES    socket send buffer (default 4 MiB)\n"
+              << "  --interface IP    multicast egress interface\n"
+              << "  --ttl N           multicast TTL (default 1)\n";
+}
+
+int run(const Options &options) {
+    const std::string file = options.get("file", std::string());
+    if (file.empty()) {
+        usage();
+        return 1;
+    }
+    const Mode mode = parse_mode(options.get("mode", std::string("original")));
+    const double speed = options.get("speed", 1.0);
+    const uint64_t pps = options.get("pps", uint64_t(0));
+    const uint64_t burst = std::max<uint64_t>(1, options.get("burst", uint64_t(1000)));
+    const uint64_t burst_gap_us = options.get("burst-gap-us", uint64_t(10000));
+    const uint64_t loops = std::max<uint64_t>(1, options.get("loops", uint64_t(1)));
+    const size_t batch = std::max<size_t>(1, std::min<size_t>(1024, options.get("batch", uint64_t(64))));
+    const uint64_t default_port = options.get("port", uint64_t(0));
+    const std::vector<uint16_t> unit_ports = parse_unit_ports(options.get("units", std::string()));
+    if (speed <= 0) throw std::invalid_argument("--speed must be positive");
+    if (mode == Mode::Pps && pps == 0) throw std::invalid_argument("pps mode needs --pps");
+    if (default_port > 65535) throw std::invalid_argument("--port out of range");
+
+    // Load the datagram list up front so the send loop only touches mapped memory.
+    equix_md::PcapReader reader(file);
+    std::vector<Datagram> datagrams;
+    equix_md::UdpDatagramView view;
+    uint64_t capture_ns = 0;
+    while (reader.next_udp(view, capture_ns)) {
+        uint16_t port = default_port ? static_cast<uint16_t>(default_port) : view.dst_port;
+        if (view.payload_size >= 4 && unit_ports[view.payload[3]] != 0) port = unit_ports[view.payload[3]];
+        datagrams.push_back(Datagram{capture_ns, view.payload, view.payload_size, port});
+    }
+    if (datagrams.empty()) {
+        std::cerr << "[Replay] " << file << ": no UDP datagrams" << std::endl;
+        return 1;
+    }
+
+    in_addr host{};
+    const std::string host_name = options.get("host", std::string("127.0.0.1"));
+    if (inet_pton(AF_INET, host_name.c_str(), &host) != 1) throw std::invalid_argument("Bad --host " + host_name);
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) throw std::runtime_error("socket: " + std::string(strerror(errno)));
+    int sndbuf = static_cast<int>(options.get("sndbuf", uint64_t(4 << 20)));
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+    if (IN_MULTICAST(ntohl(host.s_addr))) {
+        int ttl = static_cast<int>(options.get("ttl", uint64_t(1)));
+        int loop = 1;
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        const std::string interface = options.get("interface", std::string());
+        if (!interface.empty()) {
+            in_addr egress{};
+            if (inet_pton(AF_INET, interface.c_str(), &egress) != 1 ||
+                setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &egress, sizeof(egress)) < 0) {
+                close(fd);
+                throw std::runtime_error("Cannot use multicast interface " + interface);
+            }
+        }
+    }
+
+    // One sockaddr per distinct port, shared by every message bound there.
+    std::map<uint16_t, sockaddr_in> destinations;
+    for (const Datagram &datagram: datagrams) {
+        sockaddr_in &address = destinations[datagram.port];
+        address.sin_family = AF_INET;
+        address.sin_port = htons(datagram.port);
+        address.sin_addr = host;
+    }
+
+    std::cout << "[Replay] " << file << ": " << datagrams.size() << " datagrams to " << host_name << " ports";
+    for (const auto &entry: destinations) std::cout << " " << entry.first;
+    std::cout << ", " << loops << " loop(s)" << std::endl;
+
+    // Release time of the n-th datagram sent (relative to the start), per mode.
+    const uint64_t capture_start = datagrams.front().capture_ns;
+    const uint64_t capture_span = datagrams.back().capture_ns - capture_start;
+    auto due_offset_ns = [&](uint64_t loop, size_t index, uint64_t sequence) -> uint64_t {
+        switch (mode) {
+            case Mode::Original: {
+                uint64_t offset = loop * capture_span + (datagrams[index].capture_ns - capture_start);
+                return static_cast<uint64_t>(static_cast<double>(offset) / speed);
+            }
+            case Mode::Pps:
+                return static_cast<uint64_t>(static_cast<double>(sequence) * 1e9 / static_cast<double>(pps));
+            case Mode::Burst:
+                return (sequence / burst) * burst_gap_us * 1000;
+            case Mode::Fast:
+                break;
+        }
+        return 0;
+    };
+
+    std::vector<iovec> iov(batch);
+    std::vector<mmsghdr> msgs(batch);
+    uint64_t sent = 0;
+    uint64_t bytes = 0;
+    uint64_t send_calls = 0;
+    uint64_t max_late_ns = 0;
+    const auto start = Clock::now();
+
+    for (uint64_t loop = 0; loop < loops; ++loop) {
+        size_t index = 0;
+        while (index < datagrams.size()) {
+            // Collect everything already due, up to one batch; wait for the head if nothing is.
+            uint64_t head_due = due_offset_ns(loop, index, sent);
+            auto now = Clock::now();
+            if (start + std::chrono::nanoseconds(head_due) > now) {
+                wait_until(start + std::chrono::nanoseconds(head_due));
+                now = Clock::now();
+            }
+            const uint64_t elapsed = static_cast<uint64_t>(std::chrono::nanoseconds(now - start).count());
+            max_late_ns = std::max(max_late_ns, elapsed - std::min(elapsed, head_due));
+
+            size_t count = 0;
+            while (count < batch && index + count < datagrams.size() &&
+                   due_offset_ns(loop, index + count, sent + count) <= elapsed) {
+                const Datagram &datagram = datagrams[index + count];
+                iov[count] = {const_cast<uint8_t *>(datagram.payload), datagram.size};
+                msgs[count] = {};
+                msgs[count].msg_hdr.msg_name = &destinations[datagram.port];
+                msgs[count].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                msgs[count].msg_hdr.msg_iov = &iov[count];
+                msgs[count].msg_hdr.msg_iovlen = 1;
+                ++count;
+            }
+
+            size_t done = 0;
+            while (done < count) {
+                int n = sendmmsg(fd, msgs.data() + done, static_cast<unsigned>(count - done), 0);
+                ++send_calls;
+                if (n > 0) {
+                    done += static_cast<size_t>(n);
+                } else if (errno != EAGAIN && errno != ENOBUFS && errno != EINTR) {
+                    std::cerr << "[Replay] sendmmsg: " << strerror(errno) << std::endl;
+                    close(fd);
+                    return 1;
+                }
+            }
+            for (size_t i = 0; i < count; ++i) bytes += datagrams[index + i].size;
+            sent += count;
+            index += count;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    close(fd);
+
+    std::cout << "[Replay] sent " << sent << " datagrams, " << bytes << " bytes in " << std::fixed
+              << std::setprecision(3) << seconds << " s: " << (seconds > 0 ? sent / seconds : 0.0) << " pkt/s, "
+              << (seconds > 0 ? bytes * 8 / seconds / 1e6 : 0.0) << " Mbit/s, "
+              << (send_calls ? static_cast<double>(sent) / send_calls : 0.0) << " datagrams/sendmmsg";
+    if (mode != Mode::Fast) std::cout << ", max lateness " << max_late_ns / 1000.0 << " us";
+    std::cout << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    try {
+        return run(Options(argc, argv, 1));
+    } catch (const std::exception &ex) {
+        std::cerr << "[Replay] " << ex.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file    cboe_synth.cpp
+ * @brief   Synthetic PITCH feed writer.
+ *
+ * Developer: Hoang Nguyen & Tan A. Pham
+ * Copyright: Equix Technologies Pty Ltd (contact@equix.com.au)
+ * Filename: cboe_synth.cpp
+ * Created: 16/Oct/2026
+ *
+ * Description:
+ *   Writes a SyntheticFeed to a pcap file, built next to cboe_feed_handler.
+ *   The capture can be replayed with cboe_replay or the pcap_source section,
+ *   for load tests with symbol universes the example captures cannot cover.
+ *   Usage: cboe_synth --out CAPTURE [options]
+ *
+ *   Unit u is written to --base-port + u - 1 on --host; packet timestamps
+ *   follow the generator clock (--message-gap-ns per message), so
+ *   `cboe_replay --mode original --speed X` paces it accordingly.
+ *
+ *   Options: --packets N  --symbols N  --zipf S  --units N
+ *            --messages-per-packet N  --mix ADD,EXEC,MODIFY,REDUCE,DELETE,TRADE
+ *            --max-live-orders N  --message-gap-ns N  --seed N
+ *            --host IP  --base-port N
+ */
+
+#include <arpa/inet.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "PcapWriter.hpp"
+#include "SyntheticFeed.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief "--name value" options.
+ */
+class Options {
+public:
+    Options(int argc, char **argv, int first) {
+        for (int i = first; i + 1 < argc; i += 2) {
+            std::string key = argv[i];
+            if (key.rfind("--", 0) != 0) throw std::invalid_argument("Unexpected argument: " + key);
+            values_[key.substr(2)] = argv[i + 1];
+        }
+        if ((argc - first) % 2 != 0) throw std::invalid_argument("Missing value for " + std::string(argv[argc - 1]));
+    }
+
+    std::string get(const std::string &name, const std::string &fallback) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? fallback : it->second;
+    }
+
+    uint64_t get(const std::string &name, uint64_t fallback) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? fallback : std::stoull(it->second);
+    }
+
+    double get(const std::string &name, double fallback) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? fallback : std::stod(it->second);
+    }
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+/**
+ * @brief Parse "45,10,15,5,20,5" into the six operation weights.
+ */
+std::array<uint32_t, equix_md::SyntheticFeed::kOperationCount> parse_mix(const std::string &spec) {
+    std::array<uint32_t, equix_md::SyntheticFeed::kOperationCount> mix{};
+    std::stringstream stream(spec);
+    std::string item;
+    size_t count = 0;
+    while (std::getline(stream, item, ',')) {
+        if (count == mix.size()) break;
+        mix[count++] = static_cast<uint32_t>(std::stoul(item));
+    }
+    if (count != mix.size()) {
+        throw std::invalid_argument("Bad mix '" + spec + "' (want add,execute,modify,reduce,delete,trade weights)");
+    }
+    return mix;
+}
+
+void usage() {
+    std::cerr << "Usage: cboe_synth --out CAPTURE [--option value ...]\n"
+              << "  --packets N              datagrams to write (default 100000)\n"
+              << "  --symbols N              symbol universe, 1..300000 (default 10000)\n"
+              << "  --zipf S                 popularity exponent, 0 = uniform (default 1.0)\n"
+              << "  --units N                matching units (default 4)\n"
+              << "  --messages-per-packet N  (default 8)\n"
+              << "  --mix A,E,M,R,D,T        add/execute/modify/reduce/delete/trade weights (default 45,10,15,5,20,5)\n"
+              << "  --max-live-orders N      book depth cap (default 1000000)\n"
+              << "  --message-gap-ns N       timestamp step between messages (default 1000)\n"
+              << "  --seed N                 generator seed (default 1)\n"
+              << "  --host IP                destination address in the capture (default 127.0.0.1)\n"
+              << "  --base-port N            port of unit 1, unit u uses base + u - 1 (default 30501)\n";
+}
+
+int run(const Options &options) {
+    const std::string out = options.get("out", std::string());
+    if (out.empty()) {
+        usage();
+        return 1;
+    }
+    equix_md::SyntheticFeed::Config config;
+    config.symbols = options.get("symbols", static_cast<uint64_t>(config.symbols));
+    config.zipf_exponent = options.get("zipf", config.zipf_exponent);
+    const uint64_t units = options.get("units", static_cast<uint64_t>(config.units));
+    if (units == 0 || units > 255) throw std::invalid_argument("--units must be 1..255");
+    config.units = static_cast<uint8_t>(units);
+    config.messages_per_packet = options.get("messages-per-packet", static_cast<uint64_t>(config.messages_per_packet));
+    config.max_live_orders = options.get("max-live-orders", static_cast<uint64_t>(config.max_live_orders));
+    config.message_gap_ns = options.get("message-gap-ns", config.message_gap_ns);
+    config.seed = options.get("seed", config.seed);
+    const std::string mix = options.get("mix", std::string());
+    if (!mix.empty()) config.mix = parse_mix(mix);
+    const uint64_t packets = options.get("packets", static_cast<uint64_t>(100000));
+    const uint64_t base_port = options.get("base-port", static_cast<uint64_t>(30501));
+    if (base_port + config.units - 1 > 0xFFFF) throw std::invalid_argument("--base-port too high for the unit count");
+
+    equix_md::PcapWriter::Endpoint source, destination;
+    const std::string host = options.get("host", std::string("127.0.0.1"));
+    if (inet_pton(AF_INET, host.c_str(), &destination.ip) != 1) throw std::invalid_argument("Bad --host " + host);
+    inet_pton(AF_INET, "127.0.0.1", &source.ip);
+    source.port = 40000;
+
+    const auto start = Clock::now();
+    equix_md::SyntheticFeed feed(config);
+    equix_md::PcapWriter writer(out);
+    for (uint64_t i = 0; i < packets; ++i) {
+        const equix_md::SyntheticFeed::Datagram datagram = feed.next();
+        destination.port = static_cast<uint16_t>(base_port + datagram.unit - 1);
+        writer.write_udp(datagram.data, datagram.size, datagram.timestamp_ns, source, destination);
+    }
+    writer.close();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    using Feed = equix_md::SyntheticFeed;
+    std::cout << "[Synth] wrote " << writer.packets() << " datagrams, " << feed.messages() << " messages, "
+              << writer.bytes() << " bytes to " << out << " in " << std::fixed << std::setprecision(3) << seconds
+              << " s\n"
+              << "[Synth] symbols=" << config.symbols << " zipf=" << config.zipf_exponent
+              << " units=" << static_cast<int>(config.units)
+              << " add=" << feed.operations(Feed::kAdd) << " execute=" << feed.operations(Feed::kExecute)
+              << " modify=" << feed.operations(Feed::kModify) << " reduce=" << feed.operations(Feed::kReduce)
+              << " delete=" << feed.operations(Feed::kDelete) << " trade=" << feed.operations(Feed::kTrade)
+              << " live_orders=" << feed.live_orders() << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    try {
+        return run(Options(argc, argv, 1));
+    } catch (const std::exception &ex) {
+        std::cerr << "[Synth] " << ex.what() << std::endl;
+        return 1;
+    }
+}